@@ -0,0 +1,474 @@
+//! \file GraphBenchmark.cpp
+//! \brief End-to-end benchmarks of synthetic task graphs
+//!
+//! \details
+//! SystemC elaborates one model per process, so every benchmark case runs
+//! in its own child process of this executable:
+//!
+//!     tgs_graph_benchmark [--benchmark_filter=<regex>] [--benchmark_out=<file>]
+//!                         [--iterations=<n>] [--units=<n>]
+//!     tgs_graph_benchmark --case=<generator> --size=<n> [--param=<n>] ...
+//!
+//! The first form runs all registered cases, the second one case. The
+//! console table and the JSON file follow the output of Google Benchmark
+//! ("real_time" is the simulation wall time of all iterations), so runs can
+//! be compared with its tools/compare.py.
+
+#include "SyntheticGraph.h"
+#include "Statistics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment( lib, "psapi.lib" )
+#define popen _popen
+#define pclose _pclose
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    using namespace vc_utils;
+
+    //! \brief one benchmark case: generator with its size and parameter
+    struct BenchmarkCase
+    {
+        std::string generator; //!< \brief layered, fir, conv, reduction or ifnest
+        unsigned int size;     //!< \brief main size parameter of the generator
+        unsigned int param;    //!< \brief second parameter of the generator
+    };
+
+    //! \brief measured values of one benchmark case
+    struct BenchmarkResult
+    {
+        std::string name;              //!< \brief generator/size/param
+        std::size_t vertices = {0};    //!< \brief task graph vertices
+        std::size_t edges = {0};       //!< \brief wired edges
+        unsigned int iterations = {0}; //!< \brief completed iterations
+        double elaboration = {0.0};    //!< \brief graph construction wall time [s]
+        double simulation = {0.0};     //!< \brief sc_start wall time [s]
+        double cpu = {0.0};            //!< \brief sc_start process time [s]
+        std::uint64_t executions = {0}; //!< \brief vertex executions at all process units
+        std::uint64_t deltas = {0};     //!< \brief SystemC delta cycles
+        double peakRss = {0.0};        //!< \brief peak resident set [KiB]
+        double rssPerVertex = {0.0};   //!< \brief peak resident set growth per vertex [B]
+    };
+
+    //! \brief settings of the command line
+    struct Options
+    {
+        BenchmarkCase single = {"", 0, 0}; //!< \brief case of --case (generator empty: all)
+        unsigned int iterations = {10};    //!< \brief iterations per case
+        unsigned int units = {4};          //!< \brief process units per graph
+        std::string filter = {"."};        //!< \brief regex on the case names
+        std::string out;                   //!< \brief JSON output file
+        bool child = {false};              //!< \brief print machine readable record only
+    };
+
+    //! \brief cases run without --case
+    const std::vector< BenchmarkCase > registeredCases = {
+        {"layered", 64, 16},
+        {"layered", 256, 16},
+        {"fir", 256, 16},
+        {"fir", 1024, 16},
+        {"conv", 32, 3},
+        {"conv", 32, 5},
+        {"reduction", 4096, 1},
+        {"reduction", 16384, 1},
+        {"ifnest", 256, 8},
+        {"ifnest", 64, 32},
+    };
+
+    //! \brief default of the second parameter of _generator
+    unsigned int defaultParam( const std::string& _generator )
+    {
+        if ( "conv" == _generator )
+            return 3;
+        if ( "reduction" == _generator )
+            return 1;
+        if ( "ifnest" == _generator )
+            return 8;
+
+        return 16;
+    }
+
+    std::string getName( const BenchmarkCase& _case )
+    {
+        return _case.generator + "/" + std::to_string( _case.size ) + "/" +
+               std::to_string( _case.param );
+    }
+
+    //! \brief peak resident set size of this process [KiB]
+    double getPeakRss( void )
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if ( GetProcessMemoryInfo( GetCurrentProcess( ), &counters, sizeof( counters ) ) )
+            return counters.PeakWorkingSetSize / 1024.0;
+        return 0.0;
+#else
+        struct rusage usage;
+        getrusage( RUSAGE_SELF, &usage );
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024.0; // bytes
+#else
+        return static_cast< double >( usage.ru_maxrss ); // KiB
+#endif
+#endif
+    }
+
+
+    /************************************************************************/
+    // IterationDriver
+    //!
+    //! \class IterationDriver
+    //!
+    //! \brief restarts the task graph until all iterations are done
+    /************************************************************************/
+    class IterationDriver : public sc_core::sc_module
+    {
+    public:
+        SC_HAS_PROCESS( IterationDriver );
+
+        //! \brief constructor
+        IterationDriver( name_t _name, Memory* _memory, unsigned int _iterations )
+            : sc_core::sc_module( _name ), m_memory( _memory ), m_iterations( _iterations )
+        {
+            SC_THREAD( driveProcess );
+        }
+
+        //! \brief number of iterations whose results are all written
+        unsigned int getCompleted( void ) const { return m_completed; }
+
+    private:
+        void driveProcess( void )
+        {
+            for ( ; m_completed < m_iterations; ++m_completed )
+                {
+                    m_memory->notifyAllInputValues( );
+                    sc_core::wait( m_memory->getOutputsWrittenEvent( ) );
+                }
+
+            sc_core::sc_stop( );
+        }
+
+    private:
+        Memory* const m_memory;           //!< \brief memory of the task graph
+        const unsigned int m_iterations;  //!< \brief iterations to run
+        unsigned int m_completed = {0};   //!< \brief completed iterations
+    };
+
+
+    //! \brief elaborate and simulate _case in this process
+    BenchmarkResult runCase( const BenchmarkCase& _case, const Options& _options )
+    {
+        typedef std::chrono::steady_clock clock_t;
+
+        BenchmarkResult result;
+        result.name = getName( _case );
+
+        auto rssBefore = getPeakRss( );
+        auto elaborationStart = clock_t::now( );
+
+        SyntheticGraph graph( _options.units, sc_time_t( 10, sc_core::SC_NS ) );
+
+        if ( "layered" == _case.generator )
+            generateLayeredDag( graph, _case.size, _case.param );
+        else if ( "fir" == _case.generator )
+            generateFir( graph, _case.size, _case.param );
+        else if ( "conv" == _case.generator )
+            generateConvolution( graph, _case.size, _case.param );
+        else if ( "reduction" == _case.generator )
+            generateReductionTree( graph, _case.size, _case.param );
+        else if ( "ifnest" == _case.generator )
+            generateIfNest( graph, _case.size, _case.param );
+        else
+            SC_REPORT_FATAL(
+                "GraphBenchmark", ( "unknown generator " + _case.generator ).c_str( ) );
+
+        graph.build( );
+        IterationDriver driver( "driver", graph.getMemory( ), _options.iterations );
+
+        auto simulationStart = clock_t::now( );
+        auto cpuStart = std::clock( );
+
+        sc_core::sc_start( );
+
+        auto cpuStop = std::clock( );
+        auto simulationStop = clock_t::now( );
+
+        result.vertices = graph.getNumberOfVertices( );
+        result.edges = graph.getNumberOfEdges( );
+        result.iterations = driver.getCompleted( );
+        result.elaboration =
+            std::chrono::duration< double >( simulationStart - elaborationStart ).count( );
+        result.simulation =
+            std::chrono::duration< double >( simulationStop - simulationStart ).count( );
+        result.cpu = static_cast< double >( cpuStop - cpuStart ) / CLOCKS_PER_SEC;
+        result.deltas = sc_core::sc_delta_count( );
+
+        for ( auto& unit : graph.getUnits( ) )
+            result.executions += unit->getStatistics( ).getNumberOfExecutions( );
+
+        result.peakRss = getPeakRss( );
+        result.rssPerVertex = ( 0 != result.vertices )
+                                  ? ( result.peakRss - rssBefore ) * 1024.0 / result.vertices
+                                  : 0.0;
+
+        if ( result.iterations != _options.iterations )
+            SC_REPORT_ERROR( "GraphBenchmark", "simulation ended before all iterations" );
+
+        return result;
+    }
+
+    //! \brief single line record exchanged between child and parent process
+    void writeRecord( ::std::ostream& _os, const BenchmarkResult& _result )
+    {
+        _os << std::setprecision( 17 ) << "RESULT " << _result.name << " " << _result.vertices
+            << " " << _result.edges << " " << _result.iterations << " " << _result.elaboration
+            << " " << _result.simulation << " " << _result.cpu << " " << _result.executions << " "
+            << _result.deltas << " " << _result.peakRss << " " << _result.rssPerVertex
+            << std::endl;
+    }
+
+    bool readRecord( const std::string& _line, BenchmarkResult& _result )
+    {
+        std::istringstream is( _line );
+        std::string tag;
+
+        is >> tag >> _result.name >> _result.vertices >> _result.edges >> _result.iterations >>
+            _result.elaboration >> _result.simulation >> _result.cpu >> _result.executions >>
+            _result.deltas >> _result.peakRss >> _result.rssPerVertex;
+
+        return !is.fail( ) && ( "RESULT" == tag );
+    }
+
+    //! \brief run _case in a child process of _executable
+    bool runChild( const std::string& _executable, const BenchmarkCase& _case,
+        const Options& _options, BenchmarkResult& _result )
+    {
+        std::string command = "\"" + _executable + "\" --child --case=" + _case.generator +
+                              " --size=" + std::to_string( _case.size ) +
+                              " --param=" + std::to_string( _case.param ) +
+                              " --iterations=" + std::to_string( _options.iterations ) +
+                              " --units=" + std::to_string( _options.units );
+
+        auto pipe = popen( command.c_str( ), "r" );
+        if ( nullptr == pipe )
+            return false;
+
+        // skip the SystemC banner and reports
+        bool found = false;
+        char buffer[ 512 ];
+        while ( nullptr != std::fgets( buffer, sizeof( buffer ), pipe ) )
+            {
+                if ( 0 == std::string( buffer ).compare( 0, 7, "RESULT " ) )
+                    found = readRecord( buffer, _result );
+            }
+
+        return ( 0 == pclose( pipe ) ) && found;
+    }
+
+    void writeConsoleHeader( ::std::ostream& _os )
+    {
+        std::string line( 118, '-' );
+        _os << line << "\n"
+            << std::left << std::setw( 22 ) << "Benchmark" << std::right << std::setw( 9 )
+            << "Vertices" << std::setw( 13 ) << "Elaboration" << std::setw( 13 ) << "Simulation"
+            << std::setw( 11 ) << "Iterations" << "   UserCounters...\n"
+            << line << "\n";
+    }
+
+    void writeConsole( ::std::ostream& _os, const BenchmarkResult& _result )
+    {
+        auto executionRate = ( 0.0 != _result.simulation ) ? _result.executions / _result.simulation
+                                                            : 0.0;
+        auto deltaRate = ( 0.0 != _result.simulation ) ? _result.deltas / _result.simulation : 0.0;
+
+        _os << std::left << std::setw( 22 ) << _result.name << std::right << std::setw( 9 )
+            << _result.vertices << std::fixed << std::setprecision( 1 ) << std::setw( 10 )
+            << _result.elaboration * 1e3 << " ms" << std::setw( 10 ) << _result.simulation * 1e3
+            << " ms" << std::setw( 11 ) << _result.iterations << std::setprecision( 3 )
+            << "   executions/s=" << executionRate / 1e6 << "M deltas/s=" << deltaRate / 1e3
+            << "k rss/vertex=" << std::setprecision( 0 ) << _result.rssPerVertex << "B\n"
+            << std::defaultfloat << std::setprecision( 6 );
+    }
+
+    //! \brief write _results as Google Benchmark JSON
+    void writeJson( ::std::ostream& _os, const std::string& _executable,
+        const std::vector< BenchmarkResult >& _results )
+    {
+        char date[ 32 ] = "";
+        auto now = std::time( nullptr );
+        std::strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", std::localtime( &now ) );
+
+        _os << std::setprecision( 12 ) << "{\n  \"context\": {\n    \"date\": \"" << date
+            << "\",\n    \"executable\": \"" << _executable
+            << "\",\n    \"num_cpus\": " << std::thread::hardware_concurrency( )
+            << ",\n    \"library_build_type\": \""
+#ifdef NDEBUG
+            << "release"
+#else
+            << "debug"
+#endif
+            << "\"\n  },\n  \"benchmarks\": [";
+
+        for ( std::size_t i = 0; i < _results.size( ); ++i )
+            {
+                const auto& r = _results[ i ];
+                auto seconds = ( 0.0 != r.simulation ) ? r.simulation : 1.0;
+
+                _os << ( ( 0 == i ) ? "\n" : ",\n" ) << "    {\n      \"name\": \"" << r.name
+                    << "\",\n      \"run_name\": \"" << r.name
+                    << "\",\n      \"run_type\": \"iteration\",\n      \"repetitions\": 1"
+                    << ",\n      \"iterations\": " << r.iterations
+                    << ",\n      \"real_time\": " << r.simulation * 1e3
+                    << ",\n      \"cpu_time\": " << r.cpu * 1e3
+                    << ",\n      \"time_unit\": \"ms\",\n      \"elaboration_time\": "
+                    << r.elaboration * 1e3 << ",\n      \"vertices\": " << r.vertices
+                    << ",\n      \"edges\": " << r.edges
+                    << ",\n      \"executions\": " << r.executions
+                    << ",\n      \"delta_cycles\": " << r.deltas
+                    << ",\n      \"items_per_second\": " << r.executions / seconds
+                    << ",\n      \"deltas_per_second\": " << r.deltas / seconds
+                    << ",\n      \"peak_rss_kib\": " << r.peakRss
+                    << ",\n      \"rss_per_vertex\": " << r.rssPerVertex << "\n    }";
+            }
+
+        _os << "\n  ]\n}\n";
+    }
+
+    //! \brief value of _arg if it starts with _key, else nullptr
+    const char* getValue( const char* _arg, const char* _key )
+    {
+        auto length = std::strlen( _key );
+        return ( 0 == std::strncmp( _arg, _key, length ) ) ? _arg + length : nullptr;
+    }
+
+    bool parseOptions( int _argc, char* _argv[], Options& _options )
+    {
+        bool paramSet = false;
+
+        for ( int i = 1; i < _argc; ++i )
+            {
+                const char* value;
+
+                if ( nullptr != ( value = getValue( _argv[ i ], "--case=" ) ) )
+                    _options.single.generator = value;
+                else if ( nullptr != ( value = getValue( _argv[ i ], "--size=" ) ) )
+                    _options.single.size = std::atoi( value );
+                else if ( nullptr != ( value = getValue( _argv[ i ], "--param=" ) ) )
+                    {
+                        _options.single.param = std::atoi( value );
+                        paramSet = true;
+                    }
+                else if ( nullptr != ( value = getValue( _argv[ i ], "--iterations=" ) ) )
+                    _options.iterations = std::atoi( value );
+                else if ( nullptr != ( value = getValue( _argv[ i ], "--units=" ) ) )
+                    _options.units = std::atoi( value );
+                else if ( nullptr != ( value = getValue( _argv[ i ], "--benchmark_filter=" ) ) )
+                    _options.filter = value;
+                else if ( nullptr != ( value = getValue( _argv[ i ], "--benchmark_out=" ) ) )
+                    _options.out = value;
+                else if ( 0 == std::strcmp( _argv[ i ], "--child" ) )
+                    _options.child = true;
+                else
+                    {
+                        std::cerr << "unknown option " << _argv[ i ] << "\n";
+                        return false;
+                    }
+            }
+
+        if ( !paramSet )
+            _options.single.param = defaultParam( _options.single.generator );
+
+        return ( 0 < _options.iterations ) && ( 0 < _options.units ) &&
+               ( _options.single.generator.empty( ) || ( 0 < _options.single.size ) );
+    }
+}
+
+
+int sc_main( int argc, char* argv[] )
+{
+    Options options;
+    if ( !parseOptions( argc, argv, options ) )
+        {
+            std::cerr << "usage: " << argv[ 0 ]
+                      << " [--case=layered|fir|conv|reduction|ifnest --size=<n> [--param=<n>]]"
+                         " [--iterations=<n>] [--units=<n>] [--benchmark_filter=<regex>]"
+                         " [--benchmark_out=<file>]\n";
+            return 1;
+        }
+
+    // one case in this process
+    if ( !options.single.generator.empty( ) )
+        {
+            auto result = runCase( options.single, options );
+
+            if ( options.child )
+                writeRecord( std::cout, result );
+            else
+                {
+                    writeConsoleHeader( std::cout );
+                    writeConsole( std::cout, result );
+                }
+
+            if ( !options.out.empty( ) )
+                {
+                    std::ofstream file( options.out );
+                    writeJson( file, argv[ 0 ], {result} );
+                }
+
+            return 0;
+        }
+
+    // every registered case in a child process
+    std::regex filter( options.filter );
+    std::vector< BenchmarkResult > results;
+    int status = 0;
+
+    writeConsoleHeader( std::cout );
+
+    for ( const auto& benchmarkCase : registeredCases )
+        {
+            if ( !std::regex_search( getName( benchmarkCase ), filter ) )
+                continue;
+
+            BenchmarkResult result;
+            if ( runChild( argv[ 0 ], benchmarkCase, options, result ) )
+                {
+                    writeConsole( std::cout, result );
+                    results.push_back( result );
+                }
+            else
+                {
+                    std::cout << getName( benchmarkCase ) << " failed\n";
+                    status = 1;
+                }
+            std::cout.flush( );
+        }
+
+    if ( !options.out.empty( ) )
+        {
+            std::ofstream file( options.out );
+            writeJson( file, argv[ 0 ], results );
+        }
+
+    return status;
+}
@@ -0,0 +1,341 @@
+//! \file MicroBenchmark.cpp
+//! \brief Google Benchmark microbenchmarks of the notification, observer and payload hot paths
+//!
+//! \details
+//! Event notifications and wait() need a running SystemC kernel, so the
+//! benchmarks are run by a SystemC thread process. Modules used by the
+//! benchmarks (Memory, process unit) are elaborated in sc_main for all
+//! registered arguments before the simulation starts. All Google Benchmark
+//! command line options are supported:
+//!
+//!     tgs_micro_benchmark --benchmark_filter=Notify --benchmark_out=micro.json
+
+#include "Typedefinitions.h"
+#include "Memory.h"
+#include "MeshFabric.h"
+#include "Observer.h"
+#include "ObserverInterconnect.h"
+#include "ObserverManager.h"
+#include "PayloadManager.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace vc_utils;
+
+    //! \brief stack of the benchmark process (Google Benchmark needs more than a vertex)
+    const std::size_t RUNNER_STACK_SIZE = 0x1000000;
+
+    //! \brief output values of the notifying memory
+    const std::vector< int64_t > portCounts = {1, 8, 64};
+    //! \brief Observers per output value
+    const std::vector< int64_t > fanOuts = {1, 8, 64};
+
+
+    /************************************************************************/
+    // FanOutFixture
+    //!
+    //! \brief memory with _ports values that are observed by _fanOut Observers each
+    /************************************************************************/
+    struct FanOutFixture
+    {
+        FanOutFixture( unsigned int _ports, unsigned int _fanOut )
+            : memory( new Memory(
+                  ( "fanout_" + std::to_string( _ports ) + "_" + std::to_string( _fanOut ) )
+                      .c_str( ) ) )
+        {
+            memory->setAutoStart( false );
+            memory->setDumpOutputs( false );
+
+            for ( unsigned int port = 0; port < _ports; ++port )
+                {
+                    memory->addMemoryValue( port, "value", port, TYPE::UNSIGNED_INT );
+
+                    for ( unsigned int i = 0; i < _fanOut; ++i )
+                        {
+                            events.emplace_back( new event_t( ) );
+                            auto id = observers.addObserver( events.back( ).get( ),
+                                reinterpret_cast< dataPtr_t >( &value ), sizeof( value ) );
+                            memory->registerObserver( observers.getObserver( id ), port );
+                        }
+                }
+
+            // the memory process waits for at least one observed value
+            memory->addMemoryValue( 0u, "result", _ports, TYPE::UNSIGNED_INT, true );
+        }
+
+        std::unique_ptr< Memory > memory;                //!< \brief notifying subject
+        ObserverManager< Observer > observers;           //!< \brief consumers
+        std::vector< std::unique_ptr< event_t > > events; //!< \brief one event per Observer
+        unsigned int value = {0};                        //!< \brief copy destination
+    };
+
+    //! \brief modules elaborated before the benchmarks run
+    struct Fixtures
+    {
+        Fixtures( ) : unit( new MeshProcessUnit( "unit", 0 ) )
+        {
+            for ( auto ports : portCounts )
+                for ( auto fanOut : fanOuts )
+                    memories[ std::make_pair( ports, fanOut ) ].reset(
+                        new FanOutFixture( ports, fanOut ) );
+        }
+
+        //! \brief memories by port count and fan-out
+        std::map< std::pair< int64_t, int64_t >, std::unique_ptr< FanOutFixture > > memories;
+        //! \brief contended process unit
+        std::unique_ptr< MeshProcessUnit > unit;
+    };
+
+    Fixtures* fixtures = nullptr;
+
+
+    /************************************************************************/
+    /* Subject::notifyObservers                                             */
+    /************************************************************************/
+    //! \brief notify one output value of a memory with range(0) values and range(1) Observers
+    //! per value
+    void BM_SubjectNotifyObservers( benchmark::State& _state )
+    {
+        auto& fixture =
+            *fixtures->memories.at( std::make_pair( _state.range( 0 ), _state.range( 1 ) ) );
+
+        for ( auto _ : _state )
+            {
+                fixture.memory->notifyObservers( 0 );
+                benchmark::ClobberMemory( );
+            }
+
+        _state.SetItemsProcessed( _state.iterations( ) * _state.range( 1 ) );
+        _state.counters[ "observers" ] =
+            static_cast< double >( _state.range( 0 ) * _state.range( 1 ) );
+    }
+    BENCHMARK( BM_SubjectNotifyObservers )
+        ->ArgNames( {"ports", "fanout"} )
+        ->ArgsProduct( {portCounts, fanOuts} );
+
+
+    /************************************************************************/
+    /* ObserverManager                                                      */
+    /************************************************************************/
+    //! \brief create a manager with range(0) Observers and destroy it
+    void BM_ObserverManagerAddObserver( benchmark::State& _state )
+    {
+        event_t event;
+        unsigned int value = 0;
+
+        for ( auto _ : _state )
+            {
+                ObserverManager< Observer > observers;
+                for ( int64_t i = 0; i < _state.range( 0 ); ++i )
+                    observers.addObserver(
+                        &event, reinterpret_cast< dataPtr_t >( &value ), sizeof( value ) );
+                benchmark::DoNotOptimize( observers.getNextFreeObserverId( ) );
+            }
+
+        _state.SetItemsProcessed( _state.iterations( ) * _state.range( 0 ) );
+    }
+    BENCHMARK( BM_ObserverManagerAddObserver )->RangeMultiplier( 8 )->Range( 8, 4096 );
+
+    //! \brief look up all Observers of a manager with range(0) Observers
+    void BM_ObserverManagerGetObserver( benchmark::State& _state )
+    {
+        event_t event;
+        unsigned int value = 0;
+        ObserverManager< Observer > observers;
+        for ( int64_t i = 0; i < _state.range( 0 ); ++i )
+            observers.addObserver(
+                &event, reinterpret_cast< dataPtr_t >( &value ), sizeof( value ) );
+
+        for ( auto _ : _state )
+            {
+                for ( int64_t i = 0; i < _state.range( 0 ); ++i )
+                    benchmark::DoNotOptimize(
+                        observers.getObserver( static_cast< unsigned int >( i ) ) );
+            }
+
+        _state.SetItemsProcessed( _state.iterations( ) * _state.range( 0 ) );
+    }
+    BENCHMARK( BM_ObserverManagerGetObserver )->RangeMultiplier( 8 )->Range( 8, 4096 );
+
+
+    /************************************************************************/
+    /* Observer::notify                                                     */
+    /************************************************************************/
+    //! \brief copy one value of type T (sizes of the memory data types) to its consumer
+    template < typename T > void BM_ObserverNotify( benchmark::State& _state )
+    {
+        event_t event;
+        T source = T( 1 );
+        T destination = T( 0 );
+        Observer observer( &event, reinterpret_cast< dataPtr_t >( &destination ), sizeof( T ) );
+
+        for ( auto _ : _state )
+            {
+                observer.notify( sc_core::SC_ZERO_TIME, reinterpret_cast< dataPtr_t >( &source ),
+                    sizeof( T ) );
+                benchmark::DoNotOptimize( destination );
+            }
+
+        _state.SetBytesProcessed( _state.iterations( ) * sizeof( T ) );
+    }
+    BENCHMARK_TEMPLATE( BM_ObserverNotify, char );
+    BENCHMARK_TEMPLATE( BM_ObserverNotify, short );
+    BENCHMARK_TEMPLATE( BM_ObserverNotify, int );
+    BENCHMARK_TEMPLATE( BM_ObserverNotify, long long );
+    BENCHMARK_TEMPLATE( BM_ObserverNotify, float );
+    BENCHMARK_TEMPLATE( BM_ObserverNotify, double );
+    BENCHMARK_TEMPLATE( BM_ObserverNotify, long double );
+
+    //! \brief store the data reference of one value for the interconnect
+    void BM_ObserverInterconnectNotify( benchmark::State& _state )
+    {
+        event_t event;
+        int source = 1;
+        std::pair< dataPtr_t, unsigned int > destination;
+        ObserverInterconnect observer(
+            &event, reinterpret_cast< dataPtr_t >( &destination ), sizeof( destination ) );
+
+        for ( auto _ : _state )
+            {
+                observer.notify( sc_core::SC_ZERO_TIME, reinterpret_cast< dataPtr_t >( &source ),
+                    sizeof( source ) );
+                benchmark::DoNotOptimize( destination );
+            }
+    }
+    BENCHMARK( BM_ObserverInterconnectNotify );
+
+
+    /************************************************************************/
+    /* PayloadManager                                                       */
+    /************************************************************************/
+    //! \brief allocate range(0) payloads and free them
+    void BM_PayloadAllocateFree( benchmark::State& _state )
+    {
+        PayloadManager manager( "payloads" );
+        std::vector< tlm::tlm_generic_payload* > payloads( _state.range( 0 ) );
+
+        for ( auto _ : _state )
+            {
+                for ( auto& payload : payloads )
+                    payload = manager.allocate( );
+                for ( auto payload : payloads )
+                    manager.free( payload );
+            }
+
+        _state.SetItemsProcessed( _state.iterations( ) * _state.range( 0 ) );
+    }
+    BENCHMARK( BM_PayloadAllocateFree )->RangeMultiplier( 8 )->Range( 1, 512 );
+
+    //! \brief allocate payloads and return them by the reference counter like the routers
+    void BM_PayloadAcquireRelease( benchmark::State& _state )
+    {
+        PayloadManager manager( "payloads" );
+        std::vector< tlm::tlm_generic_payload* > payloads( _state.range( 0 ) );
+
+        for ( auto _ : _state )
+            {
+                for ( auto& payload : payloads )
+                    {
+                        payload = manager.allocate( );
+                        payload->acquire( );
+                    }
+                for ( auto payload : payloads )
+                    payload->release( );
+            }
+
+        _state.SetItemsProcessed( _state.iterations( ) * _state.range( 0 ) );
+    }
+    BENCHMARK( BM_PayloadAcquireRelease )->RangeMultiplier( 8 )->Range( 1, 512 );
+
+
+    /************************************************************************/
+    /* ProcessUnit_Base scheduling                                          */
+    /************************************************************************/
+    //! \brief range(0) vertices request the core at once and release it one after another
+    //!
+    //! \details
+    //! The last release of an iteration finds an empty queue and waits for the
+    //! latency (one delta cycle), like every uncontended execution.
+    void BM_ProcessUnitContention( benchmark::State& _state )
+    {
+        auto unit = fixtures->unit.get( );
+        std::vector< std::unique_ptr< event_t > > events;
+        for ( int64_t i = 0; i < _state.range( 0 ); ++i )
+            events.emplace_back( new event_t( ) );
+
+        for ( auto _ : _state )
+            {
+                for ( auto& event : events )
+                    unit->isCoreUsed( event.get( ) );
+                for ( std::size_t i = 0; i < events.size( ); ++i )
+                    unit->freeUsedCore( sc_core::SC_ZERO_TIME );
+            }
+
+        _state.SetItemsProcessed( _state.iterations( ) * _state.range( 0 ) );
+        _state.counters[ "max_queue_depth" ] =
+            static_cast< double >( unit->getStatistics( ).getMaxQueueDepth( ) );
+        unit->resetStatistics( );
+    }
+    BENCHMARK( BM_ProcessUnitContention )->RangeMultiplier( 4 )->Range( 1, 64 );
+
+
+    /************************************************************************/
+    // MicroBenchmarkRunner
+    //!
+    //! \brief runs the registered benchmarks in a SystemC thread process
+    /************************************************************************/
+    class MicroBenchmarkRunner : public sc_core::sc_module
+    {
+    public:
+        SC_HAS_PROCESS( MicroBenchmarkRunner );
+
+        //! \brief constructor
+        MicroBenchmarkRunner( name_t _name, int _argc, char* _argv[] )
+            : sc_core::sc_module( _name ), m_argc( _argc ), m_argv( _argv )
+        {
+            SC_THREAD( runProcess );
+            set_stack_size( RUNNER_STACK_SIZE );
+        }
+
+        //! \brief exit status of the benchmark run
+        int getStatus( void ) const { return m_status; }
+
+    private:
+        void runProcess( void )
+        {
+            benchmark::Initialize( &m_argc, m_argv );
+
+            if ( benchmark::ReportUnrecognizedArguments( m_argc, m_argv ) )
+                m_status = 1;
+            else
+                benchmark::RunSpecifiedBenchmarks( );
+
+            sc_core::sc_stop( );
+        }
+
+    private:
+        int m_argc;         //!< \brief number of command line arguments
+        char** m_argv;      //!< \brief command line arguments
+        int m_status = {0}; //!< \brief exit status
+    };
+}
+
+
+int sc_main( int argc, char* argv[] )
+{
+    Fixtures elaborated;
+    fixtures = &elaborated;
+
+    MicroBenchmarkRunner runner( "runner", argc, argv );
+    sc_core::sc_start( );
+
+    fixtures = nullptr;
+    return runner.getStatus( );
+}
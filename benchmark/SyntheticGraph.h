@@ -0,0 +1,520 @@
+//! \file SyntheticGraph.h
+//! \brief Parameterized generators of synthetic task graphs for benchmarks
+
+#ifndef SYNTHETICGRAPH_H_
+#define SYNTHETICGRAPH_H_
+
+#include "Typedefinitions.h"
+#include "Memory.h"
+#include "MeshFabric.h"
+#include "GraphBuilder.h"
+#include "IfVertex.h"
+#include "AddVertex.h"
+#include "SubVertex.h"
+#include "MulVertex.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <random>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // SyntheticGraph
+    //!
+    //! \class SyntheticGraph
+    //!
+    //! \brief Task graph instance that is filled by the graph generators
+    //!
+    //! \details
+    //! The graph owns one Memory for all input and result values and a
+    //! number of process units. Vertices are distributed round robin over the
+    //! units and collected in a GraphBuilder, so the edges are wired in one
+    //! pass by build(). All values are of type value_t.
+    //!
+    //! The Memory does not start automatically, the benchmark driver restarts
+    //! it by Memory::notifyAllInputValues for every iteration.
+    /************************************************************************/
+    class SyntheticGraph
+    {
+    public:
+        //! \typedef value_t
+        //! \brief data type of all values (unsigned, so overflows are defined)
+        typedef unsigned int value_t;
+
+        //! \struct Port
+        //! \brief output value of a vertex list entry
+        struct Port
+        {
+            unsigned int index;   //!< \brief vertex index at the GraphBuilder
+            unsigned int valueId; //!< \brief output value id of the vertex
+        };
+
+    public:
+        //! \brief constructor
+        //! \param [in] _numOfUnits number of process units
+        //! \param [in] _latency process latency of every vertex
+        SyntheticGraph( unsigned int _numOfUnits, const sc_time_t& _latency )
+            : m_memory( new Memory( "memory" ) ), m_latency( _latency )
+        {
+            sc_assert( 0 < _numOfUnits );
+
+            m_memory->setAutoStart( false );
+            m_memory->setDumpOutputs( false );
+
+            for ( unsigned int id = 0; id < _numOfUnits; ++id )
+                m_units.emplace_back(
+                    new MeshProcessUnit( ( "unit" + std::to_string( id ) ).c_str( ), id ) );
+            m_nextIds.assign( _numOfUnits, 0 );
+
+            m_memoryIndex = m_builder.addSubject< Memory >( m_memory.get( ) );
+        }
+
+        //! \brief destructor (vertices are owned by their process units)
+        ~SyntheticGraph( ) = default;
+
+    private:
+        // forbidden constructors
+        SyntheticGraph( const SyntheticGraph& _source ) = delete;         //!< \brief forbidden
+        SyntheticGraph& operator=( const SyntheticGraph& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // input
+        //!
+        //! \brief    add input value to the memory
+        //!
+        //! \param [in] _value initial value
+        //! \param [in] _dataType memory data type of _value
+        //! \return   Port: memory value that can be connected to vertices
+        /***************************************************************/
+        template < typename T = value_t >
+        Port input( const T& _value, TYPE _dataType = TYPE::UNSIGNED_INT )
+        {
+            auto id = m_nextValueId++;
+            m_memory->addMemoryValue( _value, "in" + std::to_string( id ), id, _dataType );
+
+            return Port{m_memoryIndex, id};
+        }
+
+        //! \brief add observed result value to the memory that is written by _source
+        void output( const Port& _source )
+        {
+            auto id = m_nextValueId++;
+            m_memory->addMemoryValue(
+                value_t( 0 ), "out" + std::to_string( id ), id, TYPE::UNSIGNED_INT, true );
+
+            connect( _source, m_memoryIndex, ( *m_memory )[ id ] );
+        }
+
+        //! \brief add observed result value to the memory that is written by a vertex
+        //! that is not added by binary (value _valueId of _source)
+        void output( Subject* _source, unsigned int _valueId )
+        {
+            auto id = m_nextValueId++;
+            m_memory->addMemoryValue(
+                value_t( 0 ), "out" + std::to_string( id ), id, TYPE::UNSIGNED_INT, true );
+
+            _source->registerObserver(
+                m_memory->inputObs.getObserver( ( *m_memory )[ id ] ), _valueId );
+        }
+
+        /***************************************************************/
+        // binary
+        //!
+        //! \brief    add binary operation on the next process unit
+        //!
+        //! \param [in] _lhs left hand side operand
+        //! \param [in] _rhs right hand side operand
+        //! \return   Port: result of the vertex
+        //!
+        //! \tparam vertexT type of vertex with the inputs SIDE::LHS and SIDE::RHS
+        /***************************************************************/
+        template < class vertexT > Port binary( const Port& _lhs, const Port& _rhs )
+        {
+            unsigned int id;
+            auto unit = nextUnit( id );
+            auto index = m_builder.addVertex< vertexT >( unit, id,
+                "v" + std::to_string( m_builder.getNumberOfVertices( ) ), 0, m_latency );
+
+            connect( _lhs, index, SIDE::LHS );
+            connect( _rhs, index, SIDE::RHS );
+            ++m_numOfVertices;
+
+            return Port{index, 0};
+        }
+
+        //! \brief balanced tree of AddVertex over all _terms
+        Port sum( std::vector< Port > _terms )
+        {
+            sc_assert( !_terms.empty( ) );
+
+            while ( 1 < _terms.size( ) )
+                {
+                    std::vector< Port > next;
+                    next.reserve( ( _terms.size( ) + 1 ) / 2 );
+
+                    for ( std::size_t i = 0; i + 1 < _terms.size( ); i += 2 )
+                        next.push_back(
+                            binary< AddVertex< value_t > >( _terms[ i ], _terms[ i + 1 ] ) );
+                    if ( 1 == _terms.size( ) % 2 )
+                        next.push_back( _terms.back( ) );
+
+                    _terms.swap( next );
+                }
+
+            return _terms.front( );
+        }
+
+        //! \brief create and wire all vertices added by binary and sum
+        void build( void )
+        {
+            m_builder.build(
+                GraphBuilder::EdgeList::fromEdges( m_builder.getNumberOfVertices( ), m_edges ) );
+
+            m_numOfEdges += m_edges.size( );
+            std::vector< GraphBuilder::Edge >( ).swap( m_edges );
+        }
+
+    public:
+        /************************************************************************/
+        /* access for generators that wire vertices by hand                     */
+        /************************************************************************/
+        //! \brief return the next process unit (round robin) and a free vertex id _id at it
+        ProcessUnit_Base* nextUnit( unsigned int& _id )
+        {
+            auto unit = m_nextUnit;
+            m_nextUnit = ( m_nextUnit + 1 ) % m_units.size( );
+
+            _id = m_nextIds[ unit ]++;
+            return m_units[ unit ].get( );
+        }
+
+        //! \brief count vertices and edges that are not added by binary
+        void count( std::size_t _numOfVertices, std::size_t _numOfEdges )
+        {
+            m_numOfVertices += _numOfVertices;
+            m_numOfEdges += _numOfEdges;
+        }
+
+        //! \brief memory of all input and result values
+        Memory* getMemory( void ) const { return m_memory.get( ); }
+
+        //! \brief process units of the graph
+        const std::vector< std::unique_ptr< MeshProcessUnit > >& getUnits( void ) const
+        {
+            return m_units;
+        }
+
+        //! \brief process latency of every vertex
+        const sc_time_t& getLatency( void ) const { return m_latency; }
+
+        //! \brief number of task graph vertices (without memory)
+        std::size_t getNumberOfVertices( void ) const { return m_numOfVertices; }
+
+        //! \brief number of wired edges
+        std::size_t getNumberOfEdges( void ) const { return m_numOfEdges + m_edges.size( ); }
+
+    private:
+        //! \brief add edge from _source to Observer _port of vertex index _dst
+        void connect( const Port& _source, unsigned int _dst, unsigned int _port )
+        {
+            m_edges.push_back( GraphBuilder::Edge{_source.index, _source.valueId, _dst, _port} );
+        }
+
+    private:
+        /************************************************************************/
+        /* member                                                               */
+        /************************************************************************/
+        std::unique_ptr< Memory > m_memory;                    //!< \brief values of the graph
+        std::vector< std::unique_ptr< MeshProcessUnit > > m_units; //!< \brief owner of vertices
+        std::vector< unsigned int > m_nextIds; //!< \brief next free vertex id per unit
+        unsigned int m_nextUnit = {0};         //!< \brief unit of the next vertex
+        unsigned int m_nextValueId = {0};      //!< \brief next free memory value id
+        unsigned int m_memoryIndex = {0};      //!< \brief vertex index of the memory
+        sc_time_t m_latency;                   //!< \brief process latency of every vertex
+        GraphBuilder m_builder;                //!< \brief collected vertex list
+        std::vector< GraphBuilder::Edge > m_edges; //!< \brief collected edges
+        std::size_t m_numOfVertices = {0};     //!< \brief number of task graph vertices
+        std::size_t m_numOfEdges = {0};        //!< \brief number of wired edges
+    };
+
+
+    /************************************************************************/
+    /* generators                                                           */
+    /************************************************************************/
+
+    /***************************************************************/
+    // generateLayeredDag
+    //!
+    //! \brief    random layered DAG
+    //!
+    //! \param [in] _graph graph to fill
+    //! \param [in] _width vertices per layer (and number of inputs)
+    //! \param [in] _layers number of layers
+    //! \param [in] _seed seed of the random generator
+    //!
+    //! \details
+    //! Every vertex is an addition, subtraction or multiplication of two
+    //! different random values of the previous layer. The last layer is
+    //! written to the memory.
+    /***************************************************************/
+    inline void generateLayeredDag( SyntheticGraph& _graph, unsigned int _width,
+        unsigned int _layers, unsigned int _seed = 1 )
+    {
+        typedef SyntheticGraph::value_t value_t;
+        sc_assert( ( 1 < _width ) && ( 0 < _layers ) );
+
+        std::mt19937 random( _seed );
+        std::uniform_int_distribution< unsigned int > pick( 0, _width - 1 );
+        std::uniform_int_distribution< unsigned int > operation( 0, 2 );
+
+        std::vector< SyntheticGraph::Port > layer;
+        for ( unsigned int i = 0; i < _width; ++i )
+            layer.push_back( _graph.input( value_t( random( ) ) ) );
+
+        for ( unsigned int l = 0; l < _layers; ++l )
+            {
+                std::vector< SyntheticGraph::Port > next;
+                next.reserve( _width );
+
+                for ( unsigned int i = 0; i < _width; ++i )
+                    {
+                        auto lhs = pick( random );
+                        auto rhs = pick( random );
+                        while ( rhs == lhs )
+                            rhs = pick( random );
+
+                        switch ( operation( random ) )
+                            {
+                            case 0:
+                                next.push_back( _graph.binary< AddVertex< value_t > >(
+                                    layer[ lhs ], layer[ rhs ] ) );
+                                break;
+                            case 1:
+                                next.push_back( _graph.binary< SubVertex< value_t > >(
+                                    layer[ lhs ], layer[ rhs ] ) );
+                                break;
+                            default:
+                                next.push_back( _graph.binary< MulVertex< value_t > >(
+                                    layer[ lhs ], layer[ rhs ] ) );
+                                break;
+                            }
+                    }
+
+                layer.swap( next );
+            }
+
+        for ( auto& port : layer )
+            _graph.output( port );
+    }
+
+    /***************************************************************/
+    // generateFir
+    //!
+    //! \brief    FIR filter in direct form
+    //!
+    //! \param [in] _graph graph to fill
+    //! \param [in] _samples number of output samples
+    //! \param [in] _taps number of coefficients
+    //!
+    //! \details
+    //! Every output sample multiplies _taps input samples with the shared
+    //! coefficients and accumulates the products by a chain of additions.
+    /***************************************************************/
+    inline void generateFir( SyntheticGraph& _graph, unsigned int _samples, unsigned int _taps )
+    {
+        typedef SyntheticGraph::value_t value_t;
+        sc_assert( ( 0 < _samples ) && ( 0 < _taps ) );
+
+        std::vector< SyntheticGraph::Port > coefficients;
+        for ( unsigned int k = 0; k < _taps; ++k )
+            coefficients.push_back( _graph.input( value_t( k + 1 ) ) );
+
+        std::vector< SyntheticGraph::Port > samples;
+        for ( unsigned int n = 0; n < _samples + _taps - 1; ++n )
+            samples.push_back( _graph.input( value_t( n ) ) );
+
+        for ( unsigned int n = 0; n < _samples; ++n )
+            {
+                auto acc = _graph.binary< MulVertex< value_t > >(
+                    coefficients[ 0 ], samples[ n + _taps - 1 ] );
+
+                for ( unsigned int k = 1; k < _taps; ++k )
+                    {
+                        auto product = _graph.binary< MulVertex< value_t > >(
+                            coefficients[ k ], samples[ n + _taps - 1 - k ] );
+                        acc = _graph.binary< AddVertex< value_t > >( acc, product );
+                    }
+
+                _graph.output( acc );
+            }
+    }
+
+    /***************************************************************/
+    // generateConvolution
+    //!
+    //! \brief    2D convolution of a square image (valid region)
+    //!
+    //! \param [in] _graph graph to fill
+    //! \param [in] _width width and height of the input image
+    //! \param [in] _kernel width and height of the kernel (e.g. 3 or 5)
+    //!
+    //! \details
+    //! Every output pixel multiplies its window with the shared kernel
+    //! weights and sums the products by a balanced adder tree.
+    /***************************************************************/
+    inline void generateConvolution(
+        SyntheticGraph& _graph, unsigned int _width, unsigned int _kernel )
+    {
+        typedef SyntheticGraph::value_t value_t;
+        sc_assert( ( 0 < _kernel ) && ( _kernel <= _width ) );
+
+        std::vector< SyntheticGraph::Port > weights;
+        for ( unsigned int i = 0; i < _kernel * _kernel; ++i )
+            weights.push_back( _graph.input( value_t( i + 1 ) ) );
+
+        std::vector< SyntheticGraph::Port > pixels;
+        for ( unsigned int i = 0; i < _width * _width; ++i )
+            pixels.push_back( _graph.input( value_t( i ) ) );
+
+        auto outWidth = _width - _kernel + 1;
+
+        for ( unsigned int y = 0; y < outWidth; ++y )
+            {
+                for ( unsigned int x = 0; x < outWidth; ++x )
+                    {
+                        std::vector< SyntheticGraph::Port > products;
+                        products.reserve( _kernel * _kernel );
+
+                        for ( unsigned int ky = 0; ky < _kernel; ++ky )
+                            for ( unsigned int kx = 0; kx < _kernel; ++kx )
+                                products.push_back( _graph.binary< MulVertex< value_t > >(
+                                    weights[ ky * _kernel + kx ],
+                                    pixels[ ( y + ky ) * _width + x + kx ] ) );
+
+                        _graph.output( _graph.sum( products ) );
+                    }
+            }
+    }
+
+    /***************************************************************/
+    // generateReductionTree
+    //!
+    //! \brief    independent balanced reduction trees
+    //!
+    //! \param [in] _graph graph to fill
+    //! \param [in] _leaves number of input values per tree
+    //! \param [in] _trees number of trees
+    /***************************************************************/
+    inline void generateReductionTree(
+        SyntheticGraph& _graph, unsigned int _leaves, unsigned int _trees = 1 )
+    {
+        typedef SyntheticGraph::value_t value_t;
+        sc_assert( ( 1 < _leaves ) && ( 0 < _trees ) );
+
+        for ( unsigned int t = 0; t < _trees; ++t )
+            {
+                std::vector< SyntheticGraph::Port > leaves;
+                leaves.reserve( _leaves );
+                for ( unsigned int i = 0; i < _leaves; ++i )
+                    leaves.push_back( _graph.input( value_t( i ) ) );
+
+                _graph.output( _graph.sum( leaves ) );
+            }
+    }
+
+    /***************************************************************/
+    // generateIfNest
+    //!
+    //! \brief    independent nests of IfVertex
+    //!
+    //! \param [in] _graph empty graph to fill
+    //! \param [in] _nests number of nests
+    //! \param [in] _depth number of IfVertex per nest
+    //! \param [in] _condition condition of all IfVertex
+    //!
+    //! \details
+    //! Every IfVertex has two incoming values. Its else path subtracts them,
+    //! its then path holds the next IfVertex of the nest, and the then path of
+    //! the innermost IfVertex adds them. With a true condition the whole nest
+    //! is passed in every iteration.
+    //!
+    //! IfVertex observes its condition at value id 0, so this generator has
+    //! to be the first one that adds values to _graph.
+    /***************************************************************/
+    inline void generateIfNest( SyntheticGraph& _graph, unsigned int _nests,
+        unsigned int _depth, bool _condition = true )
+    {
+        typedef SyntheticGraph::value_t value_t;
+        sc_assert( ( 0 < _nests ) && ( 0 < _depth ) );
+
+        auto condition = _graph.input( _condition, TYPE::UNSIGNED_CHAR );
+        sc_assert( 0 == condition.valueId );
+
+        auto memory = _graph.getMemory( );
+        auto latency = _graph.getLatency( );
+
+        for ( unsigned int n = 0; n < _nests; ++n )
+            {
+                auto lhs = _graph.input( value_t( n ) );
+                auto rhs = _graph.input( value_t( n + 1 ) );
+                auto prefix = "nest" + std::to_string( n );
+
+                unsigned int id;
+                auto unit = _graph.nextUnit( id );
+                unit->addIfVertex( id, ( prefix + "_if0" ).c_str( ), 0, latency, 2, memory );
+
+                auto outer = static_cast< IfVertex* >( unit->getVertex( id ) );
+                unit->connect< IfVertex >( memory, outer, SIDE::LHS, lhs.valueId );
+                unit->connect< IfVertex >( memory, outer, SIDE::RHS, rhs.valueId );
+
+                auto current = outer;
+                for ( unsigned int level = 1; level <= _depth; ++level )
+                    {
+                        auto name = prefix + "_" + std::to_string( level );
+
+                        current->addVertexToElse< SubVertex< value_t > >(
+                            0, name + "_sub", 0, latency );
+                        current->connectToElseDependency< SubVertex< value_t > >(
+                            0, SIDE::LHS, SIDE::LHS );
+                        current->connectToElseDependency< SubVertex< value_t > >(
+                            0, SIDE::RHS, SIDE::RHS );
+                        current->registerElseOutDependency( 0, 0, 0 );
+
+                        if ( level < _depth )
+                            {
+                                current->addIfVertexToThen(
+                                    0, ( prefix + "_if" + std::to_string( level ) ).c_str( ), 0,
+                                    latency, 2, memory );
+                                current->connectToThenDependency< IfVertex >(
+                                    0, SIDE::LHS, SIDE::LHS );
+                                current->connectToThenDependency< IfVertex >(
+                                    0, SIDE::RHS, SIDE::RHS );
+                                current->registerThenOutDependency( 0, 0, 0 );
+
+                                current = static_cast< IfVertex* >( current->getThenPathNode( 0 ) );
+                            }
+                        else
+                            {
+                                current->addVertexToThen< AddVertex< value_t > >(
+                                    0, name + "_add", 0, latency );
+                                current->connectToThenDependency< AddVertex< value_t > >(
+                                    0, SIDE::LHS, SIDE::LHS );
+                                current->connectToThenDependency< AddVertex< value_t > >(
+                                    0, SIDE::RHS, SIDE::RHS );
+                                current->registerThenOutDependency( 0, 0, 0 );
+                            }
+                    }
+
+                _graph.output( outer, 0 );
+
+                // IfVertex, SubVertex per level and the innermost AddVertex;
+                // condition, two inputs and one result per level, inputs and result of the nest
+                _graph.count( 2 * _depth + 1, 7 * _depth + 3 );
+            }
+    }
+}
+
+#endif // !SYNTHETICGRAPH_H_
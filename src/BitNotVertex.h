@@ -129,12 +129,16 @@ namespace vc_utils
                 {
                     // parent value synchronization
                     sc_core::wait( m_exeProcEvAndList );
+                    VC_TRACE_EVENT( m_ProcessUnit, this->getVertexNumber( ), TRACE_READY );
 
                     m_ProcessUnit->isCoreUsed( &m_coreFreeEv );
                     sc_core::wait( m_coreFreeEv );
+                    VC_TRACE_EVENT( m_ProcessUnit, this->getVertexNumber( ), TRACE_START );
 
                     m_returnOneVal.second = static_cast< T >( ~m_inputOneVal.second );
 
+                    VC_TRACE_EVENT_AT( m_ProcessUnit, this->getVertexNumber( ), TRACE_FINISH,
+                        this->getVertexLatency( ) );
                     m_ProcessUnit->freeUsedCore( this->getVertexLatency( ) );
 
                     // notify children observers for output value
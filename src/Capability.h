@@ -0,0 +1,95 @@
+//! \file Capability.h
+//! \brief Capability classes of process units and task graph vertices
+
+#ifndef CAPABILITY_H_
+#define CAPABILITY_H_
+
+#include "Typedefinitions.h"
+
+namespace vc_utils
+{
+    /************************************************************************/
+    // declarations
+    /************************************************************************/
+    class IfVertex;
+
+    /************************************************************************/
+    /* type definitions                                                     */
+    /************************************************************************/
+    typedef unsigned int capability_t; //!< \brief set of capability classes (bit mask)
+
+    /************************************************************************/
+    /* enumerations                                                         */
+    /************************************************************************/
+    //! \enum CAPABILITY
+    //! \brief Capability classes of a process unit
+    enum CAPABILITY : capability_t {
+        ALU = 0x01,             //!< \brief add, sub, inc, dec, logic, compare and shift
+        MUL = 0x02,             //!< \brief multiplier
+        DIV = 0x04,             //!< \brief divider (div and mod)
+        CONTROL = 0x08,         //!< \brief branches (if and ternary)
+        SFU = 0x10,             //!< \brief special function unit
+        ALL_CAPABILITIES = 0x1f //!< \brief every capability class
+    };
+
+    //! \brief number of capability classes
+    const unsigned int NUM_OF_CAPABILITIES = 5;
+
+    //! \brief true if the set _offered contains all classes of _required
+    inline bool supportsCapabilities( capability_t _offered, capability_t _required )
+    {
+        return ( _offered & _required ) == _required;
+    }
+
+    //! \brief index (0 .. NUM_OF_CAPABILITIES - 1) of the single class _class
+    inline unsigned int getCapabilityIndex( capability_t _class )
+    {
+        sc_assert( ( 0 != _class ) && ( 0 == ( _class & ( _class - 1 ) ) ) &&
+                   ( 0 != ( _class & ALL_CAPABILITIES ) ) );
+
+        unsigned int index = 0;
+        while ( 1u != _class )
+            {
+                _class >>= 1;
+                ++index;
+            }
+
+        return index;
+    }
+
+    //! \brief name of the capability class with index _index
+    inline const char* getCapabilityName( unsigned int _index )
+    {
+        static const char* names[ NUM_OF_CAPABILITIES ] = {"ALU", "MUL", "DIV", "CONTROL", "SFU"};
+
+        return ( _index < NUM_OF_CAPABILITIES ) ? names[ _index ] : "unknown";
+    }
+
+    /************************************************************************/
+    // VertexCapability
+    //!
+    //! \struct VertexCapability
+    //!
+    //! \brief Capability class a process unit needs to execute vertexT
+    //!
+    //! \details
+    //! Vertices use the ALU by default. Vertex headers specialize this
+    //! struct for other classes, e.g. MulVertex needs MUL. Own vertex
+    //! types of a special function unit specialize it with SFU.
+    //!
+    //! \tparam vertexT type of vertex
+    /************************************************************************/
+    template < class vertexT > struct VertexCapability
+    {
+        static const capability_t value = ALU; //!< \brief needed capability class
+    };
+
+    //! \brief IfVertex needs branch support
+    template <> struct VertexCapability< IfVertex >
+    {
+        static const capability_t value = CONTROL; //!< \brief needed capability class
+    };
+}
+
+
+#endif // !CAPABILITY_H_
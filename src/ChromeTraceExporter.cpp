@@ -0,0 +1,332 @@
+//! \file ChromeTraceExporter.cpp
+//! \brief Conversion of binary execution traces into Chrome Trace Event JSON
+
+#include "ChromeTraceExporter.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <deque>
+#include <tuple>
+
+namespace vc_utils
+{
+    namespace
+    {
+        //! \brief interconnects are written as processes behind all process unit ids
+        const unsigned int INTERCONNECT_PID_OFFSET = 0x10000;
+
+        //! \brief thread ids of a process unit
+        enum UNIT_TRACK : unsigned int { CORE_TRACK = 0, QUEUE_TRACK = 1, CONTROL_TRACK = 2 };
+
+        //! \brief write _text as quoted JSON string
+        void writeString( ::std::ostream& _os, const std::string& _text )
+        {
+            _os << '"';
+            for ( auto c : _text )
+                {
+                    switch ( c )
+                        {
+                        case '"': _os << "\\\""; break;
+                        case '\\': _os << "\\\\"; break;
+                        case '\n': _os << "\\n"; break;
+                        case '\t': _os << "\\t"; break;
+                        default:
+                            if ( 0x20 > static_cast< unsigned char >( c ) )
+                                _os << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' )
+                                    << static_cast< unsigned int >( c ) << std::dec
+                                    << std::setfill( ' ' );
+                            else
+                                _os << c;
+                        }
+                }
+            _os << '"';
+        }
+
+        //! \brief writes the comma separated event list
+        class EventListWriter
+        {
+        public:
+            explicit EventListWriter( ::std::ostream& _os ) : m_os( _os ) {}
+
+            //! \brief start a new event object with phase _ph
+            ::std::ostream& begin( const char* _ph, unsigned int _pid, unsigned int _tid )
+            {
+                m_os << ( m_first ? "\n" : ",\n" ) << "{\"ph\":\"" << _ph << "\",\"pid\":" << _pid
+                     << ",\"tid\":" << _tid;
+                m_first = false;
+                return m_os;
+            }
+
+            //! \brief metadata event _type ("process_name", "thread_name") with _name
+            void meta( const char* _type, unsigned int _pid, unsigned int _tid,
+                const std::string& _name )
+            {
+                begin( "M", _pid, _tid ) << ",\"name\":\"" << _type << "\",\"args\":{\"name\":";
+                writeString( m_os, _name );
+                m_os << "}}";
+            }
+
+            //! \brief complete event _name from _begin lasting _duration (microseconds)
+            void complete( unsigned int _pid, unsigned int _tid, const std::string& _name,
+                double _begin, double _duration, std::uint32_t _id )
+            {
+                begin( "X", _pid, _tid ) << ",\"name\":";
+                writeString( m_os, _name );
+                m_os << ",\"ts\":" << _begin << ",\"dur\":" << _duration
+                     << ",\"args\":{\"id\":" << _id << "}}";
+            }
+
+            //! \brief async begin ("b") or end ("e") event _name with id _asyncId
+            void async( const char* _ph, unsigned int _pid, unsigned int _tid,
+                const std::string& _name, double _time, std::size_t _asyncId )
+            {
+                begin( _ph, _pid, _tid ) << ",\"cat\":\"queue\",\"name\":";
+                writeString( m_os, _name );
+                m_os << ",\"ts\":" << _time << ",\"id\":" << _asyncId << "}";
+            }
+
+        private:
+            ::std::ostream& m_os;
+            bool m_first = {true};
+        };
+
+        //! \brief open intervals of one vertex at one process unit
+        struct VertexState
+        {
+            const TraceEvent* ready = {nullptr};    //!< \brief last TRACE_READY
+            std::deque< const TraceEvent* > starts; //!< \brief TRACE_START without TRACE_FINISH
+            const TraceEvent* branch = {nullptr};   //!< \brief last TRACE_THEN or TRACE_ELSE
+            std::size_t queueId = {0};              //!< \brief id of the open queue slice
+        };
+    }
+
+    /************************************************************************/
+    /* ChromeTraceExporter                                                  */
+    /************************************************************************/
+    void ChromeTraceExporter::read( const std::string& _fileName )
+    {
+        std::ifstream file( _fileName, std::ios::binary );
+        if ( !file )
+            {
+                SC_REPORT_ERROR( "ChromeTraceExporter", ( "cannot open " + _fileName ).c_str( ) );
+                return;
+            }
+
+        TraceFileHeader header;
+        file.read( reinterpret_cast< char* >( &header ), sizeof( header ) );
+
+        if ( !file || ( 0 != std::strncmp( header.magic, "VCTRACE", sizeof( header.magic ) ) ) ||
+             ( 2 != header.version ) || ( sizeof( TraceEvent ) != header.recordSize ) )
+            {
+                SC_REPORT_ERROR(
+                    "ChromeTraceExporter", ( _fileName + " is no execution trace" ).c_str( ) );
+                return;
+            }
+
+        if ( ( 0.0 != m_resolution ) && ( header.resolution != m_resolution ) )
+            {
+                SC_REPORT_ERROR( "ChromeTraceExporter",
+                    ( _fileName + " has a different time resolution" ).c_str( ) );
+                return;
+            }
+        m_resolution = header.resolution;
+
+        TraceEvent event;
+        while ( file.read( reinterpret_cast< char* >( &event ), sizeof( event ) ) )
+            m_events.push_back( event );
+    }
+
+    void ChromeTraceExporter::write( const std::string& _fileName ) const
+    {
+        std::ofstream file( _fileName, std::ios::trunc );
+        if ( !file )
+            {
+                SC_REPORT_ERROR( "ChromeTraceExporter", ( "cannot open " + _fileName ).c_str( ) );
+                return;
+            }
+
+        write( file );
+    }
+
+    void ChromeTraceExporter::write( ::std::ostream& _os ) const
+    {
+        // the writer stores the events per process unit and TRACE_FINISH ahead of its
+        // time, merge them in time order (a FINISH sorts before the START of the next
+        // vertex at the same time, because it is recorded in an earlier delta cycle)
+        std::vector< const TraceEvent* > events;
+        events.reserve( m_events.size( ) );
+        for ( auto& event : m_events )
+            events.push_back( &event );
+
+        std::stable_sort( events.begin( ), events.end( ),
+            []( const TraceEvent* _lhs, const TraceEvent* _rhs ) {
+                return ( _lhs->time < _rhs->time ) ||
+                       ( ( _lhs->time == _rhs->time ) && ( _lhs->delta < _rhs->delta ) );
+            } );
+
+        auto flags = _os.flags( );
+        auto precision = _os.precision( );
+        _os << std::fixed << std::setprecision( 6 ) << "{\"traceEvents\":[";
+
+        EventListWriter writer( _os );
+
+        // name processes and threads
+        std::set< unsigned int > units;
+        std::set< std::pair< unsigned int, std::uint32_t > > sockets;
+
+        for ( auto event : events )
+            {
+                if ( ( TRACE_SEND_BEGIN == event->kind ) || ( TRACE_SEND_END == event->kind ) )
+                    sockets.insert( std::make_pair( event->unitId, event->vertexId ) );
+                else
+                    units.insert( event->unitId );
+            }
+
+        for ( auto unit : units )
+            {
+                writer.meta(
+                    "process_name", unit, CORE_TRACK, getName( m_unitNames, unit, "unit" ) );
+                writer.meta( "thread_name", unit, CORE_TRACK, "core" );
+                writer.meta( "thread_name", unit, QUEUE_TRACK, "queue" );
+                writer.meta( "thread_name", unit, CONTROL_TRACK, "control" );
+            }
+
+        unsigned int lastInterconnect = 0;
+        for ( auto& socket : sockets )
+            {
+                auto pid = INTERCONNECT_PID_OFFSET + socket.first;
+
+                if ( pid != lastInterconnect )
+                    writer.meta( "process_name", pid, 0,
+                        getName( m_interconnectNames, socket.first, "interconnect" ) );
+                lastInterconnect = pid;
+
+                writer.meta( "thread_name", pid, socket.second,
+                    "socket " + std::to_string( socket.second ) );
+            }
+
+        // pair the events of every vertex and socket
+        std::map< std::pair< unsigned int, std::uint32_t >, VertexState > vertices;
+        std::map< std::tuple< unsigned int, std::uint32_t, std::uint32_t >, const TraceEvent* >
+            sends;
+        std::size_t nextQueueId = 0;
+
+        for ( auto event : events )
+            {
+                auto key = std::make_pair( static_cast< unsigned int >( event->unitId ),
+                    event->vertexId );
+                auto time = toMicroseconds( *event );
+
+                switch ( event->kind )
+                    {
+                    case TRACE_READY:
+                        {
+                            auto& state = vertices[ key ];
+                            // an execution started before may finish after this READY
+                            state.ready = event;
+                            state.branch = nullptr;
+                            state.queueId = ++nextQueueId;
+                            writer.async( "b", key.first, QUEUE_TRACK,
+                                getName( m_vertexNames, key.second, "vertex" ), time,
+                                state.queueId );
+                        }
+                        break;
+
+                    case TRACE_START:
+                        {
+                            auto& state = vertices[ key ];
+                            state.starts.push_back( event );
+                            if ( nullptr != state.ready )
+                                writer.async( "e", key.first, QUEUE_TRACK,
+                                    getName( m_vertexNames, key.second, "vertex" ), time,
+                                    state.queueId );
+                            state.ready = nullptr;
+                        }
+                        break;
+
+                    case TRACE_THEN:
+                    case TRACE_ELSE:
+                        {
+                            // an IfVertex does not wait for the core, close its queue slice
+                            auto& state = vertices[ key ];
+                            state.branch = event;
+                            if ( nullptr != state.ready )
+                                writer.async( "e", key.first, QUEUE_TRACK,
+                                    getName( m_vertexNames, key.second, "vertex" ), time,
+                                    state.queueId );
+                        }
+                        break;
+
+                    case TRACE_FINISH:
+                        {
+                            auto& state = vertices[ key ];
+                            auto name = getName( m_vertexNames, key.second, "vertex" );
+
+                            if ( nullptr != state.branch )
+                                {
+                                    auto begin = ( nullptr != state.ready )
+                                                     ? toMicroseconds( *state.ready )
+                                                     : toMicroseconds( *state.branch );
+                                    auto branch = toMicroseconds( *state.branch );
+
+                                    writer.complete( key.first, CONTROL_TRACK, name, begin,
+                                        time - begin, key.second );
+                                    writer.complete( key.first, CONTROL_TRACK,
+                                        ( TRACE_THEN == state.branch->kind ) ? "then" : "else",
+                                        branch, time - branch, key.second );
+
+                                    state.ready = nullptr;
+                                    state.branch = nullptr;
+                                }
+                            else if ( !state.starts.empty( ) )
+                                {
+                                    // executions of a vertex finish in the order they started
+                                    auto begin = toMicroseconds( *state.starts.front( ) );
+                                    state.starts.pop_front( );
+                                    writer.complete( key.first, CORE_TRACK, name, begin,
+                                        time - begin, key.second );
+                                }
+                        }
+                        break;
+
+                    case TRACE_SEND_BEGIN:
+                        sends[ std::make_tuple( key.first, key.second, event->transactionId ) ] =
+                            event;
+                        break;
+
+                    case TRACE_SEND_END:
+                        {
+                            auto it = sends.find(
+                                std::make_tuple( key.first, key.second, event->transactionId ) );
+                            if ( sends.end( ) != it )
+                                {
+                                    auto begin = toMicroseconds( *it->second );
+                                    sends.erase( it );
+                                    writer.complete( INTERCONNECT_PID_OFFSET + key.first,
+                                        key.second, "transmit", begin, time - begin,
+                                        event->transactionId );
+                                }
+                        }
+                        break;
+
+                    default: break;
+                    }
+            }
+
+        _os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        _os.flags( flags );
+        _os.precision( precision );
+    }
+
+    std::string ChromeTraceExporter::getName(
+        const std::map< unsigned int, std::string >& _names, unsigned int _id, const char* _prefix )
+    {
+        auto it = _names.find( _id );
+        if ( _names.end( ) != it )
+            return it->second;
+
+        return std::string( _prefix ) + " " + std::to_string( _id );
+    }
+}
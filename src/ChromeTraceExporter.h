@@ -0,0 +1,134 @@
+//! \file ChromeTraceExporter.h
+//! \brief Conversion of binary execution traces into Chrome Trace Event JSON
+
+#ifndef CHROMETRACEEXPORTER_H_
+#define CHROMETRACEEXPORTER_H_
+
+#include "ExecutionTrace.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <iostream>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // ChromeTraceExporter
+    //!
+    //! \class ChromeTraceExporter
+    //!
+    //! \brief Write a timeline of binary trace files for chrome://tracing and Perfetto
+    //!
+    //! \details
+    //! The exporter reads files written by the TraceWriter (simulation built
+    //! with USE_EXECUTION_TRACE) and writes Chrome Trace Event JSON, which
+    //! both chrome://tracing and the Perfetto UI load:
+    //! - one process per ProcessUnit_Base with the threads
+    //!   - "core": busy interval of every vertex (TRACE_START to TRACE_FINISH,
+    //!     which is recorded at START + latency), back to back while other
+    //!     vertices wait for the core, gaps are idle time. Executions of a
+    //!     vertex are paired in start order, so a READY of the next
+    //!     execution before the FINISH of the former one loses no slice,
+    //!   - "queue": waiting for the core (TRACE_READY to TRACE_START) as
+    //!     async slices, so waiting vertices may overlap,
+    //!   - "control": IfVertex activity (TRACE_READY to TRACE_FINISH) with
+    //!     the then or else path as nested slice,
+    //! - one process per interconnect with one thread per outgoing socket
+    //!   (TRACE_SEND_BEGIN to TRACE_SEND_END of every transaction, paired
+    //!   by the transaction id of the records).
+    //!
+    //! Names of vertices, units and interconnects are optional.
+    //!
+    //! \code
+    //! TraceWriter::getInstance( ).open( "execution_trace.bin" );
+    //! sc_core::sc_start( );
+    //! TraceWriter::getInstance( ).close( );
+    //!
+    //! ChromeTraceExporter exporter;
+    //! exporter.setVertexName( 1, "add" );
+    //! exporter.read( "execution_trace.bin" );
+    //! exporter.write( "timeline.json" );
+    //! \endcode
+    /************************************************************************/
+    class ChromeTraceExporter
+    {
+    public:
+        //! \brief constructor
+        ChromeTraceExporter( ) = default;
+
+        //! \brief destructor
+        ~ChromeTraceExporter( ) = default;
+
+    private:
+        // forbidden constructors
+        ChromeTraceExporter( const ChromeTraceExporter& _source ) = delete; //!< \brief forbidden
+        ChromeTraceExporter& operator=(
+            const ChromeTraceExporter& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        //! \brief append the events of binary trace file _fileName
+        void read( const std::string& _fileName );
+
+        //! \brief write JSON to file _fileName
+        void write( const std::string& _fileName ) const;
+
+        //! \brief write JSON to _os
+        void write( ::std::ostream& _os ) const;
+
+        //! \brief name of vertex _id (default "vertex <id>")
+        void setVertexName( unsigned int _id, const std::string& _name )
+        {
+            m_vertexNames[ _id ] = _name;
+        }
+
+        //! \brief name of process unit _id (default "unit <id>")
+        void setUnitName( unsigned int _id, const std::string& _name )
+        {
+            m_unitNames[ _id ] = _name;
+        }
+
+        //! \brief name of interconnect _id (default "interconnect <id>")
+        void setInterconnectName( unsigned int _id, const std::string& _name )
+        {
+            m_interconnectNames[ _id ] = _name;
+        }
+
+        //! \brief number of read events
+        std::size_t getNumberOfEvents( void ) const { return m_events.size( ); }
+
+    private:
+        //! \brief name of _id in _names or _prefix and _id
+        static std::string getName( const std::map< unsigned int, std::string >& _names,
+            unsigned int _id, const char* _prefix );
+
+        //! \brief time stamp of _event in microseconds
+        double toMicroseconds( const TraceEvent& _event ) const
+        {
+            return static_cast< double >( _event.time ) * m_resolution * 1e6;
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_events
+        //! \brief events of all read files
+        std::vector< TraceEvent > m_events;
+        //! \var m_resolution
+        //! \brief time resolution of the events in seconds (0 = no file read)
+        double m_resolution = {0.0};
+        //! \var m_vertexNames
+        //! \brief names of vertices by vertex id
+        std::map< unsigned int, std::string > m_vertexNames;
+        //! \var m_unitNames
+        //! \brief names of process units by unit id
+        std::map< unsigned int, std::string > m_unitNames;
+        //! \var m_interconnectNames
+        //! \brief names of interconnects by trace id
+        std::map< unsigned int, std::string > m_interconnectNames;
+    };
+}
+
+
+#endif // !CHROMETRACEEXPORTER_H_
@@ -0,0 +1,540 @@
+//! \file ColorMapper.cpp
+//! \brief Mapping of vertex color clusters onto the nodes of a mesh
+
+#include "ColorMapper.h"
+#include <algorithm>
+#include <map>
+#include <array>
+#include <cmath>
+
+namespace vc_utils
+{
+
+    ColorMapper::ColorMapper( unsigned int _width, unsigned int _height )
+        : m_width( _width ),
+          m_height( _height ),
+          m_nodeCapabilities( _width * _height, ALL_CAPABILITIES )
+    {
+        sc_assert( ( 0 < m_width ) && ( 0 < m_height ) );
+    }
+
+    /************************************************************************/
+    /* mapping                                                              */
+    /************************************************************************/
+    void ColorMapper::map( const GraphBuilder::EdgeList& _edges )
+    {
+        buildClusterGraph( _edges );
+        m_vertexNode.clear( );
+
+        auto numOfClusters = static_cast< unsigned int >( m_colors.size( ) );
+        m_nodeOf.assign( numOfClusters, 0 );
+        m_part.assign( numOfClusters, -1 );
+
+        std::vector< unsigned int > clusters( numOfClusters );
+        for ( unsigned int c = 0; c < numOfClusters; ++c )
+            clusters[ c ] = c;
+
+        bisect( clusters, 0, 0, m_width, m_height );
+
+        m_nodeLoad.assign( m_width * m_height, 0.0 );
+        for ( unsigned int c = 0; c < numOfClusters; ++c )
+            m_nodeLoad[ m_nodeOf[ c ] ] += m_load[ c ];
+
+        refine( );
+        m_mapped = true;
+    }
+
+    void ColorMapper::buildClusterGraph( const GraphBuilder::EdgeList& _edges )
+    {
+        if ( _edges.rowPtr.size( ) != m_vertices.size( ) + 1 )
+            SC_REPORT_ERROR( "ColorMapper", "row pointer size does not match vertex list" );
+
+        // one cluster per color of the mapped vertices
+        std::map< unsigned int, unsigned int > clusterOfColor;
+        bool timed = false;
+
+        m_colors.clear( );
+        m_clusterOf.assign( m_vertices.size( ), -1 );
+
+        for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+            {
+                const auto& vertex = m_vertices[ v ];
+
+                if ( 0 <= vertex.fixedNode )
+                    continue;
+
+                auto next = static_cast< unsigned int >( m_colors.size( ) );
+                auto inserted = clusterOfColor.insert( std::make_pair( vertex.color, next ) );
+                if ( inserted.second )
+                    m_colors.push_back( vertex.color );
+
+                m_clusterOf[ v ] = static_cast< int >( inserted.first->second );
+                timed = timed || ( sc_core::SC_ZERO_TIME != vertex.latency );
+            }
+
+        // load by process latency, by number of vertices if no latency is set
+        m_required.assign( m_colors.size( ), 0 );
+        m_load.assign( m_colors.size( ), 0.0 );
+        m_vertexLoad.assign( m_vertices.size( ), 0.0 );
+        m_totalLoad = 0.0;
+
+        for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+            {
+                if ( 0 > m_clusterOf[ v ] )
+                    continue;
+
+                auto load = timed ? m_vertices[ v ].latency.to_seconds( ) : 1.0;
+                m_vertexLoad[ v ] = load;
+                m_required[ m_clusterOf[ v ] ] |= m_vertices[ v ].capability;
+                m_load[ m_clusterOf[ v ] ] += load;
+                m_totalLoad += load;
+            }
+
+        // edges between clusters in both directions and to fixed nodes
+        std::vector< std::map< unsigned int, double > > neighbours( m_colors.size( ) );
+        std::vector< std::map< unsigned int, double > > terminals( m_colors.size( ) );
+        m_totalEdges = 0.0;
+        m_fixedCost = 0.0;
+        m_edges.clear( );
+
+        for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+            for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                {
+                    auto d = _edges.dst[ e ];
+                    if ( d >= m_vertices.size( ) )
+                        SC_REPORT_ERROR( "ColorMapper", "edge consumer out of range" );
+
+                    auto src = m_clusterOf[ v ];
+                    auto dst = m_clusterOf[ d ];
+
+                    if ( v == d )
+                        continue;
+
+                    // every edge scales the imbalance, see getBalanceScale
+                    m_edges.push_back( std::make_pair( v, d ) );
+                    m_totalEdges += 1.0;
+
+                    if ( ( 0 <= src ) && ( 0 <= dst ) )
+                        {
+                            if ( src == dst )
+                                continue;
+
+                            neighbours[ src ][ dst ] += 1.0;
+                            neighbours[ dst ][ src ] += 1.0;
+                        }
+                    else if ( 0 <= src )
+                        terminals[ src ][ m_vertices[ d ].fixedNode ] += 1.0;
+                    else if ( 0 <= dst )
+                        terminals[ dst ][ m_vertices[ v ].fixedNode ] += 1.0;
+                    else
+                        m_fixedCost += getMeshHops( m_width,
+                            static_cast< unsigned int >( m_vertices[ v ].fixedNode ),
+                            static_cast< unsigned int >( m_vertices[ d ].fixedNode ) );
+                }
+
+        m_neighbours.assign( m_colors.size( ), {} );
+        m_terminals.assign( m_colors.size( ), {} );
+
+        for ( unsigned int c = 0; c < m_colors.size( ); ++c )
+            {
+                m_neighbours[ c ].assign( neighbours[ c ].begin( ), neighbours[ c ].end( ) );
+                m_terminals[ c ].assign( terminals[ c ].begin( ), terminals[ c ].end( ) );
+            }
+    }
+
+    void ColorMapper::bisect( std::vector< unsigned int >& _clusters, unsigned int _x,
+        unsigned int _y, unsigned int _width, unsigned int _height )
+    {
+        if ( _clusters.empty( ) )
+            return;
+
+        if ( 1 == _width * _height )
+            {
+                for ( auto c : _clusters )
+                    m_nodeOf[ c ] = _y * m_width + _x;
+                return;
+            }
+
+        // halve the longer side, part 0 is the left or upper half
+        bool splitX = ( _width >= _height );
+        auto width0 = splitX ? _width / 2 : _width;
+        auto height0 = splitX ? _height : _height / 2;
+        auto x1 = splitX ? _x + width0 : _x;
+        auto y1 = splitX ? _y : _y + height0;
+        auto width1 = splitX ? _width - width0 : _width;
+        auto height1 = splitX ? _height : _height - height0;
+        auto share = static_cast< double >( width0 * height0 ) / ( _width * _height );
+
+        double load = 0.0;
+        double maxLoad = 0.0;
+
+        for ( auto c : _clusters )
+            {
+                m_part[ c ] = 1;
+                load += m_load[ c ];
+                maxLoad = std::max( maxLoad, m_load[ c ] );
+            }
+
+        auto target = share * load;
+        double load0 = 0.0;
+        std::vector< double > pull( m_colors.size( ), 0.0 );
+
+        // allowed parts by capabilities (bit 0 = part 0, bit 1 = part 1)
+        std::vector< char > allowed( m_colors.size( ), 0 );
+
+        for ( auto c : _clusters )
+            {
+                allowed[ c ] =
+                    ( isSupported( m_required[ c ], _x, _y, width0, height0 ) ? 1 : 0 ) |
+                    ( isSupported( m_required[ c ], x1, y1, width1, height1 ) ? 2 : 0 );
+
+                if ( 0 == allowed[ c ] )
+                    SC_REPORT_ERROR(
+                        "ColorMapper", "no process unit offers the capabilities of a color" );
+
+                // clusters only supported in part 0
+                if ( 1 == allowed[ c ] )
+                    {
+                        m_part[ c ] = 0;
+                        load0 += m_load[ c ];
+
+                        for ( const auto& neighbour : m_neighbours[ c ] )
+                            pull[ neighbour.first ] += neighbour.second;
+                    }
+            }
+
+        // greedy graph growing: add the cluster with most edges into part 0
+
+        while ( load0 < target )
+            {
+                int best = -1;
+
+                for ( auto c : _clusters )
+                    {
+                        if ( ( 1 == m_part[ c ] ) && ( 3 == allowed[ c ] ) &&
+                             ( ( 0 > best ) || ( pull[ best ] < pull[ c ] ) ) )
+                            best = static_cast< int >( c );
+                    }
+
+                // stop if the overshoot is larger than the remaining gap
+                if ( ( 0 > best ) ||
+                     ( ( 0.0 < load0 ) && ( load0 + m_load[ best ] - target > target - load0 ) ) )
+                    break;
+
+                m_part[ best ] = 0;
+                load0 += m_load[ best ];
+
+                for ( const auto& neighbour : m_neighbours[ best ] )
+                    pull[ neighbour.first ] += neighbour.second;
+            }
+
+        // refinement: move clusters with positive gain within the balance tolerance
+        auto tolerance = std::max( 0.05 * load, 0.5 * maxLoad );
+
+        for ( unsigned int pass = 0; pass < 8; ++pass )
+            {
+                bool moved = false;
+
+                for ( auto c : _clusters )
+                    {
+                        if ( 3 != allowed[ c ] )
+                            continue;
+
+                        double gain = 0.0;
+
+                        for ( const auto& neighbour : m_neighbours[ c ] )
+                            {
+                                auto side = m_part[ neighbour.first ];
+                                if ( 0 > side )
+                                    continue;
+
+                                gain += ( side == m_part[ c ] ) ? -neighbour.second
+                                                                : neighbour.second;
+                            }
+
+                        auto newLoad0 = ( 0 == m_part[ c ] ) ? load0 - m_load[ c ]
+                                                             : load0 + m_load[ c ];
+                        auto deviation = std::fabs( load0 - target );
+                        auto newDeviation = std::fabs( newLoad0 - target );
+                        bool balanced = newDeviation <= std::max( tolerance, deviation );
+
+                        if ( ( ( 0.0 < gain ) && balanced ) ||
+                             ( ( 0.0 == gain ) && ( newDeviation < deviation ) ) )
+                            {
+                                m_part[ c ] = 1 - m_part[ c ];
+                                load0 = newLoad0;
+                                moved = true;
+                            }
+                    }
+
+                if ( !moved )
+                    break;
+            }
+
+        std::vector< unsigned int > part0;
+        std::vector< unsigned int > part1;
+
+        for ( auto c : _clusters )
+            {
+                ( 0 == m_part[ c ] ? part0 : part1 ).push_back( c );
+                m_part[ c ] = -1;
+            }
+
+        bisect( part0, _x, _y, width0, height0 );
+        bisect( part1, x1, y1, width1, height1 );
+    }
+
+    bool ColorMapper::isSupported( capability_t _capabilities, unsigned int _x, unsigned int _y,
+        unsigned int _width, unsigned int _height ) const
+    {
+        for ( unsigned int y = _y; y < _y + _height; ++y )
+            for ( unsigned int x = _x; x < _x + _width; ++x )
+                if ( supportsCapabilities( m_nodeCapabilities[ y * m_width + x ], _capabilities ) )
+                    return true;
+
+        return false;
+    }
+
+    void ColorMapper::refine( void )
+    {
+        auto numOfNodes = m_width * m_height;
+
+        for ( unsigned int pass = 0; pass < 16; ++pass )
+            {
+                bool moved = false;
+
+                for ( unsigned int c = 0; c < m_colors.size( ); ++c )
+                    {
+                        auto bestNode = m_nodeOf[ c ];
+                        double bestGain = 1e-12;
+
+                        for ( unsigned int node = 0; node < numOfNodes; ++node )
+                            {
+                                if ( ( node == m_nodeOf[ c ] ) ||
+                                     !supportsCapabilities(
+                                         m_nodeCapabilities[ node ], m_required[ c ] ) )
+                                    continue;
+
+                                auto gain = getMoveGain( c, node );
+                                if ( gain > bestGain )
+                                    {
+                                        bestGain = gain;
+                                        bestNode = node;
+                                    }
+                            }
+
+                        if ( bestNode != m_nodeOf[ c ] )
+                            {
+                                m_nodeLoad[ m_nodeOf[ c ] ] -= m_load[ c ];
+                                m_nodeLoad[ bestNode ] += m_load[ c ];
+                                m_nodeOf[ c ] = bestNode;
+                                moved = true;
+                            }
+                    }
+
+                if ( !moved )
+                    break;
+            }
+    }
+
+    double ColorMapper::getMoveGain( unsigned int _cluster, unsigned int _node ) const
+    {
+        auto current = m_nodeOf[ _cluster ];
+        double gain = 0.0;
+
+        for ( const auto& neighbour : m_neighbours[ _cluster ] )
+            {
+                auto other = m_nodeOf[ neighbour.first ];
+                gain += neighbour.second *
+                        ( static_cast< double >( getMeshHops( m_width, current, other ) ) -
+                            getMeshHops( m_width, _node, other ) );
+            }
+
+        for ( const auto& terminal : m_terminals[ _cluster ] )
+            {
+                auto fixed = terminal.first;
+                gain += terminal.second *
+                        ( static_cast< double >( getMeshHops( m_width, current, fixed ) ) -
+                            getMeshHops( m_width, _node, fixed ) );
+            }
+
+        if ( 0.0 < m_totalLoad )
+            {
+                // change of the sum of squared node loads, see getLoadImbalance
+                auto load = m_load[ _cluster ];
+                auto from = m_nodeLoad[ current ];
+                auto to = m_nodeLoad[ _node ];
+                auto before = from * from + to * to;
+                auto after = ( from - load ) * ( from - load ) + ( to + load ) * ( to + load );
+
+                gain += getBalanceScale( m_balanceWeight, m_totalEdges ) * ( m_width * m_height ) *
+                        ( before - after ) / ( m_totalLoad * m_totalLoad );
+            }
+
+        return gain;
+    }
+
+    /************************************************************************/
+    /* results                                                              */
+    /************************************************************************/
+    unsigned int ColorMapper::getNodeOfVertex( unsigned int _vertex ) const
+    {
+        const auto& vertex = m_vertices.at( _vertex );
+
+        if ( 0 <= vertex.fixedNode )
+            return static_cast< unsigned int >( vertex.fixedNode );
+
+        if ( !m_mapped )
+            SC_REPORT_ERROR( "ColorMapper", "vertices are not mapped" );
+
+        if ( !m_vertexNode.empty( ) )
+            return m_vertexNode[ _vertex ];
+
+        return m_nodeOf[ m_clusterOf[ _vertex ] ];
+    }
+
+    void ColorMapper::setPlacement( const std::vector< unsigned int >& _nodeOfVertex )
+    {
+        if ( !m_mapped )
+            SC_REPORT_ERROR( "ColorMapper", "vertices are not mapped" );
+        if ( _nodeOfVertex.size( ) != m_vertices.size( ) )
+            SC_REPORT_ERROR( "ColorMapper", "placement size does not match vertex list" );
+
+        for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+            {
+                auto node = static_cast< int >( _nodeOfVertex[ v ] );
+                auto fixedNode = m_vertices[ v ].fixedNode;
+
+                if ( _nodeOfVertex[ v ] >= m_width * m_height )
+                    SC_REPORT_ERROR( "ColorMapper", "vertex placed on a not existing node" );
+                if ( ( 0 <= fixedNode ) && ( node != fixedNode ) )
+                    SC_REPORT_ERROR( "ColorMapper", "external subject moved" );
+            }
+
+        m_vertexNode = _nodeOfVertex;
+    }
+
+    unsigned int ColorMapper::getNodeOfColor( unsigned int _color ) const
+    {
+        auto it = std::find( m_colors.begin( ), m_colors.end( ), _color );
+
+        if ( !m_mapped || ( it == m_colors.end( ) ) )
+            SC_REPORT_ERROR( "ColorMapper", "color is not mapped" );
+
+        return m_nodeOf[ it - m_colors.begin( ) ];
+    }
+
+    double ColorMapper::getCommunicationCost( void ) const
+    {
+        double cost = 0.0;
+
+        // vertices of a cluster may be placed on different nodes
+        if ( !m_vertexNode.empty( ) )
+            {
+                for ( const auto& edge : m_edges )
+                    cost += getMeshHops( m_width, getNodeOfVertex( edge.first ),
+                        getNodeOfVertex( edge.second ) );
+
+                return cost;
+            }
+
+        // edges between external subjects do not depend on the mapping
+        cost = m_fixedCost;
+
+        for ( unsigned int c = 0; c < m_colors.size( ); ++c )
+            {
+                // every edge between clusters is stored at both clusters
+                for ( const auto& neighbour : m_neighbours[ c ] )
+                    cost += 0.5 * neighbour.second *
+                            getMeshHops( m_width, m_nodeOf[ c ], m_nodeOf[ neighbour.first ] );
+
+                for ( const auto& terminal : m_terminals[ c ] )
+                    cost += terminal.second *
+                            getMeshHops( m_width, m_nodeOf[ c ], terminal.first );
+            }
+
+        return cost;
+    }
+
+    double ColorMapper::getImbalance( void ) const
+    {
+        return getLoadImbalance( getNodeLoads( ), m_totalLoad );
+    }
+
+    std::vector< double > ColorMapper::getNodeLoads( void ) const
+    {
+        if ( m_vertexNode.empty( ) )
+            return m_nodeLoad;
+
+        std::vector< double > nodeLoad( m_width * m_height, 0.0 );
+
+        for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+            nodeLoad[ m_vertexNode[ v ] ] += m_vertexLoad[ v ];
+
+        return nodeLoad;
+    }
+
+    double ColorMapper::getCost( void ) const
+    {
+        return getCommunicationCost( ) +
+               getBalanceScale( m_balanceWeight, m_totalEdges ) * getImbalance( );
+    }
+
+    double ColorMapper::getUtilization( capability_t _class ) const
+    {
+        sc_assert( NUM_OF_CAPABILITIES > getCapabilityIndex( _class ) );
+
+        std::vector< double > nodeLoad( m_width * m_height, 0.0 );
+        double load = 0.0;
+
+        for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+            {
+                if ( 0 <= m_vertices[ v ].fixedNode )
+                    continue;
+
+                nodeLoad[ getNodeOfVertex( v ) ] += m_vertexLoad[ v ];
+                if ( _class == m_vertices[ v ].capability )
+                    load += m_vertexLoad[ v ];
+            }
+
+        auto units = std::count_if( m_nodeCapabilities.begin( ), m_nodeCapabilities.end( ),
+            [_class]( capability_t _offered ) {
+                return supportsCapabilities( _offered, _class );
+            } );
+        auto maxLoad = *std::max_element( nodeLoad.begin( ), nodeLoad.end( ) );
+
+        if ( ( 0 == units ) || ( 0.0 >= maxLoad ) )
+            return 0.0;
+
+        return load / ( units * maxLoad );
+    }
+
+    void ColorMapper::printUtilization( ::std::ostream& os ) const
+    {
+        std::array< unsigned int, NUM_OF_CAPABILITIES > numOfVertices = {};
+        std::array< double, NUM_OF_CAPABILITIES > load = {};
+
+        for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+            {
+                if ( 0 <= m_vertices[ v ].fixedNode )
+                    continue;
+
+                auto index = getCapabilityIndex( m_vertices[ v ].capability );
+                ++numOfVertices[ index ];
+                load[ index ] += m_vertexLoad[ v ];
+            }
+
+        for ( unsigned int index = 0; index < NUM_OF_CAPABILITIES; ++index )
+            {
+                capability_t capability = 1u << index;
+                auto units = std::count_if( m_nodeCapabilities.begin( ), m_nodeCapabilities.end( ),
+                    [capability]( capability_t _offered ) {
+                        return supportsCapabilities( _offered, capability );
+                    } );
+
+                os << getCapabilityName( index ) << ": vertices: " << numOfVertices[ index ]
+                   << ", load: " << load[ index ] << ", units: " << units
+                   << ", utilization: " << getUtilization( capability ) << ::std::endl;
+            }
+    }
+}
@@ -0,0 +1,421 @@
+//! \file ColorMapper.h
+//! \brief Mapping of vertex color clusters onto the nodes of a mesh
+
+#ifndef COLORMAPPER_H_
+#define COLORMAPPER_H_
+
+#include "Typedefinitions.h"
+#include "Subject.h"
+#include "ProcessUnit_Base.h"
+#include "GraphBuilder.h"
+#include "Capability.h"
+#include "PlacementConnector.h"
+#include "MeshPlacement.h"
+#include <vector>
+#include <string>
+#include <utility>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // ColorMapper
+    //!
+    //! \class ColorMapper
+    //!
+    //! \brief Assign every color cluster of a task graph to a mesh node
+    //!
+    //! \details
+    //! The mapper collects a vertex list like GraphBuilder. Vertices with
+    //! the same clustering color form a cluster; its load is the sum of the
+    //! process latencies of its vertices. Existing subjects (e.g. Memory)
+    //! are added at a fixed node.
+    //!
+    //! map() assigns clusters to nodes by recursive bisection: the mesh is
+    //! halved along its longer side, and the clusters are split into two
+    //! parts with loads in the ratio of the node counts. The split keeps as
+    //! few edges as possible between the parts (greedy graph growing and
+    //! gain based refinement). Edges between far clusters are cut first,
+    //! so heavy communication stays close. A final pass moves single
+    //! clusters to other nodes while the cost decreases:
+    //!
+    //!   cost = sum of edges * hops + balance weight * edges * imbalance
+    //!
+    //! The imbalance is getLoadImbalance of the node loads (0 = balanced)
+    //! and edges counts all edges without self loops (getBalanceScale), as
+    //! in the PlacementOptimizer. Without critical path weight both costs
+    //! are equal for the same placement.
+    //!
+    //! A cluster needs the capability classes of all its vertices, and is
+    //! only mapped onto nodes whose process unit offers all of them (see
+    //! setCapabilities). getUtilization reports the load of every class
+    //! against the capacity of the units offering it.
+    //!
+    //! build() creates the vertices at the process units of their nodes
+    //! and wires the edges by a PlacementConnector, so edges inside a
+    //! cluster and between clusters at the same node are local.
+    //!
+    //! \code
+    //! ColorMapper mapper( fabric.getWidth( ), fabric.getHeight( ) );
+    //! auto m = mapper.addSubject< Memory >( &memory, 100, 0, 0 );
+    //! auto a = mapper.addVertex< AddVertex<> >( 1, "add", 0, latency );
+    //! auto b = mapper.addVertex< MulVertex<> >( 2, "mul", 1, latency );
+    //! auto edges = GraphBuilder::EdgeList::fromEdges( mapper.getNumberOfVertices( ),
+    //!     { { m, 0, a, 0 }, { m, 1, a, 1 }, { a, 0, b, 0 }, { m, 2, b, 1 }, { b, 0, m, 0 } } );
+    //! PlacementConnector< > connector( fabric );
+    //! mapper.build( connector, edges );
+    //! \endcode
+    /************************************************************************/
+    class ColorMapper
+    {
+    public:
+        /************************************************************************/
+        /* type definitions                                                     */
+        /************************************************************************/
+        //! \typedef portResolver_t
+        //! \brief return Observer with id of a consumer or nullptr
+        typedef GraphBuilder::portResolver_t portResolver_t;
+        //! \typedef vertexFactory_t
+        //! \brief create vertex at its process unit and return it
+        typedef GraphBuilder::vertexFactory_t vertexFactory_t;
+
+    private:
+        //! \struct VertexDesc
+        //! \brief description of one vertex of the vertex list
+        struct VertexDesc
+        {
+            unsigned int id;         //!< \brief vertex id, also placement id
+            std::string name;        //!< \brief sc_module name
+            unsigned int color;      //!< \brief clustering color
+            sc_time_t latency;       //!< \brief process latency
+            vertexFactory_t factory; //!< \brief creates vertex (nullptr for external subjects)
+            portResolver_t resolver; //!< \brief returns Observer of consumer port
+            Subject* subject;        //!< \brief created or external subject
+            int fixedNode;           //!< \brief node of external subject (-1 = mapped)
+            capability_t capability; //!< \brief needed capability class (0 = none)
+        };
+
+    public:
+        //! \brief constructor for a mesh of _width x _height nodes
+        explicit ColorMapper( unsigned int _width, unsigned int _height );
+
+        //! \brief destructor (vertices are owned by their process units)
+        ~ColorMapper( ) = default;
+
+    private:
+        // forbidden constructors
+        ColorMapper( ) = delete;                                    //!< \brief forbidden
+        ColorMapper( const ColorMapper& _source ) = delete;         //!< \brief forbidden
+        ColorMapper& operator=( const ColorMapper& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // addVertex
+        //!
+        //! \brief    append task graph vertex to vertex list
+        //!
+        //! \param [in] _id vertex id (unique in the graph)
+        //! \param [in] _name sc_module name
+        //! \param [in] _color clustering color
+        //! \param [in] _latency process latency, used as load
+        //! \return   unsigned int: vertex index used in the edge list
+        //!
+        //! \tparam vertexT type of vertex (derived from Task_Base)
+        /***************************************************************/
+        template < class vertexT >
+        unsigned int addVertex(
+            unsigned int _id, std::string _name, unsigned int _color, const sc_time_t& _latency )
+        {
+            m_vertices.push_back( VertexDesc{_id, std::move( _name ), _color, _latency,
+                &GraphBuilder::createVertex< vertexT >, &GraphBuilder::resolvePort< Task_Base >,
+                nullptr, -1, VertexCapability< vertexT >::value} );
+            m_mapped = false;
+
+            return static_cast< unsigned int >( m_vertices.size( ) - 1 );
+        }
+
+        /***************************************************************/
+        // addSubject
+        //!
+        //! \brief    append an existing subject at a fixed node
+        //!
+        //! \param [in] _subject existing producer and/or consumer
+        //! \param [in] _id placement id (unique in the graph)
+        //! \param [in] _x x position of node
+        //! \param [in] _y y position of node
+        //! \return   unsigned int: vertex index used in the edge list
+        //!
+        //! \tparam nodeTypeT type of _subject that includes an ObserverManager inputObs
+        /***************************************************************/
+        template < class nodeTypeT >
+        unsigned int addSubject( Subject* _subject, unsigned int _id, unsigned int _x,
+            unsigned int _y )
+        {
+            sc_assert( ( _subject != nullptr ) && ( _x < m_width ) && ( _y < m_height ) );
+
+            m_vertices.push_back( VertexDesc{_id, std::string( ), 0, sc_core::SC_ZERO_TIME,
+                nullptr, &GraphBuilder::resolvePort< nodeTypeT >, _subject,
+                static_cast< int >( _y * m_width + _x ), 0} );
+            m_mapped = false;
+
+            return static_cast< unsigned int >( m_vertices.size( ) - 1 );
+        }
+
+        //! \brief capability classes offered by node (_x, _y) (default all)
+        void setCapabilities( unsigned int _x, unsigned int _y, capability_t _capabilities )
+        {
+            sc_assert( ( _x < m_width ) && ( _y < m_height ) );
+
+            m_nodeCapabilities[ _y * m_width + _x ] = _capabilities;
+            m_mapped = false;
+        }
+
+        //! \brief take the capability classes of all process units of _fabric
+        template < class unitT > void setCapabilities( const MeshFabric< unitT >& _fabric )
+        {
+            if ( ( _fabric.getWidth( ) != m_width ) || ( _fabric.getHeight( ) != m_height ) )
+                SC_REPORT_ERROR( "ColorMapper", "mesh size does not match mapping" );
+
+            for ( unsigned int y = 0; y < m_height; ++y )
+                for ( unsigned int x = 0; x < m_width; ++x )
+                    setCapabilities( x, y, _fabric.getUnit( x, y )->getCapabilities( ) );
+        }
+
+        //! \brief weight of load imbalance against hop weighted communication (default 1)
+        void setBalanceWeight( double _weight ) { m_balanceWeight = _weight; }
+
+        /***************************************************************/
+        // map
+        //!
+        //! \brief    assign every color cluster to a node
+        //!
+        //! \param [in] _edges CSR edge list over the vertex indices
+        /***************************************************************/
+        void map( const GraphBuilder::EdgeList& _edges );
+
+        /***************************************************************/
+        // build
+        //!
+        //! \brief    create all vertices at their nodes and wire all edges
+        //!
+        //! \param [in] _connector connector of the mesh with _width x _height nodes
+        //! \param [in] _edges CSR edge list over the vertex indices
+        //!
+        //! \details
+        //! map() is called first, if the vertex list changed since the last
+        //! mapping.
+        //!
+        //! \tparam unitT type of process unit of the mesh
+        /***************************************************************/
+        template < class unitT >
+        void build( PlacementConnector< unitT >& _connector, const GraphBuilder::EdgeList& _edges )
+        {
+            auto& fabric = _connector.getFabric( );
+
+            if ( ( fabric.getWidth( ) != m_width ) || ( fabric.getHeight( ) != m_height ) )
+                SC_REPORT_ERROR( "ColorMapper", "mesh size does not match mapping" );
+
+            if ( !m_mapped )
+                map( _edges );
+
+            for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+                {
+                    auto& vertex = m_vertices[ v ];
+                    auto node = getNodeOfVertex( v );
+                    auto x = node % m_width;
+                    auto y = node / m_width;
+
+                    if ( vertex.subject == nullptr )
+                        vertex.subject = vertex.factory( fabric.getUnit( x, y ), vertex.id,
+                            vertex.name, vertex.color, vertex.latency );
+
+                    _connector.place( vertex.id, x, y );
+                }
+
+            for ( unsigned int v = 0; v < m_vertices.size( ); ++v )
+                {
+                    const auto& producer = m_vertices[ v ];
+
+                    for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                        {
+                            const auto& consumer = m_vertices[ _edges.dst[ e ] ];
+                            auto obs = consumer.resolver( consumer.subject, _edges.dstPort[ e ] );
+
+                            if ( obs == nullptr )
+                                SC_REPORT_ERROR( consumer.subject->getName_Cstr( ),
+                                    "Observer not found." );
+
+                            _connector.connectObserver( producer.id, producer.subject,
+                                _edges.srcPort[ e ], consumer.id, obs );
+                        }
+                }
+        }
+
+    public:
+        //! \brief number of entries in vertex list
+        std::size_t getNumberOfVertices( void ) const { return m_vertices.size( ); }
+
+        //! \brief number of color clusters (valid after map)
+        std::size_t getNumberOfClusters( void ) const { return m_colors.size( ); }
+
+        //! \brief node index (y * width + x) of vertex index _vertex (valid after map)
+        unsigned int getNodeOfVertex( unsigned int _vertex ) const;
+
+        //! \brief load of vertex index _vertex (valid after map, 0 for external subjects)
+        double getLoadOfVertex( unsigned int _vertex ) const { return m_vertexLoad.at( _vertex ); }
+
+        //! \brief capability class needed by vertex index _vertex (0 for external subjects)
+        capability_t getRequiredCapabilities( unsigned int _vertex ) const
+        {
+            return m_vertices.at( _vertex ).capability;
+        }
+
+        //! \brief capability classes offered by node index _node
+        capability_t getNodeCapabilities( unsigned int _node ) const
+        {
+            return m_nodeCapabilities.at( _node );
+        }
+
+        //! \brief true if vertex index _vertex is an external subject at a fixed node
+        bool isFixed( unsigned int _vertex ) const
+        {
+            return 0 <= m_vertices.at( _vertex ).fixedNode;
+        }
+
+        /***************************************************************/
+        // setPlacement
+        //!
+        //! \brief    replace the cluster mapping by a node per vertex index
+        //!
+        //! \param [in] _nodeOfVertex node index per vertex index
+        //!
+        //! \details
+        //! Used to build an optimized placement, e.g. of a
+        //! PlacementOptimizer. External subjects have to keep their node.
+        //! The costs are computed from the placement, getNodeOfColor still
+        //! refers to map(). The next map() discards the placement.
+        /***************************************************************/
+        void setPlacement( const std::vector< unsigned int >& _nodeOfVertex );
+
+        //! \brief node index of color _color (valid after map)
+        unsigned int getNodeOfColor( unsigned int _color ) const;
+
+        //! \brief return subject of vertex index (nullptr before build)
+        Subject* getSubject( unsigned int _index ) const { return m_vertices.at( _index ).subject; }
+
+        //! \brief sum of edges between nodes times their hops (valid after map)
+        double getCommunicationCost( void ) const;
+
+        //! \brief imbalance of the node loads, see getLoadImbalance (valid after map)
+        double getImbalance( void ) const;
+
+        //! \brief mapping cost of communication and imbalance (valid after map)
+        double getCost( void ) const;
+
+        /***************************************************************/
+        // getUtilization
+        //!
+        //! \brief    utilization of the single capability class _class
+        //!
+        //! \return   double: load of the class per load the units offering
+        //!           it could execute until the most loaded node is ready
+        //!           (valid after map)
+        /***************************************************************/
+        double getUtilization( capability_t _class ) const;
+
+        //! \brief print vertices, load, units and utilization per capability class
+        void printUtilization( ::std::ostream& os = ::std::cout ) const;
+
+    private:
+        //! \brief collect clusters, their loads and the cluster graph
+        void buildClusterGraph( const GraphBuilder::EdgeList& _edges );
+
+        //! \brief map clusters _clusters onto the nodes of a rectangular region
+        void bisect( std::vector< unsigned int >& _clusters, unsigned int _x, unsigned int _y,
+            unsigned int _width, unsigned int _height );
+
+        //! \brief true if a node of the region offers all classes of _capabilities
+        bool isSupported( capability_t _capabilities, unsigned int _x, unsigned int _y,
+            unsigned int _width, unsigned int _height ) const;
+
+        //! \brief move single clusters to other nodes while the cost decreases
+        void refine( void );
+
+        //! \brief cost change if cluster _cluster moves to node _node
+        double getMoveGain( unsigned int _cluster, unsigned int _node ) const;
+
+        //! \brief load of every node by the cluster mapping or the placement
+        std::vector< double > getNodeLoads( void ) const;
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_width
+        //! \brief number of nodes in x direction
+        unsigned int m_width;
+        //! \var m_height
+        //! \brief number of nodes in y direction
+        unsigned int m_height;
+        //! \var m_vertices
+        //! \brief vertex list (index = vertex index)
+        std::vector< VertexDesc > m_vertices;
+        //! \var m_nodeCapabilities
+        //! \brief offered capability classes (index = node index)
+        std::vector< capability_t > m_nodeCapabilities;
+        //! \var m_balanceWeight
+        //! \brief weight of load imbalance
+        double m_balanceWeight = {1.0};
+        //! \var m_mapped
+        //! \brief true if the mapping belongs to the current vertex list
+        bool m_mapped = {false};
+        //! \var m_colors
+        //! \brief color of cluster (index = cluster index)
+        std::vector< unsigned int > m_colors;
+        //! \var m_clusterOf
+        //! \brief cluster of vertex (index = vertex index, -1 = external subject)
+        std::vector< int > m_clusterOf;
+        //! \var m_vertexLoad
+        //! \brief load of vertex (index = vertex index)
+        std::vector< double > m_vertexLoad;
+        //! \var m_vertexNode
+        //! \brief node of vertex set by setPlacement (empty = cluster mapping)
+        std::vector< unsigned int > m_vertexNode;
+        //! \var m_required
+        //! \brief needed capability classes of cluster (index = cluster index)
+        std::vector< capability_t > m_required;
+        //! \var m_load
+        //! \brief load of cluster (index = cluster index)
+        std::vector< double > m_load;
+        //! \var m_neighbours
+        //! \brief edges to other clusters: cluster index and number of edges
+        std::vector< std::vector< std::pair< unsigned int, double > > > m_neighbours;
+        //! \var m_terminals
+        //! \brief edges to external subjects: fixed node and number of edges
+        std::vector< std::vector< std::pair< unsigned int, double > > > m_terminals;
+        //! \var m_edges
+        //! \brief producer and consumer of every edge without self loop (for setPlacement)
+        std::vector< std::pair< unsigned int, unsigned int > > m_edges;
+        //! \var m_nodeOf
+        //! \brief node of cluster (index = cluster index)
+        std::vector< unsigned int > m_nodeOf;
+        //! \var m_nodeLoad
+        //! \brief load of node (index = node index)
+        std::vector< double > m_nodeLoad;
+        //! \var m_part
+        //! \brief side of cluster during bisection (-1 = not in current region)
+        std::vector< int > m_part;
+        //! \var m_totalLoad
+        //! \brief load of all clusters
+        double m_totalLoad = {0.0};
+        //! \var m_totalEdges
+        //! \brief number of edges without self loops, see getBalanceScale
+        double m_totalEdges = {0.0};
+        //! \var m_fixedCost
+        //! \brief hops of the edges between external subjects
+        double m_fixedCost = {0.0};
+    };
+}
+
+
+#endif // !COLORMAPPER_H_
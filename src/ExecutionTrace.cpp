@@ -0,0 +1,170 @@
+//! \file ExecutionTrace.cpp
+//! \brief Binary per-vertex execution trace in per process unit ring buffers
+
+#include "ExecutionTrace.h"
+
+#ifdef USE_EXECUTION_TRACE
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    /* TraceBuffer                                                          */
+    /************************************************************************/
+    TraceBuffer::TraceBuffer( unsigned int _capacityLog2 )
+        : m_writer( &TraceWriter::getInstance( ) ),
+          m_events( std::size_t( 1 ) << _capacityLog2 ),
+          m_mask( ( std::size_t( 1 ) << _capacityLog2 ) - 1 ),
+          m_head( 0 ),
+          m_tail( 0 ),
+          m_dropped( 0 )
+    {
+        sc_assert( ( 1 < _capacityLog2 ) && ( 32 > _capacityLog2 ) );
+
+        m_writer->registerBuffer( this );
+    }
+
+    TraceBuffer::~TraceBuffer( ) { m_writer->unregisterBuffer( this ); }
+
+    std::size_t TraceBuffer::pop( TraceEvent* _events, std::size_t _max )
+    {
+        auto tail = m_tail.load( std::memory_order_relaxed );
+        auto count = std::min( _max, m_head.load( std::memory_order_acquire ) - tail );
+
+        for ( std::size_t i = 0; i < count; ++i )
+            _events[ i ] = m_events[ ( tail + i ) & m_mask ];
+
+        m_tail.store( tail + count, std::memory_order_release );
+        return count;
+    }
+
+    void TraceBuffer::waitForWriter( void )
+    {
+        wakeUpWriter( );
+        std::this_thread::yield( );
+    }
+
+    void TraceBuffer::wakeUpWriter( void ) { m_writer->wakeUp( ); }
+
+    /************************************************************************/
+    /* TraceWriter                                                          */
+    /************************************************************************/
+    TraceWriter& TraceWriter::getInstance( void )
+    {
+        static TraceWriter writer;
+        return writer;
+    }
+
+    TraceWriter::~TraceWriter( ) { close( ); }
+
+    void TraceWriter::open( const std::string& _fileName )
+    {
+        close( );
+
+        std::lock_guard< std::mutex > lock( m_mutex );
+
+        m_file.open( _fileName, std::ios::binary | std::ios::trunc );
+        if ( !m_file )
+            SC_REPORT_ERROR( "TraceWriter", ( "cannot open trace file " + _fileName ).c_str( ) );
+
+        TraceFileHeader header;
+        std::memset( &header, 0, sizeof( header ) );
+        std::strncpy( header.magic, "VCTRACE", sizeof( header.magic ) );
+        header.version = 2;
+        header.recordSize = sizeof( TraceEvent );
+        header.resolution = sc_core::sc_get_time_resolution( ).to_seconds( );
+        m_file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+
+        m_running = true;
+        m_thread = std::thread( &TraceWriter::run, this );
+    }
+
+    void TraceWriter::flush( void )
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+
+        drain( );
+        m_file.flush( );
+    }
+
+    void TraceWriter::close( void )
+    {
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            m_running = false;
+        }
+        m_wakeUpCv.notify_one( );
+
+        if ( m_thread.joinable( ) )
+            m_thread.join( );
+
+        std::lock_guard< std::mutex > lock( m_mutex );
+
+        if ( m_file.is_open( ) )
+            {
+                drain( );
+                m_file.close( );
+            }
+    }
+
+    std::uint64_t TraceWriter::getNumberOfDropped( void )
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+
+        auto dropped = m_dropped;
+        for ( auto buffer : m_buffers )
+            dropped += buffer->getNumberOfDropped( );
+
+        return dropped;
+    }
+
+    void TraceWriter::registerBuffer( TraceBuffer* _buffer )
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_buffers.push_back( _buffer );
+    }
+
+    void TraceWriter::unregisterBuffer( TraceBuffer* _buffer )
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+
+        if ( m_file.is_open( ) )
+            drain( _buffer );
+
+        m_dropped += _buffer->getNumberOfDropped( );
+        m_buffers.erase(
+            std::remove( m_buffers.begin( ), m_buffers.end( ), _buffer ), m_buffers.end( ) );
+    }
+
+    void TraceWriter::run( void )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+
+        while ( m_running )
+            {
+                m_wakeUpCv.wait_for( lock, std::chrono::milliseconds( 10 ) );
+                drain( );
+            }
+    }
+
+    void TraceWriter::drain( void )
+    {
+        for ( auto buffer : m_buffers )
+            drain( buffer );
+    }
+
+    void TraceWriter::drain( TraceBuffer* _buffer )
+    {
+        TraceEvent chunk[ 256 ];
+        std::size_t count;
+
+        while ( 0 < ( count = _buffer->pop( chunk, 256 ) ) )
+            m_file.write( reinterpret_cast< const char* >( chunk ), count * sizeof( TraceEvent ) );
+    }
+}
+
+#endif // USE_EXECUTION_TRACE
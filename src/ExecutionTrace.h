@@ -0,0 +1,300 @@
+//! \file ExecutionTrace.h
+//! \brief Binary per-vertex execution trace in per process unit ring buffers
+
+#ifndef EXECUTIONTRACE_H_
+#define EXECUTIONTRACE_H_
+
+#include "Typedefinitions.h"
+#include <cstdint>
+
+namespace vc_utils
+{
+    /************************************************************************/
+    /* enumerations                                                         */
+    /************************************************************************/
+    //! \enum TRACE_EVENT
+    //! \brief Kind of a traced vertex event
+    enum TRACE_EVENT : std::uint8_t {
+        TRACE_READY = 0,      //!< \brief all input values joined
+        TRACE_START = 1,      //!< \brief process unit granted (m_coreFreeEv)
+        TRACE_FINISH = 2,     //!< \brief core released, recorded at START + latency
+        TRACE_THEN = 3,       //!< \brief IfVertex starts its then path
+        TRACE_ELSE = 4,       //!< \brief IfVertex starts its else path
+        TRACE_SEND_BEGIN = 5, //!< \brief outgoing socket granted to a transaction
+        TRACE_SEND_END = 6,   //!< \brief outgoing socket freed
+    };
+
+    //! \struct TraceEvent
+    //! \brief one fixed-size record of the binary trace file
+    struct TraceEvent
+    {
+        std::uint64_t time;          //!< \brief simulation time in time resolution units
+        std::uint64_t delta;         //!< \brief delta cycle count
+        std::uint32_t vertexId;      //!< \brief vertex number (socket id for TRACE_SEND_*)
+        std::uint16_t unitId;        //!< \brief process unit id (interconnect id for TRACE_SEND_*)
+        std::uint8_t kind;           //!< \brief TRACE_EVENT
+        std::uint8_t reserved;       //!< \brief 0
+        std::uint32_t transactionId; //!< \brief transaction of TRACE_SEND_* (0 otherwise)
+        std::uint32_t padding;       //!< \brief 0
+    };
+
+    //! \struct TraceFileHeader
+    //! \brief header of the binary trace file, followed by TraceEvent records
+    struct TraceFileHeader
+    {
+        char magic[ 8 ];          //!< \brief "VCTRACE" with terminating zero
+        std::uint32_t version;    //!< \brief format version (2)
+        std::uint32_t recordSize; //!< \brief sizeof( TraceEvent )
+        double resolution;        //!< \brief time resolution in seconds
+    };
+
+    static_assert( 32 == sizeof( TraceEvent ), "trace record has to be 32 bytes" );
+    static_assert( 24 == sizeof( TraceFileHeader ), "trace header has to be 24 bytes" );
+}
+
+#ifdef USE_EXECUTION_TRACE
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//! \brief record event _kind of vertex _vertexId at process unit _unit
+#define VC_TRACE_EVENT( _unit, _vertexId, _kind ) ( _unit )->traceEvent( ( _vertexId ), ( _kind ) )
+
+//! \brief record event _kind of outgoing socket _socketId of transaction _trans at
+//! interconnect _interconnect
+#define VC_TRACE_SEND( _interconnect, _socketId, _kind, _trans ) \
+    ( _interconnect )->traceEvent( ( _socketId ), ( _kind ), ( _trans ) )
+
+//! \brief record event _kind of vertex _vertexId at process unit _unit, _offset after now
+//! \details
+//! Used for TRACE_FINISH before ProcessUnit_Base::freeUsedCore, which returns
+//! at once if other vertices wait for the core.
+#define VC_TRACE_EVENT_AT( _unit, _vertexId, _kind, _offset ) \
+    ( _unit )->traceEvent( ( _vertexId ), ( _kind ), ( _offset ) )
+
+namespace vc_utils
+{
+    class TraceWriter;
+
+    /************************************************************************/
+    // TraceBuffer
+    //!
+    //! \class TraceBuffer
+    //!
+    //! \brief Ring buffer of trace events of one process unit
+    //!
+    //! \details
+    //! The simulation thread is the only producer, the background thread of
+    //! the TraceWriter the only consumer, so push and pop need no lock. If
+    //! the buffer is full, push wakes the writer and waits for free slots,
+    //! no event is lost while the writer runs. Events pushed while the writer
+    //! is not running (before TraceWriter::open or after close) are dropped
+    //! and counted. The buffer registers itself at the TraceWriter.
+    /************************************************************************/
+    class TraceBuffer
+    {
+    public:
+        //! \brief constructor with 2^_capacityLog2 slots
+        explicit TraceBuffer( unsigned int _capacityLog2 = 14 );
+
+        //! \brief destructor, remaining events are written
+        ~TraceBuffer( );
+
+    private:
+        // forbidden constructors
+        TraceBuffer( const TraceBuffer& _source ) = delete;         //!< \brief forbidden
+        TraceBuffer& operator=( const TraceBuffer& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        //! \brief append event (producer)
+        void push( const TraceEvent& _event );
+
+        //! \brief append event _kind of _id at _source, _offset after the current time
+        //! (producer)
+        void record( std::uint32_t _id, std::uint16_t _source, TRACE_EVENT _kind,
+            const sc_time_t& _offset = sc_core::SC_ZERO_TIME, std::uint32_t _transactionId = 0 )
+        {
+            push( TraceEvent{( sc_core::sc_time_stamp( ) + _offset ).value( ),
+                sc_core::sc_delta_count( ), _id, _source, _kind, 0, _transactionId, 0} );
+        }
+
+        //! \brief move up to _max events into _events (consumer)
+        std::size_t pop( TraceEvent* _events, std::size_t _max );
+
+        //! \brief number of events dropped while the writer was not running
+        std::uint64_t getNumberOfDropped( void ) const
+        {
+            return m_dropped.load( std::memory_order_relaxed );
+        }
+
+    private:
+        //! \brief wake the writer and yield while the buffer is full
+        void waitForWriter( void );
+
+        //! \brief wake the writer
+        void wakeUpWriter( void );
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_writer
+        //! \brief writer of the process
+        TraceWriter* m_writer;
+        //! \var m_events
+        //! \brief slots of the ring buffer
+        std::vector< TraceEvent > m_events;
+        //! \var m_mask
+        //! \brief number of slots - 1
+        std::size_t m_mask;
+        //! \var m_head
+        //! \brief number of pushed events
+        std::atomic< std::size_t > m_head;
+        //! \var m_tail
+        //! \brief number of popped events
+        std::atomic< std::size_t > m_tail;
+        //! \var m_dropped
+        //! \brief number of dropped events (written by the producer only)
+        std::atomic< std::uint64_t > m_dropped;
+    };
+
+    /************************************************************************/
+    // TraceWriter
+    //!
+    //! \class TraceWriter
+    //!
+    //! \brief Background thread writing all TraceBuffers to one file
+    //!
+    //! \details
+    //! The user starts the writer by open before the simulation starts; no
+    //! file is created and no thread runs otherwise. Every 10 ms or when a
+    //! buffer runs full, the thread moves the events of all buffers
+    //! into the file. Events are grouped per process unit and TRACE_FINISH is
+    //! recorded ahead of its time, so a reader sorts them by time and delta
+    //! cycle. Call flush after sc_start to get a complete file while the
+    //! simulation objects still exist.
+    /************************************************************************/
+    class TraceWriter
+    {
+    public:
+        //! \brief the writer of the process
+        static TraceWriter& getInstance( void );
+
+        //! \brief destructor, stops the thread and closes the file
+        ~TraceWriter( );
+
+    private:
+        //! \brief constructor
+        TraceWriter( ) = default;
+
+        // forbidden constructors
+        TraceWriter( const TraceWriter& _source ) = delete;         //!< \brief forbidden
+        TraceWriter& operator=( const TraceWriter& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        //! \brief write the trace to file _fileName and start the thread (before the
+        //! simulation starts)
+        void open( const std::string& _fileName );
+
+        //! \brief true between open and close
+        bool isRunning( void ) const { return m_running.load( std::memory_order_relaxed ); }
+
+        //! \brief number of events dropped by all buffers while the writer was not running
+        std::uint64_t getNumberOfDropped( void );
+
+        //! \brief write all buffered events and flush the file
+        void flush( void );
+
+        //! \brief stop the thread, write all buffered events and close the file
+        void close( void );
+
+        //! \brief add buffer of a process unit
+        void registerBuffer( TraceBuffer* _buffer );
+
+        //! \brief write remaining events of _buffer and remove it
+        void unregisterBuffer( TraceBuffer* _buffer );
+
+        //! \brief wake the background thread
+        void wakeUp( void ) { m_wakeUpCv.notify_one( ); }
+
+    private:
+        //! \brief background thread function
+        void run( void );
+
+        //! \brief move all events into the file (m_mutex locked)
+        void drain( void );
+
+        //! \brief drain the events of one buffer (m_mutex locked)
+        void drain( TraceBuffer* _buffer );
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_file
+        //! \brief binary trace file
+        std::ofstream m_file;
+        //! \var m_buffers
+        //! \brief registered buffers
+        std::vector< TraceBuffer* > m_buffers;
+        //! \var m_thread
+        //! \brief background writer
+        std::thread m_thread;
+        //! \var m_mutex
+        //! \brief protects file and buffer list
+        std::mutex m_mutex;
+        //! \var m_wakeUpCv
+        //! \brief wakes the background writer
+        std::condition_variable m_wakeUpCv;
+        //! \var m_running
+        //! \brief true while the background thread runs
+        std::atomic< bool > m_running = {false};
+        //! \var m_dropped
+        //! \brief dropped events of unregistered buffers
+        std::uint64_t m_dropped = {0};
+    };
+
+    /************************************************************************/
+    /* TraceBuffer inline methods                                           */
+    /************************************************************************/
+    inline void TraceBuffer::push( const TraceEvent& _event )
+    {
+        // no consumer, open was not called or the writer is closed
+        if ( !m_writer->isRunning( ) )
+            {
+                m_dropped.store(
+                    m_dropped.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+                return;
+            }
+
+        auto head = m_head.load( std::memory_order_relaxed );
+
+        while ( head - m_tail.load( std::memory_order_acquire ) > m_mask )
+            waitForWriter( );
+
+        m_events[ head & m_mask ] = _event;
+        m_head.store( head + 1, std::memory_order_release );
+
+        // wake the writer when half of the buffer is used
+        if ( ( head & ( m_mask >> 1 ) ) == ( m_mask >> 1 ) )
+            wakeUpWriter( );
+    }
+}
+
+#else
+
+//! \brief tracing disabled, arguments are not evaluated
+#define VC_TRACE_EVENT( _unit, _vertexId, _kind ) ( ( void )0 )
+//! \brief tracing disabled, arguments are not evaluated
+#define VC_TRACE_SEND( _interconnect, _socketId, _kind, _trans ) ( ( void )0 )
+//! \brief tracing disabled, arguments are not evaluated
+#define VC_TRACE_EVENT_AT( _unit, _vertexId, _kind, _offset ) ( ( void )0 )
+
+#endif // USE_EXECUTION_TRACE
+
+#endif // !EXECUTIONTRACE_H_
@@ -0,0 +1,210 @@
+//! \file FrameStreamer.h
+//! \brief Stream frames from disk through a task graph and write the results to disk
+
+#ifndef FRAMESTREAMER_H_
+#define FRAMESTREAMER_H_
+
+#include "Typedefinitions.h"
+#include "Memory.h"
+#include "StreamPager.h"
+#include <vector>
+#include <string>
+#include <cstring>
+#include <algorithm>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // FrameStreamer
+    //!
+    //! \class FrameStreamer
+    //!
+    //! \brief Out-of-core frame streaming through one task graph instance
+    //!
+    //! \details
+    //! The input file is a sequence of frames. Every frame holds one value of
+    //! type T for every id in the input id list (same order, no padding).
+    //! A trailing partial frame is reported as error by the StreamPager.
+    //! For every frame the values are copied into the Memory, the task graph is
+    //! restarted and, after all observed values are written, the values of the
+    //! output id list are appended to the output file as one frame of type O.
+    //!
+    //! The following input frames are read ahead by the StreamPager while the
+    //! current frame is simulated, and results are written back asynchronously.
+    //! Only numBuffers input and output frames are held in memory, so the
+    //! resident set does not grow with the length of the stream.
+    //!
+    //! \tparam T data type of input values
+    //! \tparam O data type of output values
+    /************************************************************************/
+    template < typename T, typename O = T > class FrameStreamer : public sc_core::sc_module
+    {
+    public:
+        SC_HAS_PROCESS( FrameStreamer );
+
+        /***************************************************************/
+        // constructor:
+        //!
+        //! \brief    constructor
+        //!
+        //! \param [in] _name sc_module name
+        //! \param [in] _memory Memory of the task graph instance
+        //! \param [in] _inputIds memory value ids filled from one input frame
+        //! \param [in] _outputIds observed memory value ids written to one output frame
+        //! \param [in] _inputPath file name of input frames
+        //! \param [in] _outputPath file name of output frames
+        //! \param [in] _numBuffers number of frames held in memory per direction
+        /***************************************************************/
+        explicit FrameStreamer( name_t _name, Memory* _memory,
+            const std::vector< unsigned int >& _inputIds,
+            const std::vector< unsigned int >& _outputIds, const std::string& _inputPath,
+            const std::string& _outputPath, unsigned int _numBuffers = 2 )
+            : sc_core::sc_module( _name ),
+              m_memory( _memory ),
+              m_inputIds( _inputIds ),
+              m_outputIds( _outputIds ),
+              m_inputPager( _inputPath, StreamPager::READ, _inputIds.size( ) * sizeof( T ),
+                  _numBuffers ),
+              m_outputPager( _outputPath, StreamPager::WRITE, _outputIds.size( ) * sizeof( O ),
+                  _numBuffers ),
+              m_numOfBuffers( _numBuffers > 0 ? _numBuffers : 1 ),
+              m_readAhead( m_numOfBuffers ),
+              m_finishedEv( ( std::string( _name ) + "_finishedEv" ).c_str( ) )
+        {
+            m_memory->setAutoStart( false );
+            m_memory->setDumpOutputs( false );
+
+            SC_THREAD( streamProcess );
+        }
+
+        //! \brief destructor
+        virtual ~FrameStreamer( ) = default;
+
+    private:
+        // forbidden constructors
+        FrameStreamer( ) = delete;                                      //!< \brief forbidden
+        FrameStreamer( const FrameStreamer& _source ) = delete;         //!< \brief forbidden
+        FrameStreamer( FrameStreamer&& _source ) = delete;              //!< \brief forbidden
+        FrameStreamer& operator=( const FrameStreamer& _rhs ) = delete; //!< \brief forbidden
+        FrameStreamer& operator=( FrameStreamer&& _rhs ) = delete;      //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // streamProcess
+        //!
+        //! \brief    simulate all frames of the input file
+        //!
+        //! \details
+        //! A frame slot of the input pager is refilled directly after its
+        //! values are copied into the Memory, so the read ahead distance can
+        //! be as large as the number of buffers.
+        /***************************************************************/
+        void streamProcess( void )
+        {
+            auto numOfFrames = m_inputPager.getNumberOfPages( );
+
+            // fill read ahead window
+            for ( std::size_t frame = 0; ( frame < numOfFrames ) && ( frame < m_readAhead );
+                  ++frame )
+                m_inputPager.prefetch( frame );
+
+            for ( std::size_t frame = 0; frame < numOfFrames; ++frame )
+                {
+                    loadFrame( m_inputPager.acquire( frame ) );
+                    m_inputPager.prefetch( frame + m_readAhead );
+
+                    m_memory->notifyAllInputValues( );
+                    sc_core::wait( m_memory->getOutputsWrittenEvent( ) );
+
+                    storeFrame( m_outputPager.getWriteBuffer( frame ) );
+                    m_outputPager.commit( frame );
+
+                    ++m_finishedFrames;
+                }
+
+            m_outputPager.flush( );
+            m_finishedEv.notify( sc_core::SC_ZERO_TIME );
+        }
+
+    public:
+        /************************************************************************/
+        // getter and setter
+        /************************************************************************/
+        //! \brief number of frames in input file
+        std::size_t getNumberOfFrames( void ) const { return m_inputPager.getNumberOfPages( ); }
+
+        //! \brief number of frames written to output file
+        std::size_t getNumberOfFinishedFrames( void ) const { return m_finishedFrames; }
+
+        //! \brief event notified after the last frame is written
+        const event_t& getFinishedEvent( void ) const { return m_finishedEv; }
+
+        //! \brief set number of frames read ahead (limited to the number of buffers)
+        void setReadAhead( unsigned int _frames )
+        {
+            m_readAhead = std::max( 1u, std::min( _frames, m_numOfBuffers ) );
+        }
+
+        //! \brief return kind of SystemC module as string
+        virtual const char* kind( ) const override { return "FrameStreamer"; }
+
+    private:
+        //! \brief copy values of an input frame into memory
+        void loadFrame( dataPtr_t _frame )
+        {
+            T value;
+
+            for ( std::size_t i = 0; i < m_inputIds.size( ); ++i )
+                {
+                    std::memcpy( &value, _frame + i * sizeof( T ), sizeof( T ) );
+                    m_memory->changeMemoryValue( value, m_inputIds[ i ] );
+                }
+        }
+
+        //! \brief copy observed memory values into an output frame
+        void storeFrame( dataPtr_t _frame )
+        {
+            for ( std::size_t i = 0; i < m_outputIds.size( ); ++i )
+                {
+                    const O& value = m_memory->getOutputValue< O >( m_outputIds[ i ] );
+                    std::memcpy( _frame + i * sizeof( O ), &value, sizeof( O ) );
+                }
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_memory
+        //! \brief Memory of the task graph instance
+        Memory* m_memory;
+        //! \var m_inputIds
+        //! \brief memory value ids filled from one input frame
+        std::vector< unsigned int > m_inputIds;
+        //! \var m_outputIds
+        //! \brief observed memory value ids written to one output frame
+        std::vector< unsigned int > m_outputIds;
+        //! \var m_inputPager
+        //! \brief read ahead of input frames
+        StreamPager m_inputPager;
+        //! \var m_outputPager
+        //! \brief write back of output frames
+        StreamPager m_outputPager;
+        //! \var m_numOfBuffers
+        //! \brief number of frames held in memory per direction
+        unsigned int m_numOfBuffers;
+        //! \var m_readAhead
+        //! \brief number of frames read ahead
+        unsigned int m_readAhead;
+        //! \var m_finishedFrames
+        //! \brief number of written output frames
+        std::size_t m_finishedFrames = {0};
+        //! \var m_finishedEv
+        //! \brief notified after the last frame is written
+        event_t m_finishedEv;
+    };
+}
+
+
+#endif // !FRAMESTREAMER_H_
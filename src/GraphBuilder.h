@@ -0,0 +1,346 @@
+//! \file GraphBuilder.h
+//! \brief Bulk construction of a task graph from a vertex list and a CSR edge list
+
+#ifndef GRAPHBUILDER_H_
+#define GRAPHBUILDER_H_
+
+#include "Typedefinitions.h"
+#include "Subject.h"
+#include "Task_Base.h"
+#include "ProcessUnit_Base.h"
+#include <vector>
+#include <string>
+#include <algorithm>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // GraphBuilder
+    //!
+    //! \class GraphBuilder
+    //!
+    //! \brief Bulk construction of a task graph
+    //!
+    //! \details
+    //! The builder collects a list of vertices and wires a complete edge list
+    //! in one pass. Vertices are addressed by their position in the vertex
+    //! list (vertex index), not by their vertex id.
+    //!
+    //! The edges are given in compressed sparse row (CSR) form: the outgoing
+    //! edges of vertex index v are the entries [rowPtr[v], rowPtr[v+1]) of the
+    //! arrays srcPort (output value id at v), dst (vertex index of the
+    //! consumer) and dstPort (Observer id at the consumer).
+    //!
+    //! Every vertex stores a type-erased port resolver that returns the
+    //! Observer of a consumer port, so the edge list does not need the
+    //! concrete consumer types like ProcessUnit_Base::connect.
+    //! Before wiring, the vertex tables of the process units and the Observer
+    //! arrays of all producers are sized once from the vertex counts and
+    //! the out degrees, and Observers are appended without the duplicate
+    //! search of Subject::registerObserver. Elaboration is linear in the
+    //! number of vertices and edges.
+    //!
+    //! \attention
+    //! The edge list has to be free of duplicates (same src, srcPort, dst and
+    //! dstPort), because they are not detected.
+    //!
+    //! \code
+    //! GraphBuilder builder;
+    //! builder.reserve( 3 );
+    //! auto a = builder.addSubject< Memory >( &memory );
+    //! auto b = builder.addVertex< AddVertex<> >( &unit, 1, "add", 0, latency );
+    //! auto c = builder.addVertex< MulVertex<> >( &unit, 2, "mul", 0, latency );
+    //! builder.build( GraphBuilder::EdgeList::fromEdges( builder.getNumberOfVertices( ),
+    //!     { { a, 0, b, 0 }, { a, 1, b, 1 }, { b, 0, c, 0 }, { a, 2, c, 1 }, { c, 0, a, 0 } } ) );
+    //! \endcode
+    /************************************************************************/
+    class GraphBuilder
+    {
+    public:
+        /************************************************************************/
+        /* type definitions                                                     */
+        /************************************************************************/
+        //! \typedef portResolver_t
+        //! \brief return Observer with id of a consumer or nullptr
+        typedef Observer* ( *portResolver_t )( Subject*, unsigned int );
+        //! \typedef vertexFactory_t
+        //! \brief create vertex at its process unit and return it
+        typedef Subject* ( *vertexFactory_t )( ProcessUnit_Base*, unsigned int,
+            const std::string&, unsigned int, const sc_time_t& );
+
+        /************************************************************************/
+        /* vertex factories (also used by ColorMapper)                          */
+        /************************************************************************/
+        //! \brief type-erased vertex creation
+        template < class vertexT >
+        static Subject* createVertex( ProcessUnit_Base* _unit, unsigned int _id,
+            const std::string& _name, unsigned int _color, const sc_time_t& _latency )
+        {
+            _unit->addVertex< vertexT >( _id, _name, _color, _latency );
+            return _unit->getVertex( _id );
+        }
+
+        //! \brief type-erased port resolution
+        template < class nodeTypeT >
+        static Observer* resolvePort( Subject* _obs, unsigned int _port )
+        {
+            return static_cast< nodeTypeT* >( _obs )->inputObs.getObserver( _port );
+        }
+
+        //! \struct Edge
+        //! \brief one edge by vertex indices and ports (used to generate CSR)
+        struct Edge
+        {
+            unsigned int src;     //!< \brief vertex index of producer
+            unsigned int srcPort; //!< \brief output value id of producer
+            unsigned int dst;     //!< \brief vertex index of consumer
+            unsigned int dstPort; //!< \brief Observer id of consumer
+        };
+
+        /************************************************************************/
+        // EdgeList
+        //! \brief edge list in compressed sparse row form
+        /************************************************************************/
+        struct EdgeList
+        {
+            std::vector< unsigned int > rowPtr;  //!< \brief first edge per vertex index (+ end)
+            std::vector< unsigned int > srcPort; //!< \brief output value id per edge
+            std::vector< unsigned int > dst;     //!< \brief consumer vertex index per edge
+            std::vector< unsigned int > dstPort; //!< \brief consumer Observer id per edge
+
+            //! \brief number of edges
+            std::size_t size( void ) const { return dst.size( ); }
+
+            /***************************************************************/
+            // fromEdges
+            //!
+            //! \brief    sort edges by producer into CSR form (counting sort)
+            //!
+            //! \param [in] _numOfVertices number of vertex indices
+            //! \param [in] _edges unordered edges
+            //! \return   EdgeList: CSR form, edges of a producer keep their order
+            /***************************************************************/
+            static EdgeList fromEdges(
+                std::size_t _numOfVertices, const std::vector< Edge >& _edges )
+            {
+                EdgeList csr;
+                csr.rowPtr.assign( _numOfVertices + 1, 0 );
+                csr.srcPort.resize( _edges.size( ) );
+                csr.dst.resize( _edges.size( ) );
+                csr.dstPort.resize( _edges.size( ) );
+
+                for ( const auto& e : _edges )
+                    {
+                        if ( e.src >= _numOfVertices )
+                            SC_REPORT_ERROR( "GraphBuilder", "edge producer out of range" );
+                        ++csr.rowPtr[ e.src + 1 ];
+                    }
+
+                for ( std::size_t v = 0; v < _numOfVertices; ++v )
+                    csr.rowPtr[ v + 1 ] += csr.rowPtr[ v ];
+
+                std::vector< unsigned int > fill( csr.rowPtr.begin( ), csr.rowPtr.end( ) - 1 );
+
+                for ( const auto& e : _edges )
+                    {
+                        auto pos = fill[ e.src ]++;
+                        csr.srcPort[ pos ] = e.srcPort;
+                        csr.dst[ pos ] = e.dst;
+                        csr.dstPort[ pos ] = e.dstPort;
+                    }
+
+                return csr;
+            }
+        };
+
+    private:
+        //! \struct VertexDesc
+        //! \brief description of one vertex of the vertex list
+        struct VertexDesc
+        {
+            ProcessUnit_Base* unit;  //!< \brief owner (nullptr for external subjects)
+            unsigned int id;         //!< \brief vertex id
+            std::string name;        //!< \brief sc_module name
+            unsigned int color;      //!< \brief clustering color
+            sc_time_t latency;       //!< \brief process latency
+            vertexFactory_t factory; //!< \brief creates vertex (nullptr for external subjects)
+            portResolver_t resolver; //!< \brief returns Observer of consumer port
+            Subject* subject;        //!< \brief created or external subject
+        };
+
+    public:
+        /************************************************************************/
+        /* constructor                                                          */
+        /************************************************************************/
+        //! \brief constructor
+        GraphBuilder( ) = default;
+
+        //! \brief destructor (vertices are owned by their process units)
+        ~GraphBuilder( ) = default;
+
+    private:
+        // forbidden constructors
+        GraphBuilder( const GraphBuilder& _source ) = delete;         //!< \brief forbidden
+        GraphBuilder& operator=( const GraphBuilder& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        //! \brief reserve space for _numOfVertices entries of the vertex list
+        void reserve( std::size_t _numOfVertices ) { m_vertices.reserve( _numOfVertices ); }
+
+        /***************************************************************/
+        // addVertex
+        //!
+        //! \brief    append task graph vertex to vertex list
+        //!
+        //! \param [in] _unit owner of the vertex
+        //! \param [in] _id vertex id (unique at _unit)
+        //! \param [in] _name sc_module name
+        //! \param [in] _color clustering color
+        //! \param [in] _latency process latency
+        //! \return   unsigned int: vertex index used in the edge list
+        //!
+        //! \details
+        //! The vertex is created by ProcessUnit_Base::addVertex during build.
+        //!
+        //! \tparam vertexT type of vertex (derived from Task_Base)
+        /***************************************************************/
+        template < class vertexT >
+        unsigned int addVertex( ProcessUnit_Base* _unit, unsigned int _id, std::string _name,
+            unsigned int _color, const sc_time_t& _latency )
+        {
+            sc_assert( _unit != nullptr );
+
+            m_vertices.push_back( VertexDesc{_unit, _id, std::move( _name ), _color, _latency,
+                &createVertex< vertexT >, &resolvePort< Task_Base >, nullptr} );
+
+            return static_cast< unsigned int >( m_vertices.size( ) - 1 );
+        }
+
+        /***************************************************************/
+        // addSubject
+        //!
+        //! \brief    append an existing subject (e.g. Memory) to vertex list
+        //!
+        //! \param [in] _subject existing producer and/or consumer
+        //! \return   unsigned int: vertex index used in the edge list
+        //!
+        //! \tparam nodeTypeT type of _subject that includes an ObserverManager inputObs
+        /***************************************************************/
+        template < class nodeTypeT > unsigned int addSubject( Subject* _subject )
+        {
+            sc_assert( _subject != nullptr );
+
+            m_vertices.push_back( VertexDesc{nullptr, 0, std::string( ), 0, sc_core::SC_ZERO_TIME,
+                nullptr, &resolvePort< nodeTypeT >, _subject} );
+
+            return static_cast< unsigned int >( m_vertices.size( ) - 1 );
+        }
+
+        /***************************************************************/
+        // build
+        //!
+        //! \brief    create all vertices and wire all edges
+        //!
+        //! \param [in] _edges CSR edge list over the vertex indices
+        /***************************************************************/
+        void build( const EdgeList& _edges )
+        {
+            checkEdgeList( _edges );
+            createVertices( );
+
+            // size Observer arrays by out degree
+            for ( std::size_t v = 0; v < m_vertices.size( ); ++v )
+                m_vertices[ v ].subject->reserveObservers(
+                    _edges.rowPtr[ v + 1 ] - _edges.rowPtr[ v ] );
+
+            // wire
+            for ( std::size_t v = 0; v < m_vertices.size( ); ++v )
+                {
+                    auto producer = m_vertices[ v ].subject;
+
+                    for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                        {
+                            const auto& consumer = m_vertices[ _edges.dst[ e ] ];
+                            auto obs = consumer.resolver( consumer.subject, _edges.dstPort[ e ] );
+
+                            if ( obs == nullptr )
+                                SC_REPORT_ERROR( consumer.subject->getName_Cstr( ),
+                                    "Observer not found." );
+
+                            producer->appendObserver( obs, _edges.srcPort[ e ] );
+                        }
+                }
+        }
+
+    public:
+        //! \brief number of entries in vertex list
+        std::size_t getNumberOfVertices( void ) const { return m_vertices.size( ); }
+
+        //! \brief return subject of vertex index (nullptr before build)
+        Subject* getSubject( unsigned int _index ) const { return m_vertices.at( _index ).subject; }
+
+    private:
+        //! \brief create vertices at their process units, tables sized by vertex count
+        void createVertices( void )
+        {
+            // number of vertices per process unit
+            std::vector< std::pair< ProcessUnit_Base*, std::size_t > > counts;
+
+            for ( const auto& v : m_vertices )
+                {
+                    if ( ( v.factory == nullptr ) || ( v.subject != nullptr ) )
+                        continue;
+
+                    // vertex lists are usually grouped by unit, check last unit first
+                    auto it = ( !counts.empty( ) && counts.back( ).first == v.unit )
+                        ? counts.end( ) - 1
+                        : std::find_if( counts.begin( ), counts.end( ),
+                              [&v]( const std::pair< ProcessUnit_Base*, std::size_t >& _c ) {
+                                  return _c.first == v.unit;
+                              } );
+
+                    if ( it == counts.end( ) )
+                        counts.emplace_back( v.unit, 1 );
+                    else
+                        ++it->second;
+                }
+
+            for ( const auto& c : counts )
+                c.first->reserveVertices( c.second );
+
+            for ( auto& v : m_vertices )
+                {
+                    if ( ( v.factory != nullptr ) && ( v.subject == nullptr ) )
+                        v.subject = v.factory( v.unit, v.id, v.name, v.color, v.latency );
+                }
+        }
+
+        //! \brief check structure of CSR edge list against vertex list
+        void checkEdgeList( const EdgeList& _edges ) const
+        {
+            if ( _edges.rowPtr.size( ) != m_vertices.size( ) + 1 )
+                SC_REPORT_ERROR( "GraphBuilder", "row pointer size does not match vertex list" );
+
+            if ( ( _edges.srcPort.size( ) != _edges.size( ) ) ||
+                 ( _edges.dstPort.size( ) != _edges.size( ) ) ||
+                 ( _edges.rowPtr.back( ) != _edges.size( ) ) )
+                SC_REPORT_ERROR( "GraphBuilder", "inconsistent edge list" );
+
+            for ( auto d : _edges.dst )
+                {
+                    if ( d >= m_vertices.size( ) )
+                        SC_REPORT_ERROR( "GraphBuilder", "edge consumer out of range" );
+                }
+        }
+
+    private:
+        /************************************************************************/
+        /* member                                                               */
+        /************************************************************************/
+        std::vector< VertexDesc > m_vertices; //!< \brief vertex list (index = vertex index)
+    };
+}
+
+
+#endif // !GRAPHBUILDER_H_
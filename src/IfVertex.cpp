@@ -128,6 +128,7 @@ namespace vc_utils
         while (true)
         {
             sc_core::wait(m_ifBeginEvAndList);
+            VC_TRACE_EVENT(m_ProcessUnit, this->getVertexNumber(), TRACE_READY);
 
             // If data is not change in one of the paths, the reference to this
             // value is copied for access by if-node successors.
@@ -138,11 +139,13 @@ namespace vc_utils
             // check which path has to be performed
             if (m_condition)
             {
+                VC_TRACE_EVENT(m_ProcessUnit, this->getVertexNumber(), TRACE_THEN);
                 for (auto valueId : m_thenNodes)
                     m_thenPath.notifyObservers(valueId);
             }
             else
             {
+                VC_TRACE_EVENT(m_ProcessUnit, this->getVertexNumber(), TRACE_ELSE);
                 for (auto valueId : m_elseNodes)
                     m_elsePath.notifyObservers(valueId);
             }
@@ -154,6 +157,7 @@ namespace vc_utils
         while (true)
         {
             sc_core::wait(m_ifEndFromThenEvAndList);
+            VC_TRACE_EVENT(m_ProcessUnit, this->getVertexNumber(), TRACE_FINISH);
 
             for (auto valueId = 0u; valueId < m_ifBeginDataVec.size(); ++valueId)
                 this->notifyObservers(valueId);
@@ -165,6 +169,7 @@ namespace vc_utils
         while (true)
         {
             sc_core::wait(m_ifEndFromElseEvAndList);
+            VC_TRACE_EVENT(m_ProcessUnit, this->getVertexNumber(), TRACE_FINISH);
 
             for (auto valueId = 0u; valueId < m_ifBeginDataVec.size(); ++valueId)
                 this->notifyObservers(valueId);
@@ -6,6 +6,8 @@
 
 #include "Hierarchical_Task.h"
 #include "ObserverManager.h"
+#include "VertexTable.h"
+#include "ProcessUnit_Base.h"
 #include <vector>
 #include <utility>
 #include <set>
@@ -43,8 +45,8 @@ namespace vc_utils
         //! \brief stores begin of data and the data size in bytes
         typedef std::vector< std::pair< dataPtr_t, unsigned int > > dataVec_t;
         //! \typedef vertices_t
-        //! \brief stores initialized vertices
-        typedef std::map< unsigned int, Subject* > vertices_t;
+        //! \brief stores and owns initialized vertices
+        typedef VertexTable vertices_t;
 
     private:
         /************************************************************************/
@@ -103,11 +105,11 @@ namespace vc_utils
             //! \param [in] _latency process latency of the task graph vertex
             //!
             //! \details
-            //! This function adds a vertex into the vertex map of the current then path.
+            //! This function adds a vertex into the vertex table of the current then path.
             //! The vertex type is described by the template parameter vertexT.
-            //! The data field is a map, so the vertex number has to be unique because it is
-            //! used as the key of the map. If a vertex with _id already exists, the
-            //! program ends with an error.
+            //! The vertex number has to be unique because it is used as index of the
+            //! vertex table. If a vertex with _id already exists, the program ends
+            //! with an error.
             //!
             //! \tparam  vertexT type of generated vertex
             //!
@@ -118,10 +120,11 @@ namespace vc_utils
             void addVertex( unsigned int _id, ProcessUnit_Base* _pUnit, const std::string _name,
                 unsigned int _color, const sc_time_t _latency )
             {
+                auto latency = _pUnit->template admitVertex< vertexT >( _latency );
                 auto tmp = m_vertices.emplace(
-                    _id, new vertexT( _pUnit, _name.c_str( ), _id, _color, _latency ) );
+                    _id, new vertexT( _pUnit, _name.c_str( ), _id, _color, latency ) );
 
-                if ( !tmp.second )
+                if ( !tmp )
                     SC_REPORT_ERROR( this->getName_Cstr( ),
                         "The vertex with given id already exits. Vertex is not emplaced." );
             }
@@ -139,11 +142,11 @@ namespace vc_utils
             //! \param [in] _latency process latency of the task graph vertex
             //!
             //! \details
-            //! This function adds a vertex into the vertex map of the current
+            //! This function adds a vertex into the vertex table of the current
             //! if-then-path.
             //! The vertex is described by the template parameter vertexT.
-            //! The data field is a map, so the vertex number has to be unique because it
-            //! is used as the key of the map.
+            //! The vertex number has to be unique because it is used as index of the
+            //! vertex table.
             //!
             //! \tparam  vertexT type of generated vertex.
             //!
@@ -155,9 +158,14 @@ namespace vc_utils
                 unsigned int _vertexColor, sc_time_t _latency, unsigned int _numOfInEdges,
                 Subject* const _condition )
             {
+                auto latency = _unit->template admitVertex< vertexT >( _latency );
                 auto tmp = m_vertices.emplace(
-                    _vertexNumber, new vertexT( _name, _unit, _vertexColor, _vertexNumber, _latency,
+                    _vertexNumber, new vertexT( _name, _unit, _vertexColor, _vertexNumber, latency,
                                        _numOfInEdges, _condition ) );
+
+                if ( !tmp )
+                    SC_REPORT_ERROR( this->getName_Cstr( ),
+                        "The vertex with given id already exits. Vertex is not emplaced." );
             }
 
         public:
@@ -183,7 +191,7 @@ namespace vc_utils
             template < class nodeTypeT >
             void connect( Subject* _sub, Subject* _obs, unsigned int _obsId, unsigned int _valId )
             {
-                auto tmpObs = static_cast< nodeTypeT* > _obs->inputObs.getObserver( _obsId );
+                auto tmpObs = static_cast< nodeTypeT* >( _obs )->inputObs.getObserver( _obsId );
 
                 if ( tmpObs != nullptr )
                     {
@@ -282,11 +290,11 @@ namespace vc_utils
             //! \param [in] _latency process latency of the task graph vertex
             //!
             //! \details
-            //! This function adds a vertex into the vertex map of the current else path.
+            //! This function adds a vertex into the vertex table of the current else path.
             //! The vertex type is described by the template parameter vertexT.
-            //! The data field is a map, so the vertex number has to be unique because it is
-            //! used as the key of the map. If a vertex with _id already exists, the
-            //! program ends with an error.
+            //! The vertex number has to be unique because it is used as index of the
+            //! vertex table. If a vertex with _id already exists, the program ends
+            //! with an error.
             //!
             //! \tparam  vertexT type of generated vertex
             //!
@@ -297,10 +305,11 @@ namespace vc_utils
             void addVertex( unsigned int _id, ProcessUnit_Base* _pUnit, const std::string _name,
                 unsigned int _color, const sc_time_t _latency )
             {
+                auto latency = _pUnit->template admitVertex< vertexT >( _latency );
                 auto tmp = m_vertices.emplace(
-                    _id, new vertexT( _pUnit, _name.c_str( ), _id, _color, _latency ) );
+                    _id, new vertexT( _pUnit, _name.c_str( ), _id, _color, latency ) );
 
-                if ( !tmp.second )
+                if ( !tmp )
                     SC_REPORT_ERROR( this->getName_Cstr( ),
                         "The vertex with given id already exits. Vertex is not emplaced." );
             }
@@ -318,11 +327,11 @@ namespace vc_utils
             //! \param [in] _latency process latency of the task graph vertex
             //!
             //! \details
-            //! This function adds a vertex into the vertex map of the current
+            //! This function adds a vertex into the vertex table of the current
             //! if-then-path.
             //! The vertex is described by the template parameter vertexT.
-            //! The data field is a map, so the vertex number has to be unique because it
-            //! is used as the key of the map.
+            //! The vertex number has to be unique because it is used as index of the
+            //! vertex table.
             //!
             //! \tparam  vertexT type of generated vertex.
             //!
@@ -334,9 +343,14 @@ namespace vc_utils
                 unsigned int _vertexColor, sc_time_t _latency, unsigned int _numOfInEdges,
                 Subject* const _condition )
             {
+                auto latency = _unit->template admitVertex< vertexT >( _latency );
                 auto tmp = m_vertices.emplace(
-                    _vertexNumber, new vertexT( _name, _unit, _vertexColor, _vertexNumber, _latency,
+                    _vertexNumber, new vertexT( _name, _unit, _vertexColor, _vertexNumber, latency,
                                        _numOfInEdges, _condition ) );
+
+                if ( !tmp )
+                    SC_REPORT_ERROR( this->getName_Cstr( ),
+                        "The vertex with given id already exits. Vertex is not emplaced." );
             }
 
 
@@ -363,7 +377,7 @@ namespace vc_utils
             template < class nodeTypeT >
             void connect( Subject* _sub, Subject* _obs, unsigned int _obsId, unsigned int _valId )
             {
-                auto tmpObs = static_cast< nodeTypeT* > _obs->inputObs.getObserver( _obsId );
+                auto tmpObs = static_cast< nodeTypeT* >( _obs )->inputObs.getObserver( _obsId );
 
                 if ( tmpObs != nullptr )
                     {
@@ -760,7 +774,7 @@ namespace vc_utils
             Subject* const _condition )
         {
             m_elsePath.addIfVertex(
-                _vertexNumber, _name, m_ProcessUnit, _vertexColor _latency, _numOfInEdges, _condition );
+                _vertexNumber, _name, m_ProcessUnit, _vertexColor, _latency, _numOfInEdges, _condition );
 
             // count number of vertices
             m_numberOfNodes++;
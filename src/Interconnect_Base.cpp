@@ -1,4 +1,6 @@
 #include "Interconnect_Base.h"
+#include "RouteTable.h"
+#include <algorithm>
 
 const int vc_utils::TARGET = -1;
 
@@ -16,6 +18,8 @@ bool vc_utils::SocketManager::freeSocketForNextJob( )
         {
             m_socketFreeJobQueue.front( )->notify( sc_core::SC_ZERO_TIME );
             m_socketFreeJobQueue.pop_front( );
+            m_statistics.recordGrant( sc_core::sc_time_stamp( ) - m_requestTimes.front( ) );
+            m_requestTimes.pop_front( );
             return true;
         }
 }
@@ -32,14 +36,62 @@ vc_utils::Interconnect_Base::Interconnect_Base( std::string _name, unsigned int
       m_observedValTargetVec( _numOfObs ),
       m_outSocketFlags( _numOfOutSockets ),
       m_currentTObjPtr( nullptr ),
-      m_transmissionDataVec( nullptr ),
+      m_transmissionData( nullptr ),
+      m_numOfTransmissionData( 0 ),
       m_requestDelay( _reqDelay ),
       m_responseDelay( _respDelay ),
       m_commDelay( _commDelay ),
       m_routingLatency( _routingLatency ),
       m_payloads( _name + "_MemoryManager" ),
-      m_style( _style )
+      m_style( _style ),
+      m_linkWidth( 0 ),
+      m_flitSize( 0 ),
+      m_pipelineDepth( 0 )
 {
+#ifdef USE_EXECUTION_TRACE
+    static std::uint16_t numOfTraced = 0;
+    m_traceId = numOfTraced++;
+#endif
+}
+
+
+void vc_utils::Interconnect_Base::setLinkParameters( const sc_time_t& _clockPeriod,
+    unsigned int _linkWidth, unsigned int _flitSize, unsigned int _pipelineDepth )
+{
+    m_clockPeriod = _clockPeriod;
+    m_linkWidth = _linkWidth;
+    m_flitSize = _flitSize;
+    m_pipelineDepth = _pipelineDepth;
+    m_pipelineDelay = m_clockPeriod * static_cast< double >( _pipelineDepth );
+}
+
+
+unsigned int vc_utils::Interconnect_Base::getNumberOfFlits( unsigned int _numOfBytes ) const
+{
+    if ( 0 == m_flitSize )
+        return 1;
+
+    // at least one (header) flit
+    return std::max( 1u, ( _numOfBytes + m_flitSize - 1 ) / m_flitSize );
+}
+
+
+vc_utils::sc_time_t vc_utils::Interconnect_Base::getSerializationDelay(
+    const trans_t& _trans ) const
+{
+    if ( 0 == m_linkWidth )
+        return sc_core::SC_ZERO_TIME;
+
+    auto numOfBytes = _trans.get_data_length( );
+    unsigned int cycles = 0;
+
+    if ( 0 == m_flitSize )
+        cycles = ( numOfBytes + m_linkWidth - 1 ) / m_linkWidth;
+    else
+        cycles = getNumberOfFlits( numOfBytes ) *
+                 ( ( m_flitSize + m_linkWidth - 1 ) / m_linkWidth );
+
+    return m_clockPeriod * static_cast< double >( cycles );
 }
 
 
@@ -58,24 +110,29 @@ bool vc_utils::Interconnect_Base::requestForOutSocket( event_t& _event, const in
         }
 }
 
-const vc_utils::TransmissionData vc_utils::Interconnect_Base::getTransmissionData(
-    unsigned int _obsId ) const
+void vc_utils::Interconnect_Base::recordDelivery( trans_t& _trans, const sc_time_t& _latency )
 {
-    if ( m_transmissionDataVec->size( ) < _obsId )
-        SC_REPORT_ERROR(
-            "TransmissionDataVec", "no valid observer address for transmission data set." );
+    auto ext = _trans.get_extension< RoutingExt >( );
 
-    return m_transmissionDataVec->at(_obsId);
+    if ( ext != nullptr )
+        m_statistics.recordDelivery( ext->getNumberOfHops( ),
+            sc_core::sc_time_stamp( ) + _latency - ext->getInjectionTime( ), ext->getLatencies( ) );
+}
+
+void vc_utils::Interconnect_Base::setRouteCache( const RouteCache& _cache, unsigned int _node )
+{
+    m_transmissionData = _cache.getRoutes( _node );
+    m_numOfTransmissionData = _cache.getNumberOfRoutes( _node );
 }
 
 int vc_utils::Interconnect_Base::packTransactionObject(
     trans_t* _tObjPtr, const unsigned int _obsId )
 {
-    if ( m_transmissionDataVec == nullptr )
+    if ( m_transmissionData == nullptr )
         SC_REPORT_ERROR( this->getName_Cstr( ), "transmission data vector not initialized" );
 
     // look for transaction data
-    auto transmissionParameter = getTransmissionData( _obsId );
+    const auto& transmissionParameter = getTransmissionData( _obsId );
     auto dataParameter = m_observedValTargetVec[ _obsId ];
 
     // past values into
@@ -103,22 +160,24 @@ bool vc_utils::Interconnect_Base::checkForValidDataPackage( trans_t* _tObjPtr )
 {
     auto dataLength = _tObjPtr->get_data_length( );
     auto byteEnablePtr = _tObjPtr->get_byte_enable_ptr( );
-    // auto byteLength = _tObjPtr->get_byte_enable_length();
+    auto byteLength = _tObjPtr->get_byte_enable_length( );
     // auto addr = _tObjPtr->get_address();
     // auto command = _tObjPtr->get_command();
     auto streamingWidth = _tObjPtr->get_streaming_width( );
 
-    if ( dataLength > streamingWidth )
+    // streaming: every beat of streamingWidth bytes is written to the same value
+    if ( ( 0 == streamingWidth ) || ( 0 != ( dataLength % streamingWidth ) ) )
         {
-            SC_REPORT_INFO( this->getName_Cstr( ), "streaming with not implemented" );
-            _tObjPtr->set_response_status( tlm::TLM_GENERIC_ERROR_RESPONSE );
+            SC_REPORT_INFO(
+                this->getName_Cstr( ), "data length is no multiple of streaming width" );
+            _tObjPtr->set_response_status( tlm::TLM_BURST_ERROR_RESPONSE );
             return false;
         }
 
 
-    if ( byteEnablePtr != NULL )
+    if ( ( byteEnablePtr != NULL ) && ( 0 == byteLength ) )
         {
-            SC_REPORT_INFO( this->getName_Cstr( ), "byte enable not implemented" );
+            SC_REPORT_INFO( this->getName_Cstr( ), "byte enable without length" );
             _tObjPtr->set_response_status( tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE );
             return false;
         }
@@ -7,10 +7,14 @@
 #include "Typedefinitions.h"
 #include "Subject.h"
 #include "PayloadManager.h"
+#include "ExecutionTrace.h"
+#include "Statistics.h"
 #include <vector>
+#include <deque>
 
 namespace vc_utils
 {
+    class RouteCache;
 
     /************************************************************************/
     /* enumerations                                                         */
@@ -125,10 +129,13 @@ namespace vc_utils
     //! \brief Control outgoing data streams at a specific outgoing socket.
     //!
     //! \details
-    //! A outgoing socket can only handle on connection at the same time. Therefor
-    //! the manager serialize parallel connection requests and store them in a FIFO.
-    //! If the socket is free, the transmission process starts at the same simulation.
-    //! If not, the transmission process is suspended at notified from the SocketManager.
+    //! A outgoing socket can only handle a limited number of outstanding
+    //! transactions at the same time (default one). Therefor the manager
+    //! serialize further connection requests and store them in a FIFO.
+    //! If the socket has a free slot, the transmission process starts at the same
+    //! simulation time. If not, the transmission process is suspended and notified
+    //! from the SocketManager if a slot is freed.
+    //! The manager counts busy and contention time in its SocketStatistics.
     //!
     //! \author Andre Werner
     //! \date Juno 2015
@@ -139,33 +146,55 @@ namespace vc_utils
 
     public:
         //!< \brief constructor
-        SocketManager( ) : m_socketUsed( false ) {}
+        SocketManager( ) : m_outstanding( 0 ), m_maxOutstanding( 1 ) {}
 
         //!< \brief destructor
         ~SocketManager( ) = default;
 
-        //! \brief    check if socket is in use
+        //! \brief    check if all slots of the socket are in use
         //!
         //! \return   true = socket used
-        inline bool isSocketUsed( ) { return m_socketUsed; }
+        inline bool isSocketUsed( ) { return m_outstanding >= m_maxOutstanding; }
 
-        //! \brief    set socket as used
-        inline void setSocketAsUsed( ) { m_socketUsed = true; }
+        //! \brief    occupy one slot of the socket
+        inline void setSocketAsUsed( )
+        {
+            if ( 0 == m_outstanding++ )
+                m_statistics.startBusy( );
+            m_statistics.recordGrant( sc_core::SC_ZERO_TIME );
+        }
+
+        //! \brief    free one slot of the socket
+        inline void setSocketAsFree( )
+        {
+            if ( ( 0 < m_outstanding ) && ( 0 == --m_outstanding ) )
+                m_statistics.stopBusy( );
+        }
+
+        //! \brief    set number of outstanding transactions (at least one)
+        inline void setMaxOutstanding( unsigned int _depth )
+        {
+            m_maxOutstanding = ( 0 < _depth ) ? _depth : 1;
+        }
+
+        //! \brief    return number of outstanding transactions
+        inline unsigned int getNumberOfOutstanding( ) const { return m_outstanding; }
 
-        //! \brief    set socket as free
-        inline void setSocketAsFree( ) { m_socketUsed = false; }
+        //! \brief    return maximal number of outstanding transactions
+        inline unsigned int getMaxOutstanding( ) const { return m_maxOutstanding; }
 
 
         /**********************************************************************/
         // freeSocketForNextJob
         //!
-        //! \brief    notify next element in socket waiting queue or set socket as free
+        //! \brief    pass a freed slot to the next element in socket waiting queue or free it
         //!
         //! \return   true = next job, false = job queue empty
         //!
         //! \details
         //! Delta notification is used so next communication sequence at outgoing socket
-        //! starts at the same simulation time.
+        //! starts at the same simulation time. The slot is handed over, so the
+        //! number of outstanding transactions does not change.
         //!
         //! \author Andre Werner
         //!
@@ -177,6 +206,16 @@ namespace vc_utils
         inline void pushBackSyncFreeSocketEv( event_t* _event )
         {
             m_socketFreeJobQueue.push_back( _event );
+            m_requestTimes.push_back( sc_core::sc_time_stamp( ) );
+        }
+
+        //! \brief    busy and contention counters of the socket
+        inline const SocketStatistics& getStatistics( ) const { return m_statistics; }
+
+        //! \brief    busy time of the socket up to now
+        inline sc_time_t getBusyTime( ) const
+        {
+            return m_statistics.getBusyTime( 0 < m_outstanding );
         }
 
 
@@ -184,8 +223,15 @@ namespace vc_utils
         //! \var m_socketFreeJobQueue
         //! \brief Stores events for notification waiting communication process
         std::deque< event_t* > m_socketFreeJobQueue;
+        //! \var m_requestTimes
+        //! \brief time of the request of every entry of m_socketFreeJobQueue
+        std::deque< sc_time_t > m_requestTimes;
+        //! \var m_statistics
+        //! \brief busy and contention counters
+        SocketStatistics m_statistics;
 
-        bool m_socketUsed; //!< \brief marks a socket as free (false) or used (true)
+        unsigned int m_outstanding;    //!< \brief number of occupied slots
+        unsigned int m_maxOutstanding; //!< \brief number of slots (outstanding depth)
 
     private:
         // forbidden constructors:
@@ -196,6 +242,95 @@ namespace vc_utils
     };
 
 
+    /**********************************************************************/
+    // CreditCounter
+    //!
+    //! \class CreditCounter
+    //!
+    //! \brief Credits of an outgoing socket for the input buffer of its neighbour
+    //!
+    //! \details
+    //! The depth is the number of transactions the input buffer of the
+    //! receiving socket can hold. The sender consumes one credit per
+    //! transaction and the receiver gives it back, when the transaction
+    //! leaves its input buffer. A sender without credit waits for the credit
+    //! event; the waiting time is accounted as stall.
+    //! A depth of zero means an unlimited input buffer (no flow control).
+    /***********************************************************************/
+    struct CreditCounter
+    {
+    public:
+        //!< \brief constructor
+        CreditCounter( ) : m_credits( 0 ), m_depth( 0 ), m_numOfStalls( 0 ) {}
+
+        //!< \brief destructor
+        ~CreditCounter( ) = default;
+
+        //! \brief    set input buffer depth of receiver, all credits are available
+        inline void setDepth( unsigned int _depth )
+        {
+            m_depth = _depth;
+            m_credits = _depth;
+        }
+
+        //! \brief    return input buffer depth of receiver
+        inline unsigned int getDepth( ) const { return m_depth; }
+
+        //! \brief    return number of available credits
+        inline unsigned int getCredits( ) const { return m_credits; }
+
+        //! \brief    true if a transaction could be sent
+        inline bool hasCredit( ) const { return ( 0 == m_depth ) || ( 0 < m_credits ); }
+
+        //! \brief    take one credit for a sent transaction
+        inline void consume( )
+        {
+            if ( 0 < m_depth )
+                --m_credits;
+        }
+
+        //! \brief    give one credit back, waiting senders are notified in the next delta
+        inline void giveBack( )
+        {
+            if ( ( 0 < m_depth ) && ( m_credits < m_depth ) )
+                {
+                    ++m_credits;
+                    m_creditEv.notify( sc_core::SC_ZERO_TIME );
+                }
+        }
+
+        //! \brief    event notified if a credit is given back
+        inline event_t& getCreditEvent( ) { return m_creditEv; }
+
+        //! \brief    account time a sender waited for a credit
+        inline void addStall( const sc_time_t& _time )
+        {
+            m_stallTime += _time;
+            ++m_numOfStalls;
+        }
+
+        //! \brief    return accumulated time senders waited for credits
+        inline const sc_time_t& getStallTime( ) const { return m_stallTime; }
+
+        //! \brief    return number of sends which waited for a credit
+        inline unsigned long getNumberOfStalls( ) const { return m_numOfStalls; }
+
+    private:
+        event_t m_creditEv;          //!< \brief notified if a credit is given back
+        unsigned int m_credits;      //!< \brief available credits
+        unsigned int m_depth;        //!< \brief input buffer depth of receiver
+        sc_time_t m_stallTime;       //!< \brief time senders waited for credits
+        unsigned long m_numOfStalls; //!< \brief number of sends which waited for credits
+
+    private:
+        // forbidden constructors:
+        CreditCounter( const CreditCounter& _rhs ) = delete;            //!< \brief forbidden
+        CreditCounter& operator=( const CreditCounter& _rhs ) = delete; //!< \brief forbidden
+        CreditCounter( CreditCounter&& _rhs ) = delete;                 //!< \brief forbidden
+        CreditCounter& operator=( CreditCounter&& _rhs ) = delete;      //!< \brief forbidden
+    };
+
+
     /************************************************************************/
     /* class description of Interconnect                                    */
     /************************************************************************/
@@ -205,8 +340,11 @@ namespace vc_utils
         /* type definitions                                                     */
         /************************************************************************/
         //! \typedef obsSendDataVec
-        //! \brief vector to save transaction informations for data and data length
-        typedef std::vector< std::pair< dataPtr_t, unsigned int > > obsSendDataVec;
+        //! \brief data field to save transaction informations for data and data length
+        //! \details
+        //! A deque is used, because ObserverInterconnect objects keep the address
+        //! of their entry while further outgoing values are added.
+        typedef std::deque< std::pair< dataPtr_t, unsigned int > > obsSendDataVec;
 
     protected:
         explicit Interconnect_Base( std::string _name, unsigned int _numOfOutSockets,
@@ -231,11 +369,18 @@ namespace vc_utils
         //! This is because process units at the borders of a network on chip
         //! will have other communication parameters then that in the middle.
         //! The addressing parameters depend on the simulated network.
+        //! The vector must not change afterwards.
         inline void setTransactionDataVec( const std::vector< TransmissionData >& _transData )
         {
-            m_transmissionDataVec = &_transData;
+            m_transmissionData = _transData.data( );
+            m_numOfTransmissionData = static_cast< unsigned int >( _transData.size( ) );
         }
 
+        //! \brief set access to transmission data sets of _node in a generated route cache
+        //! \details
+        //! The cache must live as long as the interconnect sends values.
+        void setRouteCache( const RouteCache& _cache, unsigned int _node );
+
         //! \brief set access to socket id informations depending on process unit
         //! \details
         //! This is because on some networks every processing unit could have their own
@@ -246,6 +391,68 @@ namespace vc_utils
 
         }
 
+        //! \brief set number of outstanding transactions per outgoing socket
+        //! \details
+        //! A depth larger than one pipelines a link. Depth one serializes all
+        //! transactions of a socket.
+        inline void setOutstandingDepth( unsigned int _depth )
+        {
+            for ( auto& socket : m_outSocketFlags )
+                socket.setMaxOutstanding( _depth );
+        }
+
+        /***************************************************************/
+        // setLinkParameters
+        //!
+        //! \brief    set parameters of the data size dependent latency
+        //!
+        //! \param [in] _clockPeriod clock period of links and router pipeline
+        //! \param [in] _linkWidth bytes transferred per cycle (0 = size independent latency)
+        //! \param [in] _flitSize bytes per flit (0 = no flits, payload sent as one unit)
+        //! \param [in] _pipelineDepth router pipeline stages per hop
+        //!
+        //! \details
+        //! A payload is split into flits of _flitSize bytes, the last flit is
+        //! padded. Every flit occupies the link for ceil(_flitSize /
+        //! _linkWidth) cycles. This serialization delay is added to the
+        //! communication delay (LT) and to the request delay (AT), so it
+        //! delays the forwarding of the payload at every hop and not only
+        //! the next request of the link. The pipeline stages add cycles to
+        //! the routing latency of every hop.
+        /***************************************************************/
+        void setLinkParameters( const sc_time_t& _clockPeriod, unsigned int _linkWidth,
+            unsigned int _flitSize = 0, unsigned int _pipelineDepth = 0 );
+
+        //! \brief return bytes transferred per link cycle (0 = size independent latency)
+        inline unsigned int getLinkWidth( ) const { return m_linkWidth; }
+
+        //! \brief return bytes per flit (0 = no flits)
+        inline unsigned int getFlitSize( ) const { return m_flitSize; }
+
+        //! \brief return number of router pipeline stages
+        inline unsigned int getPipelineDepth( ) const { return m_pipelineDepth; }
+
+        //! \brief return number of flits of a payload with _numOfBytes bytes
+        unsigned int getNumberOfFlits( unsigned int _numOfBytes ) const;
+
+        //! \brief return time _trans occupies a link
+        sc_time_t getSerializationDelay( const trans_t& _trans ) const;
+
+        //! \brief return number of outgoing sockets
+        inline unsigned int getNumberOfOutSockets( ) const
+        {
+            return static_cast< unsigned int >( m_outSocketFlags.size( ) );
+        }
+
+        //! \brief return manager (busy and contention counters) of outgoing socket _socketId
+        inline const SocketManager& getOutSocket( unsigned int _socketId ) const
+        {
+            return m_outSocketFlags[ _socketId ];
+        }
+
+        //! \brief return latency and hop count statistics of the delivered transactions
+        inline const InterconnectStatistics& getStatistics( ) const { return m_statistics; }
+
         /***************************************************************/
         // notifyObservers
         //!
@@ -320,7 +527,14 @@ namespace vc_utils
         //!
         //! \version 2015-6-6: initial
         /***********************************************************************/
-        const TransmissionData getTransmissionData( unsigned int _obsId ) const;
+        inline const TransmissionData& getTransmissionData( unsigned int _obsId ) const
+        {
+            if ( m_numOfTransmissionData <= _obsId )
+                SC_REPORT_ERROR(
+                    "TransmissionDataVec", "no valid observer address for transmission data set." );
+
+            return m_transmissionData[ _obsId ];
+        }
 
 
         /***************************************************************/
@@ -372,12 +586,47 @@ namespace vc_utils
         //! Not all transaction parameters are used and implemented.
         //! This methods checks for valid parameters and set the error option
         //! as status if necessary.
+        //! A streaming width smaller than the data length is valid if the
+        //! data length is a multiple of it (several beats to one value id).
+        //! Byte enables are valid if their length is not zero.
         //!
         //!	\author   	Andre Werner
         //!	\version  	2015-6-6 : initial
         /***************************************************************/
         bool checkForValidDataPackage( trans_t* _tObjPtr );
 
+        //! \brief communication delay of a hop with _trans in LT style
+        inline sc_time_t getLinkDelay( const trans_t& _trans ) const
+        {
+            return m_commDelay + getSerializationDelay( _trans );
+        }
+
+        //! \brief request delay (receive time) of a hop with _trans in AT style
+        inline sc_time_t getRequestDelay( const trans_t& _trans ) const
+        {
+            return m_requestDelay + getSerializationDelay( _trans );
+        }
+
+        //! \brief routing latency including router pipeline
+        inline sc_time_t getRoutingDelay( ) const { return m_routingLatency + m_pipelineDelay; }
+
+        //! \brief add hops and latency parts of _trans delivered after _latency to the statistics
+        void recordDelivery( trans_t& _trans, const sc_time_t& _latency );
+
+#ifdef USE_EXECUTION_TRACE
+    public:
+        //! \brief record event _kind of outgoing socket _socketId for _trans now
+        //! (use VC_TRACE_SEND)
+        void traceEvent( unsigned int _socketId, TRACE_EVENT _kind, trans_t& _trans )
+        {
+            m_trace.record( _socketId, m_traceId, _kind, sc_core::SC_ZERO_TIME,
+                _trans.get_extension< RoutingExt >( )->getTransactionId( ) );
+        }
+
+        //! \brief id of the interconnect in the trace (construction order)
+        std::uint16_t getTraceId( ) const { return m_traceId; }
+#endif
+
         /************************************************************************/
         // member
         /************************************************************************/
@@ -388,6 +637,12 @@ namespace vc_utils
         sc_time_t m_routingLatency; //!< \brief  latency for routing tasks
         PayloadManager m_payloads;  //!< \brief  payload object factors
         TLMCOMMSTILE m_style;       //!< \brief choose tlm communication style for interconnect
+        sc_time_t m_clockPeriod;    //!< \brief  clock period of links and router pipeline
+        sc_time_t m_pipelineDelay;  //!< \brief  latency of router pipeline stages
+
+        unsigned int m_linkWidth;     //!< \brief  bytes per link cycle (0 = size independent)
+        unsigned int m_flitSize;      //!< \brief  bytes per flit (0 = no flits)
+        unsigned int m_pipelineDepth; //!< \brief  number of router pipeline stages
 
         //! \var m_outSocketFlags
         //! \brief array of outgoing socket management flags (outgoing socket ID is index)
@@ -409,10 +664,25 @@ namespace vc_utils
         //! \brief Socket identification numbers for routing
         const SocketIdData* m_socketId;
 
+        //! \var m_statistics
+        //! \brief latency and hop count of delivered transactions
+        InterconnectStatistics m_statistics;
+
     private:
-        //! \var m_transmissionDataVec
-        //! \brief access to transmission data vector of process unit
-        const std::vector< TransmissionData >* m_transmissionDataVec;
+        //! \var m_transmissionData
+        //! \brief access to transmission data sets of process unit (index = Observer id)
+        const TransmissionData* m_transmissionData;
+        //! \var m_numOfTransmissionData
+        //! \brief number of transmission data sets
+        unsigned int m_numOfTransmissionData;
+#ifdef USE_EXECUTION_TRACE
+        //! \var m_trace
+        //! \brief buffer of socket trace events
+        TraceBuffer m_trace;
+        //! \var m_traceId
+        //! \brief id of the interconnect in the trace
+        std::uint16_t m_traceId;
+#endif
     };
 }
 
@@ -1,19 +1,71 @@
 #include "Memory.h"
 
 
+namespace
+{
+    //! \brief print all elements of a region separated by blanks
+    template <typename T>
+    void dumpElements(std::ostream& _os, const vc_utils::MemoryValueBase& _region)
+    {
+        auto elements = static_cast<const T*>(_region.getData());
+
+        for (unsigned int i = 0; i < _region.m_numOfElements; ++i)
+            _os << elements[i] << " ";
+
+        _os << std::endl;
+    }
+}
+
 void vc_utils::Memory::notifyObservers(unsigned int _outValueId)
 {
-    sc_assert(m_valueInfoMap.count(_outValueId));
+    auto info = m_valueInfoMap.find(_outValueId);
+    sc_assert(info != m_valueInfoMap.end());
 
     for (auto obs : this->m_observerVec)
     {
         if (obs.second == _outValueId)
+        {
+            obs.first->notify(sc_core::SC_ZERO_TIME, info->second.first, info->second.second);
+        }
+
+    }
+
+    // element wise wired consumers of a region
+    auto region = m_regionObserverMap.find(_outValueId);
+
+    if (region != m_regionObserverMap.end())
+    {
+        auto elementLength = info->second.second / m_MemoryValueMap[_outValueId]->m_numOfElements;
+
+        for (auto& obs : region->second)
         {
             obs.first->notify(sc_core::SC_ZERO_TIME,
-                m_valueInfoMap[_outValueId].first, m_valueInfoMap[_outValueId].second);
+                info->second.first + obs.second * elementLength, elementLength);
         }
+    }
+}
+
+void vc_utils::Memory::registerRegionElementObserver(unsigned int _regionId, unsigned int _element, Observer* _obs)
+{
+    auto region = m_MemoryValueMap.find(_regionId);
 
+    if ((region == m_MemoryValueMap.end()) || (region->second->m_numOfElements <= _element))
+    {
+        SC_REPORT_ERROR(this->getName_Cstr(), "region element not found at memory");
+        return;
     }
+
+    m_regionObserverMap[_regionId].emplace_back(_obs, _element);
+}
+
+vc_utils::Observer* vc_utils::Memory::getRegionElementObserver(unsigned int _regionId, unsigned int _element)
+{
+    auto region = m_regionElementObsMap.find(_regionId);
+
+    if ((region == m_regionElementObsMap.end()) || (region->second.size() <= _element))
+        return nullptr;
+
+    return region->second[_element].get();
 }
 
 void vc_utils::Memory::notifyForGeneratedOutPix(void)
@@ -29,14 +81,19 @@ void vc_utils::Memory::notifyForGeneratedOutPix(void)
         sc_core::wait(m_outPixEvAndList);
 
         // the simple memory generates an output at the std output:
-        cout << "@ " << setw(5) << sc_core::sc_time_stamp();
-        cout << " | delta cycle: " << setw(5) << sc_core::sc_delta_count() << std::endl;
-        cout << "Written values from ";
-        this->dump();
-        cout << endl;
-        cout << "values: ";
-        dumpOutPixel();
+        if (m_dumpOutputs)
+        {
+            cout << "@ " << setw(5) << sc_core::sc_time_stamp();
+            cout << " | delta cycle: " << setw(5) << sc_core::sc_delta_count() << std::endl;
+            cout << "Written values from ";
+            this->dump();
+            cout << endl;
+            cout << "values: ";
+            dumpOutPixel();
+        }
 
+        // all results of this iteration are available
+        m_outputsWrittenEv.notify(sc_core::SC_ZERO_TIME);
     }
 
     return;
@@ -44,7 +101,15 @@ void vc_utils::Memory::notifyForGeneratedOutPix(void)
 
 void vc_utils::Memory::NotifyAllCurrentValues(void)
 {
-    for (auto key : m_valueInfoMap)
+    if (m_autoStart)
+        notifyAllInputValues();
+
+    return;
+}
+
+void vc_utils::Memory::notifyAllInputValues(void)
+{
+    for (auto& key : m_valueInfoMap)
         this->notifyObservers(key.first);
 
     return;
@@ -56,90 +121,97 @@ void vc_utils::Memory::dumpOutPixel(std::ostream& _os /*= ::std::cout*/) const
     {
         _os << out.second.get()->m_name << ": " <<"pixel value " << out.first << ":\t";
 
+        if (out.second->m_numOfElements > 1)
+        {
+            dumpRegion(_os, *out.second);
+            continue;
+        }
+
+        // a value or a region of one element, both are read by getData
         switch (out.second->m_dataType)
         {
         case TYPE::CHAR:
         {
-            auto valuePtr = static_cast<MemoryValue<char>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const char*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::SIGNED_CHAR:
         {
-            auto valuePtr = static_cast<MemoryValue<signed char>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const signed char*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::UNSIGNED_CHAR:
         {
-            auto valuePtr = static_cast<MemoryValue<unsigned char>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const unsigned char*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::SHORT:
         {
-            auto valuePtr = static_cast<MemoryValue<short>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const short*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::UNSIGNED_SHORT:
         {
-            auto valuePtr = static_cast<MemoryValue<unsigned short>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const unsigned short*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::INT:
         {
-            auto valuePtr = static_cast<MemoryValue<int>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const int*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::UNSIGNED_INT:
         {
-            auto valuePtr = static_cast<MemoryValue<unsigned int>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const unsigned int*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::LONG:
         {
-            auto valuePtr = static_cast<MemoryValue<long>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const long*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::UNSIGNED_LONG:
         {
-            auto valuePtr = static_cast<MemoryValue<unsigned long>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const unsigned long*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::LONG_LONG:
         {
-            auto valuePtr = static_cast<MemoryValue<long long>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const long long*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::UNSIGNED_LONG_LONG:
         {
-            auto valuePtr = static_cast<MemoryValue<unsigned long long>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const unsigned long long*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::DOUBLE:
         {
-            auto valuePtr = static_cast<MemoryValue<double>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const double*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::LONG_DOUBLE:
         {
-            auto valuePtr = static_cast<MemoryValue<long double>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const long double*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         case TYPE::FLOAT:
         {
-            auto valuePtr = static_cast<MemoryValue<float>*>(m_outputValueMap.at(out.second->m_valueId).get());
-            _os << valuePtr->m_value << std::endl;
+            auto valuePtr = static_cast<const float*>(out.second->getData());
+            _os << *valuePtr << std::endl;
             break;
         }
         default:
@@ -150,3 +222,29 @@ void vc_utils::Memory::dumpOutPixel(std::ostream& _os /*= ::std::cout*/) const
 
     return;
 }
+
+void vc_utils::Memory::dumpRegion(std::ostream& _os, const MemoryValueBase& _region) const
+{
+    switch (_region.m_dataType)
+    {
+    case TYPE::CHAR: dumpElements<char>(_os, _region); break;
+    case TYPE::SIGNED_CHAR: dumpElements<signed char>(_os, _region); break;
+    case TYPE::UNSIGNED_CHAR: dumpElements<unsigned char>(_os, _region); break;
+    case TYPE::SHORT: dumpElements<short>(_os, _region); break;
+    case TYPE::UNSIGNED_SHORT: dumpElements<unsigned short>(_os, _region); break;
+    case TYPE::INT: dumpElements<int>(_os, _region); break;
+    case TYPE::UNSIGNED_INT: dumpElements<unsigned int>(_os, _region); break;
+    case TYPE::LONG: dumpElements<long>(_os, _region); break;
+    case TYPE::UNSIGNED_LONG: dumpElements<unsigned long>(_os, _region); break;
+    case TYPE::LONG_LONG: dumpElements<long long>(_os, _region); break;
+    case TYPE::UNSIGNED_LONG_LONG: dumpElements<unsigned long long>(_os, _region); break;
+    case TYPE::DOUBLE: dumpElements<double>(_os, _region); break;
+    case TYPE::LONG_DOUBLE: dumpElements<long double>(_os, _region); break;
+    case TYPE::FLOAT: dumpElements<float>(_os, _region); break;
+    default:
+        SC_REPORT_ERROR(this->getName_Cstr(), "no valid data type found");
+        break;
+    };
+
+    return;
+}
@@ -8,8 +8,10 @@
 #include "Typedefinitions.h"
 #include "Subject.h"
 #include "ObserverManager.h"
+#include "ObserverRegion.h"
 #include <map>
 #include <array>
+#include <vector>
 #include <utility>
 #include <memory>
 
@@ -38,16 +40,23 @@ namespace vc_utils
 	//! \brief base class to save arbitrary values at memory
 	struct MemoryValueBase
 	{
-		MemoryValueBase(std::string _name, unsigned int _valueId, unsigned int _length, TYPE _datatype)
-			: m_valueId(_valueId), m_length(_length), m_dataType(_datatype), m_name(_name) {}
+		MemoryValueBase(std::string _name, unsigned int _valueId, unsigned int _length, TYPE _datatype,
+			unsigned int _numOfElements = 1)
+			: m_valueId(_valueId), m_length(_length), m_dataType(_datatype), m_name(_name),
+			m_numOfElements(_numOfElements) {}
 
 		virtual ~MemoryValueBase() = default;
 
+		//! \brief return address of first element
+		virtual const void* getData() const = 0;
+
 	public:
 		TYPE m_dataType;
         std::string m_name;
 		unsigned int m_valueId;
 		unsigned int m_length;
+		//! \brief number of elements of a region (one for scalar values)
+		unsigned int m_numOfElements;
 	};
 
 
@@ -62,7 +71,7 @@ namespace vc_utils
 	public:
 		//! \typedef value_type
 		//! \brief value type of specific value
-		typedef typename T value_type;
+		typedef T value_type;
 
 	public:
 		//! \brief constructor
@@ -77,12 +86,53 @@ namespace vc_utils
 		//! \brief destructor
 		virtual ~MemoryValue() = default;
 
+		//! \brief return address of value
+		virtual const void* getData() const override { return &m_value; }
+
 	public:
 		//! \brief specific value
 		T m_value;
 	};
 
 
+	//! \struct MemoryRegion
+	//! \brief region of N values, published and observed as one unit
+	//! \Tparam T data type of the elements
+	//! \Tparam N number of elements
+	//! \details
+	//! The whole region is one memory value with one value id. Its data length
+	//! is the size of all elements. Single elements can be wired to consumers
+	//! by their index.
+	template <typename T, std::size_t N>
+	struct MemoryRegion : public MemoryValueBase
+	{
+	public:
+		//! \typedef value_type
+		//! \brief element type of region
+		typedef T value_type;
+
+	public:
+		//! \brief constructor
+		MemoryRegion(const std::array<T, N>& _values, std::string _name, unsigned int _valueId, TYPE _dataType) :
+			MemoryValueBase(_name, _valueId, sizeof(T) * N, _dataType, N),
+			m_value(_values)
+		{}
+
+		//! \brief empty regions are forbidden
+		MemoryRegion() = delete;
+
+		//! \brief destructor
+		virtual ~MemoryRegion() = default;
+
+		//! \brief return address of first element
+		virtual const void* getData() const override { return m_value.data(); }
+
+	public:
+		//! \brief specific values
+		std::array<T, N> m_value;
+	};
+
+
 	class Memory : public Subject, public sc_core::sc_module
 	{
 	public:
@@ -95,7 +145,8 @@ namespace vc_utils
 		SC_HAS_PROCESS(Memory);
 		Memory(name_t _name)
 			: sc_core::sc_module(_name),
-			Subject(std::string(_name))
+			Subject(std::string(_name)),
+			m_outputsWrittenEv((std::string(_name) + "_outputsWrittenEv").c_str())
 		{
 
 			// generate static simulation thread
@@ -302,6 +353,135 @@ namespace vc_utils
 		}
 
 
+		/************************************************************************/
+		// addMemoryRegion
+		//!
+		//! \brief add a region of values which is published as one unit
+		//!
+		//!	\param [in] _values	initial values of all elements
+		//! \param [in] _name	name of region
+		//! \param [in] _id	value identification number of region
+		//! \param [in] _dataType	memory data type of the elements
+		//! \param [in] _observed	region stores algorithm results
+		//!
+		//! \details
+		//! A not observed region is notified by one call of notifyObservers.
+		//! Observers registered for the region id get all elements, observers
+		//! registered by registerRegionElementObserver get their element only.
+		//!
+		//! An observed region has one event for all elements. Producers are
+		//! connected to the whole region (Observer id by operator[]) or to one
+		//! element (getRegionElementObserver). The event is notified after all
+		//! elements are written.
+		//!
+		//! \Tparam T data type of the elements
+		//! \Tparam N number of elements
+		/************************************************************************/
+		template <typename T, std::size_t N>
+		void addMemoryRegion(const std::array<T, N>& _values, std::string _name, unsigned int _id, TYPE _dataType, bool _observed = false)
+		{
+			auto tmpRegion = new MemoryRegion<T, N>(_values, _name, _id, _dataType);
+
+			//save data pointer to first element and data length of all elements
+			auto dataPtr = reinterpret_cast<vc_utils::dataPtr_t>(tmpRegion->m_value.data());
+			unsigned int length = tmpRegion->m_length;
+
+			if (_observed)
+			{
+				// one event for the whole region
+				this->m_putPixelEv.emplace_back(std::unique_ptr<event_t>(new event_t((this->getName() + "_obsRegionEvent_" + std::to_string(_id)).c_str())));
+				auto regionEv = m_putPixelEv.back().get();
+				m_outPixEvAndList &= *regionEv;
+				auto obsId = this->inputObs.addObserver(regionEv, dataPtr, length);
+				m_observerIdmap.insert(std::make_pair(_id, obsId));
+
+				// element observers share the region event by a join
+				m_regionJoins.emplace_back(new RegionJoin(regionEv, N));
+				auto& elementObs = m_regionElementObsMap[_id];
+				elementObs.reserve(N);
+				for (unsigned int i = 0; i < N; ++i)
+				{
+					elementObs.emplace_back(new ObserverRegion(m_regionJoins.back().get(), i,
+						dataPtr + i * sizeof(T), sizeof(T)));
+				}
+
+				m_outputValueMap.insert(std::make_pair(_id, std::unique_ptr<MemoryValueBase>(tmpRegion)));
+			}
+			else
+			{
+				//value id at memory has to be unique!
+				auto retVal = m_valueInfoMap.insert(std::make_pair(_id, std::make_pair(dataPtr, length)));
+
+				if (!retVal.second)
+					SC_REPORT_ERROR(this->getName_Cstr(), "value identification wasn't unique. Region not added into memory");
+
+				m_MemoryValueMap.insert(std::make_pair(_id, std::unique_ptr<MemoryValueBase>(tmpRegion)));
+			}
+
+			return;
+		}
+
+		/************************************************************************/
+		// changeMemoryRegion
+		//!
+		//! \brief change all elements of a not observed region
+		//!
+		//! \Tparam T data type of the elements
+		//! \Tparam N number of elements
+		/************************************************************************/
+		template <typename T, std::size_t N>
+		void changeMemoryRegion(const std::array<T, N>& _values, unsigned int _valueId)
+		{
+			auto value = m_MemoryValueMap.find(_valueId);
+
+			if ((value == m_MemoryValueMap.end()) || (value->second->m_length != sizeof(T) * N))
+			{
+				SC_REPORT_ERROR(this->getName_Cstr(), "region identification not found at memory");
+				return;
+			}
+
+			static_cast<MemoryRegion<T, N>*>(value->second.get())->m_value = _values;
+		}
+
+		/************************************************************************/
+		// getOutputRegion
+		//!
+		//! \brief return last written elements of an observed region
+		//!
+		//! \Tparam T data type of the elements
+		//! \Tparam N number of elements
+		/************************************************************************/
+		template <typename T, std::size_t N>
+		const std::array<T, N>& getOutputRegion(unsigned int _valueId) const
+		{
+			auto& value = m_outputValueMap.at(_valueId);
+			sc_assert(value->m_length == sizeof(T) * N);
+
+			return static_cast<MemoryRegion<T, N>*>(value.get())->m_value;
+		}
+
+		/************************************************************************/
+		// registerRegionElementObserver
+		//!
+		//! \brief wire one element of a not observed region to a consumer
+		//!
+		//! \param [in] _regionId	value identification number of region
+		//! \param [in] _element	index of element in region
+		//! \param [in] _obs	Observer of the consumer
+		/************************************************************************/
+		void registerRegionElementObserver(unsigned int _regionId, unsigned int _element, Observer* _obs);
+
+		/************************************************************************/
+		// getRegionElementObserver
+		//!
+		//! \brief return Observer of one element of an observed region
+		//!
+		//! \param [in] _regionId	value identification number of region
+		//! \param [in] _element	index of element in region
+		//! \return nullptr if region or element not found
+		/************************************************************************/
+		Observer* getRegionElementObserver(unsigned int _regionId, unsigned int _element);
+
 	public:
 		/************************************************************************/
 		// notifyForGeneratedOutPix
@@ -323,6 +503,49 @@ namespace vc_utils
 		/************************************************************************/
 		void NotifyAllCurrentValues(void);
 
+		/************************************************************************/
+		// notifyAllInputValues
+		//!
+		//! \brief notify all not observed memory values once more
+		//!
+		//! \details
+		//! Used by drivers that push several data sets through the same task
+		//! graph instance. After the input values are changed by
+		//! changeMemoryValue, this starts the next iteration of the algorithm.
+		/************************************************************************/
+		void notifyAllInputValues(void);
+
+		//! \brief enable or disable the notification of all values at simulation start
+		void setAutoStart(bool _autoStart) { m_autoStart = _autoStart; }
+
+		//! \brief enable or disable the text dump of results at std. output
+		void setDumpOutputs(bool _dumpOutputs) { m_dumpOutputs = _dumpOutputs; }
+
+		//! \brief event notified after all observed values of an iteration are written
+		const event_t& getOutputsWrittenEvent(void) const { return m_outputsWrittenEv; }
+
+		/************************************************************************/
+		// getOutputValue
+		//!
+		//! \brief return last written value of an observed memory value
+		//!
+		//! \param [in] _valueId value identification number
+		//!
+		//! \details
+		//! The template parameter has to be the same type the value was added with.
+		//!
+		//! \Tparam T data type of observed value
+		/************************************************************************/
+		template <typename T>
+		const T& getOutputValue(unsigned int _valueId) const
+		{
+			auto& value = m_outputValueMap.at(_valueId);
+			sc_assert(value->m_length == sizeof(T));
+
+			// values and regions of one element share the accessor
+			return *static_cast<const T*>(value->getData());
+		}
+
 		//! \brief get observer id of Observer Manager by entering own observer id.
 		//! \note wrong index throw out of range exception.
 		unsigned int operator[](const unsigned int& _obsId)
@@ -351,6 +574,10 @@ namespace vc_utils
 		//! \brief print values of all result pixels (m_outPixels)
 		void dumpOutPixel(std::ostream& _os = ::std::cout) const;
 
+	private:
+		//! \brief print all elements of a region
+		void dumpRegion(std::ostream& _os, const MemoryValueBase& _region) const;
+
 	private:
 		//! \var m_valueInfoMap
 		//! \brief BRIEF
@@ -371,6 +598,25 @@ namespace vc_utils
 		//! \var m_outPixEvAndList
 		//! \brief SystemC event and list to synchronize memory output process
 		sc_core::sc_event_and_list m_outPixEvAndList;
+		//! \var m_outputsWrittenEv
+		//! \brief notified after all observed values of an iteration are written
+		event_t m_outputsWrittenEv;
+		//! \var m_autoStart
+		//! \brief notify all values at simulation start (true)
+		bool m_autoStart = {true};
+		//! \var m_dumpOutputs
+		//! \brief print results at std. output (true)
+		bool m_dumpOutputs = {true};
+
+		//! \var m_regionObserverMap
+		//! \brief element Observers of not observed regions (Observer, element index)
+		std::map<unsigned int, std::vector<std::pair<Observer*, unsigned int> > > m_regionObserverMap;
+		//! \var m_regionElementObsMap
+		//! \brief element Observers of observed regions
+		std::map<unsigned int, std::vector<std::unique_ptr<ObserverRegion> > > m_regionElementObsMap;
+		//! \var m_regionJoins
+		//! \brief joins of element notifications of observed regions
+		std::vector<std::unique_ptr<RegionJoin> > m_regionJoins;
 	};
 };
 
@@ -0,0 +1,501 @@
+//! \file MeshFabric.h
+//! \brief Builder of a W x H mesh of process units and routers
+
+#ifndef MESHFABRIC_H_
+#define MESHFABRIC_H_
+
+#include "Typedefinitions.h"
+#include "ProcessUnit_Base.h"
+#include "MeshRouter.h"
+#include "RouteTable.h"
+#include <vector>
+#include <memory>
+#include <string>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // MeshProcessUnit
+    //!
+    //! \struct MeshProcessUnit
+    //!
+    //! \brief Process unit without additional resources used as mesh node
+    /************************************************************************/
+    struct MeshProcessUnit : public ProcessUnit_Base
+    {
+        //! \brief constructor
+        explicit MeshProcessUnit( name_t _name, unsigned int _unitId )
+            : ProcessUnit_Base( _name, _unitId )
+        {
+        }
+
+        //! \brief destructor
+        virtual ~MeshProcessUnit( ) = default;
+
+        //! \brief return kind of SystemC module as string
+        virtual const char* kind( ) const override { return "MeshProcessUnit"; }
+    };
+
+
+    /************************************************************************/
+    // MeshFabric
+    //!
+    //! \class MeshFabric
+    //!
+    //! \brief Builder of a W x H mesh of process units and routers
+    //!
+    //! \details
+    //! Node (x, y) has the unit id y * W + x. x grows to the right, y grows
+    //! downwards. Every node consists of a process unit and a MeshRouter.
+    //! Routers get sockets only for existing neighbours (numbered left,
+    //! right, up, down and with USE_EXTENDED_NETWORK the diagonal
+    //! neighbours) and are bound to each other during construction.
+    //!
+    //! Edges between vertices of different nodes are added by connectRemote
+    //! (by positions) or connectVertices (by placement of placeVertex). A
+    //! RouteTableGenerator assigns Observer ids and destination value ids; a
+    //! value is sent once per destination node, also for several consumers.
+    //! Values of connectRemote are identified by subject id, values of
+    //! connectVertices by vertex id; both may be mixed in one fabric.
+    //! The TransmissionData sets of all routers are generated as RouteCache
+    //! before the end of elaboration. At the same time the channel
+    //! dependency graph of the routing policy is checked for cycles.
+    //!
+    //! Every connect registers the Observers at the producer and the
+    //! routers at once, and the route keeps the nodes of that moment.
+    //! Changing the placement afterwards has no effect on connected edges,
+    //! so a different placement is simulated with a new fabric whose
+    //! vertices are placed before they are connected.
+    //!
+    //! \tparam unitT type of process unit, constructed by (name_t, unit id)
+    /************************************************************************/
+    template < class unitT = MeshProcessUnit > class MeshFabric : public sc_core::sc_module
+    {
+    public:
+        /***************************************************************/
+        // constructor:
+        //!
+        //! \brief    build mesh
+        //!
+        //! \param [in] _name sc_module name
+        //! \param [in] _width number of nodes in x direction
+        //! \param [in] _height number of nodes in y direction
+        //! \param [in] _reqDelay request delay in AT style
+        //! \param [in] _respDelay response delay in AT style
+        //! \param [in] _commDelay communication delay per hop in LT style
+        //! \param [in] _routingLatency latency of a routing decision
+        //! \param [in] _style communication style
+        /***************************************************************/
+        explicit MeshFabric( name_t _name, unsigned int _width, unsigned int _height,
+            const sc_time_t& _reqDelay, const sc_time_t& _respDelay, const sc_time_t& _commDelay,
+            const sc_time_t& _routingLatency, TLMCOMMSTILE _style )
+            : sc_core::sc_module( _name ),
+              m_width( _width ),
+              m_height( _height ),
+              m_routeTable( _width, _height )
+        {
+            m_units.reserve( m_routeTable.getNumberOfNodes( ) );
+            m_routers.reserve( m_routeTable.getNumberOfNodes( ) );
+
+            for ( unsigned int y = 0; y < m_height; ++y )
+                for ( unsigned int x = 0; x < m_width; ++x )
+                    {
+                        auto node = getNodeIndex( x, y );
+                        auto suffix = std::to_string( x ) + "_" + std::to_string( y );
+
+                        m_units.emplace_back( new unitT( ( "unit_" + suffix ).c_str( ), node ) );
+                        m_routers.emplace_back( new MeshRouter( ( "router_" + suffix ).c_str( ),
+                            m_routeTable.getSocketIdData( node ), _reqDelay, _respDelay,
+                            _commDelay, _routingLatency, _style ) );
+                    }
+
+            // bind links in both directions
+            for ( unsigned int y = 0; y < m_height; ++y )
+                for ( unsigned int x = 0; x < m_width; ++x )
+                    {
+                        auto node = getNodeIndex( x, y );
+                        const auto& a = m_routeTable.getSocketIdData( node );
+
+                        if ( x + 1 < m_width )
+                            bindLink( node, getNodeIndex( x + 1, y ), a.right,
+                                m_routeTable.getSocketIdData( getNodeIndex( x + 1, y ) ).left );
+                        if ( y + 1 < m_height )
+                            bindLink( node, getNodeIndex( x, y + 1 ), a.down,
+                                m_routeTable.getSocketIdData( getNodeIndex( x, y + 1 ) ).up );
+#ifdef USE_EXTENDED_NETWORK
+                        if ( ( x + 1 < m_width ) && ( y + 1 < m_height ) )
+                            bindLink( node, getNodeIndex( x + 1, y + 1 ), a.lowright,
+                                m_routeTable.getSocketIdData( getNodeIndex( x + 1, y + 1 ) )
+                                    .upleft );
+                        if ( ( 0 < x ) && ( y + 1 < m_height ) )
+                            bindLink( node, getNodeIndex( x - 1, y + 1 ), a.lowleft,
+                                m_routeTable.getSocketIdData( getNodeIndex( x - 1, y + 1 ) )
+                                    .upright );
+#endif
+                    }
+        }
+
+        //! \brief destructor
+        virtual ~MeshFabric( ) = default;
+
+    private:
+        // forbidden constructors
+        MeshFabric( ) = delete;                                   //!< \brief forbidden
+        MeshFabric( const MeshFabric& _source ) = delete;         //!< \brief forbidden
+        MeshFabric( MeshFabric&& _source ) = delete;              //!< \brief forbidden
+        MeshFabric& operator=( const MeshFabric& _rhs ) = delete; //!< \brief forbidden
+        MeshFabric& operator=( MeshFabric&& _rhs ) = delete;      //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // connectRemote
+        //!
+        //! \brief    connect producer at one node with consumer at another node
+        //!
+        //! \param [in] _srcX x position of producer node
+        //! \param [in] _srcY y position of producer node
+        //! \param [in] _producer Subject which is observed
+        //! \param [in] _producerValueId observed output value of _producer
+        //! \param [in] _dstX x position of consumer node
+        //! \param [in] _dstY y position of consumer node
+        //! \param [in] _consumer Observer of consumer vertex
+        //! \return   unsigned int: value id at destination router
+        /***************************************************************/
+        unsigned int connectRemote( unsigned int _srcX, unsigned int _srcY, Subject* _producer,
+            unsigned int _producerValueId, unsigned int _dstX, unsigned int _dstY,
+            Observer* _consumer )
+        {
+            sc_assert( ( _producer != nullptr ) && ( _consumer != nullptr ) );
+
+            auto key = ( static_cast< std::uint64_t >( _producer->get_subjectID( ) ) << 32 ) |
+                       _producerValueId;
+
+            return connectNodes( getNodeIndex( _srcX, _srcY ), _producer, _producerValueId,
+                getNodeIndex( _dstX, _dstY ), _consumer, key, ROUTE_KEY_SUBJECT );
+        }
+
+        //! \brief place vertex _vertexId on node (_x, _y) for connectVertices
+        void placeVertex( unsigned int _vertexId, unsigned int _x, unsigned int _y )
+        {
+            m_routeTable.place( _vertexId, getNodeIndex( _x, _y ) );
+        }
+
+        /***************************************************************/
+        // connectVertices
+        //!
+        //! \brief    connect two placed vertices
+        //!
+        //! \param [in] _srcVertexId producer vertex, placed by placeVertex
+        //! \param [in] _producer Subject of producer vertex
+        //! \param [in] _producerValueId observed output value of _producer
+        //! \param [in] _dstVertexId consumer vertex, placed by placeVertex
+        //! \param [in] _consumer Observer of consumer vertex
+        //! \return   unsigned int: value id at destination router
+        /***************************************************************/
+        unsigned int connectVertices( unsigned int _srcVertexId, Subject* _producer,
+            unsigned int _producerValueId, unsigned int _dstVertexId, Observer* _consumer )
+        {
+            sc_assert( ( _producer != nullptr ) && ( _consumer != nullptr ) );
+
+            auto key = ( static_cast< std::uint64_t >( _srcVertexId ) << 32 ) | _producerValueId;
+
+            return connectNodes( m_routeTable.getPlacement( _srcVertexId ), _producer,
+                _producerValueId, m_routeTable.getPlacement( _dstVertexId ), _consumer, key,
+                ROUTE_KEY_VERTEX );
+        }
+
+        /***************************************************************/
+        // setTemporalDecoupling
+        //!
+        //! \brief    set quantum of temporally decoupled LT transport
+        //!
+        //! \param [in] _quantum global TLM quantum, zero switches decoupling off
+        //!
+        //! \details
+        //! Larger quanta reduce the number of context switches per hop but
+        //! increase the timing error of concurrent transfers.
+        /***************************************************************/
+        void setTemporalDecoupling( const sc_time_t& _quantum )
+        {
+            MeshRouter::setGlobalQuantum( _quantum );
+
+            for ( auto& router : m_routers )
+                router->setTemporalDecoupling( sc_core::SC_ZERO_TIME != _quantum );
+        }
+
+        //! \brief set number of outstanding transactions per link of all routers
+        void setOutstandingDepth( unsigned int _depth )
+        {
+            for ( auto& router : m_routers )
+                router->setOutstandingDepth( _depth );
+        }
+
+        /***************************************************************/
+        // setBufferDepths
+        //!
+        //! \brief    set input and output buffer depths of all links
+        //!
+        //! \param [in] _inputDepth payloads an incoming link buffers (0 = unlimited)
+        //! \param [in] _outputDepth payloads waiting for an outgoing link (0 = unlimited)
+        //!
+        //! \details
+        //! The credits of every link are set to the input buffer depth of the
+        //! neighbour. Has to be called before the simulation starts.
+        /***************************************************************/
+        void setBufferDepths( unsigned int _inputDepth, unsigned int _outputDepth )
+        {
+            for ( auto& router : m_routers )
+                router->setBufferDepths( _inputDepth, _outputDepth );
+        }
+
+        /***************************************************************/
+        // setVirtualChannels
+        //!
+        //! \brief    set number of virtual channels of all links
+        //!
+        //! \param [in] _numOfChannels virtual channels per link (at least one)
+        //!
+        //! \details
+        //! Buffer depths apply per channel. MINIMAL_ADAPTIVE needs at least
+        //! two channels. Has to be called before the simulation starts.
+        /***************************************************************/
+        void setVirtualChannels( unsigned int _numOfChannels )
+        {
+            for ( auto& router : m_routers )
+                router->setNumberOfChannels( _numOfChannels );
+
+            for ( const auto& link : m_links )
+                connectCredits( link );
+        }
+
+        //! \brief set routing policy of all routers
+        void setRoutingPolicy( ROUTINGPOLICY _policy )
+        {
+            m_policy = _policy;
+
+            for ( auto& router : m_routers )
+                router->setRoutingPolicy( _policy );
+        }
+
+        /***************************************************************/
+        // setLinkParameters
+        //!
+        //! \brief    set data size dependent latency of all links and routers
+        //!
+        //! \param [in] _clockPeriod clock period of links and router pipeline
+        //! \param [in] _linkWidth bytes transferred per cycle (0 = size independent latency)
+        //! \param [in] _flitSize bytes per flit (0 = no flits)
+        //! \param [in] _pipelineDepth router pipeline stages per hop
+        /***************************************************************/
+        void setLinkParameters( const sc_time_t& _clockPeriod, unsigned int _linkWidth,
+            unsigned int _flitSize = 0, unsigned int _pipelineDepth = 0 )
+        {
+            for ( auto& router : m_routers )
+                router->setLinkParameters( _clockPeriod, _linkWidth, _flitSize, _pipelineDepth );
+        }
+
+        /***************************************************************/
+        // setMulticast
+        //!
+        //! \brief    send values with consumers at several nodes as multicast
+        //!
+        //! \param [in] _enable true = one payload per changed value, replicated
+        //!                     at the routers; false = one payload per destination
+        /***************************************************************/
+        void setMulticast( bool _enable )
+        {
+            for ( auto& router : m_routers )
+                router->setMulticast( _enable );
+        }
+
+        //! \brief time payloads waited for credits or output buffer space at all routers
+        sc_time_t getStallTime( void ) const
+        {
+            sc_time_t stallTime = sc_core::SC_ZERO_TIME;
+
+            for ( const auto& router : m_routers )
+                stallTime += router->getCreditStallTime( ) + router->getBufferStallTime( );
+
+            return stallTime;
+        }
+
+    public:
+        //! \brief return node index (unit id) of position
+        unsigned int getNodeIndex( unsigned int _x, unsigned int _y ) const
+        {
+            sc_assert( ( _x < m_width ) && ( _y < m_height ) );
+            return _y * m_width + _x;
+        }
+
+        //! \brief return process unit at position
+        unitT* getUnit( unsigned int _x, unsigned int _y ) const
+        {
+            return m_units[ getNodeIndex( _x, _y ) ].get( );
+        }
+
+        //! \brief return router at position
+        MeshRouter* getRouter( unsigned int _x, unsigned int _y ) const
+        {
+            return m_routers[ getNodeIndex( _x, _y ) ].get( );
+        }
+
+        //! \brief all process units ordered by node index (see writeStatisticsCsv)
+        std::vector< const ProcessUnit_Base* > getProcessUnits( void ) const
+        {
+            std::vector< const ProcessUnit_Base* > units;
+            for ( const auto& unit : m_units )
+                units.push_back( unit.get( ) );
+
+            return units;
+        }
+
+        //! \brief all routers ordered by node index (see writeLinkStatisticsCsv)
+        std::vector< const Interconnect_Base* > getInterconnects( void ) const
+        {
+            std::vector< const Interconnect_Base* > interconnects;
+            for ( const auto& router : m_routers )
+                interconnects.push_back( router.get( ) );
+
+            return interconnects;
+        }
+
+        //! \brief number of nodes in x direction
+        unsigned int getWidth( void ) const { return m_width; }
+
+        //! \brief number of nodes in y direction
+        unsigned int getHeight( void ) const { return m_height; }
+
+        //! \brief generator of the TransmissionData sets
+        const RouteTableGenerator& getRouteTable( void ) const { return m_routeTable; }
+
+        //! \brief generated TransmissionData sets (valid after elaboration)
+        const RouteCache& getRouteCache( void ) const { return m_routeCache; }
+
+        //! \brief return kind of SystemC module as string
+        virtual const char* kind( ) const override { return "MeshFabric"; }
+
+    protected:
+        //! \brief generate TransmissionData sets of all routers
+        virtual void before_end_of_elaboration( ) override
+        {
+            // with an escape channel only the XY routes can form cycles
+            auto policy = m_policy;
+            bool escape = 1 < m_routers.front( )->getNumberOfChannels( );
+            if ( ( MINIMAL_ADAPTIVE == policy ) && escape )
+                policy = XY_ROUTING;
+
+            if ( !isDeadlockFree( policy, m_width, m_height ) )
+                {
+                    auto msg = std::string( "channel dependency graph of " ) +
+                               getRoutingPolicyName( m_policy ) + " on a " +
+                               std::to_string( m_width ) + "x" + std::to_string( m_height ) +
+#ifdef USE_EXTENDED_NETWORK
+                               " mesh with diagonal links has a cycle";
+#else
+                               " mesh has a cycle";
+#endif
+                    // only the adaptive policy gains an escape channel by more channels
+                    if ( ( MINIMAL_ADAPTIVE == m_policy ) && !escape )
+                        msg += ", use at least two virtual channels";
+
+                    SC_REPORT_ERROR( "MeshFabric", msg.c_str( ) );
+                }
+
+            m_routeCache = m_routeTable.build( );
+
+            for ( unsigned int node = 0; node < m_routers.size( ); ++node )
+                m_routers[ node ]->setRouteCache( m_routeCache, node );
+        }
+
+    private:
+        //! \brief add route and register producer and consumer at the routers
+        unsigned int connectNodes( unsigned int _src, Subject* _producer,
+            unsigned int _producerValueId, unsigned int _dst, Observer* _consumer,
+            std::uint64_t _key, ROUTE_KEY _keySpace )
+        {
+            auto route = m_routeTable.addRoute( _src, _dst, _key, _keySpace );
+
+            // first consumer at destination node
+            if ( route.created )
+                {
+                    auto obsId = m_routers[ _src ]->addOutgoingValue( );
+                    sc_assert( obsId == route.obsId );
+
+                    _producer->registerObserver(
+                        m_routers[ _src ]->inputObs.getObserver( obsId ), _producerValueId );
+                }
+
+            m_routers[ _dst ]->registerObserver( _consumer, route.destValueId );
+
+            return route.destValueId;
+        }
+
+        //! \struct Link
+        //! \brief link between two neighbours
+        struct Link
+        {
+            unsigned int node;      //!< \brief first node
+            unsigned int neighbour; //!< \brief second node
+            int nodeSocket;         //!< \brief socket of first node to neighbour
+            int neighbourSocket;    //!< \brief socket of neighbour to first node
+        };
+
+        //! \brief bind links and credits between a node and a neighbour in both directions
+        void bindLink( unsigned int _node, unsigned int _neighbour, int _nodeSocket,
+            int _neighbourSocket )
+        {
+            sc_assert( ( 0 <= _nodeSocket ) && ( 0 <= _neighbourSocket ) );
+
+            m_routers[ _node ]->getInitiatorSocket( _nodeSocket ).bind(
+                m_routers[ _neighbour ]->getTargetSocket( _neighbourSocket ) );
+            m_routers[ _neighbour ]->getInitiatorSocket( _neighbourSocket ).bind(
+                m_routers[ _node ]->getTargetSocket( _nodeSocket ) );
+
+            m_links.push_back( Link{_node, _neighbour, _nodeSocket, _neighbourSocket} );
+            connectCredits( m_links.back( ) );
+        }
+
+        //! \brief connect credits of a link in both directions
+        void connectCredits( const Link& _link )
+        {
+            auto& node = *m_routers[ _link.node ];
+            auto& neighbour = *m_routers[ _link.neighbour ];
+
+            node.connectCredits( _link.nodeSocket, neighbour, _link.neighbourSocket );
+            neighbour.connectCredits( _link.neighbourSocket, node, _link.nodeSocket );
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_width
+        //! \brief number of nodes in x direction
+        unsigned int m_width;
+        //! \var m_height
+        //! \brief number of nodes in y direction
+        unsigned int m_height;
+        //! \var m_routeTable
+        //! \brief socket numbering, placement and routes of all nodes
+        RouteTableGenerator m_routeTable;
+        //! \var m_policy
+        //! \brief routing policy of all routers
+        ROUTINGPOLICY m_policy = {XY_ROUTING};
+        //! \var m_links
+        //! \brief bound links
+        std::vector< Link > m_links;
+        //! \var m_routeCache
+        //! \brief TransmissionData sets of all routers
+        RouteCache m_routeCache;
+        //! \var m_units
+        //! \brief process units (index = node index)
+        std::vector< std::unique_ptr< unitT > > m_units;
+        //! \var m_routers
+        //! \brief routers (index = node index)
+        std::vector< std::unique_ptr< MeshRouter > > m_routers;
+    };
+}
+
+
+#endif // !MESHFABRIC_H_
@@ -0,0 +1,85 @@
+//! \file MeshPlacement.h
+//! \brief Hop distance and load imbalance of vertex placements on a mesh
+
+#ifndef MESHPLACEMENT_H_
+#define MESHPLACEMENT_H_
+
+#include "Typedefinitions.h"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+namespace vc_utils
+{
+    /***************************************************************/
+    // getMeshHops
+    //!
+    //! \brief    hops between two nodes of a mesh
+    //!
+    //! \param [in] _width number of nodes in x direction
+    //! \param [in] _a node index y * _width + x
+    //! \param [in] _b node index y * _width + x
+    //! \return   unsigned int: hops of XY routing, with USE_EXTENDED_NETWORK
+    //!           of diagonal links
+    /***************************************************************/
+    inline unsigned int getMeshHops( unsigned int _width, unsigned int _a, unsigned int _b )
+    {
+        auto dx = std::abs( static_cast< int >( _a % _width ) - static_cast< int >( _b % _width ) );
+        auto dy = std::abs( static_cast< int >( _a / _width ) - static_cast< int >( _b / _width ) );
+
+#ifdef USE_EXTENDED_NETWORK
+        // diagonal links
+        return static_cast< unsigned int >( std::max( dx, dy ) );
+#else
+        return static_cast< unsigned int >( dx + dy );
+#endif
+    }
+
+    /***************************************************************/
+    // getLoadImbalance
+    //!
+    //! \brief    imbalance of the node loads of a placement
+    //!
+    //! \param [in] _nodeLoad load per node
+    //! \param [in] _totalLoad sum of all loads
+    //! \return   double: nodes * sum of squared node loads / total load^2 - 1
+    //!           (0 = balanced)
+    //!
+    //! \details
+    //! The squares penalize a single overloaded node more than several
+    //! slightly loaded ones, and a move changes the sum in constant time.
+    /***************************************************************/
+    inline double getLoadImbalance( const std::vector< double >& _nodeLoad, double _totalLoad )
+    {
+        if ( 0.0 >= _totalLoad )
+            return 0.0;
+
+        double squares = 0.0;
+        for ( auto load : _nodeLoad )
+            squares += load * load;
+
+        return std::max( 0.0, _nodeLoad.size( ) * squares / ( _totalLoad * _totalLoad ) - 1.0 );
+    }
+
+    /***************************************************************/
+    // getBalanceScale
+    //!
+    //! \brief    factor of the imbalance in the cost of a placement
+    //!
+    //! \param [in] _balanceWeight weight of load imbalance against communication
+    //! \param [in] _numOfEdges number of edges of the graph without self loops
+    //! \return   double: _balanceWeight * _numOfEdges (at least one edge)
+    //!
+    //! \details
+    //! ColorMapper and PlacementOptimizer scale the imbalance by all edges
+    //! of the graph, also by edges inside a cluster and between external
+    //! subjects, so both costs share one normalization.
+    /***************************************************************/
+    inline double getBalanceScale( double _balanceWeight, double _numOfEdges )
+    {
+        return _balanceWeight * std::max( _numOfEdges, 1.0 );
+    }
+}
+
+
+#endif // !MESHPLACEMENT_H_
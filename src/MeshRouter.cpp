@@ -0,0 +1,1125 @@
+//! \file MeshRouter.cpp
+//! \brief MeshRouter implementation file
+
+#include "MeshRouter.h"
+#include <algorithm>
+#include <functional>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    /* helper functions                                                     */
+    /************************************************************************/
+    unsigned int getNumberOfSocketIds( const SocketIdData& _socketIds )
+    {
+        int maxId = std::max( std::max( _socketIds.left, _socketIds.right ),
+            std::max( _socketIds.up, _socketIds.down ) );
+#ifdef USE_EXTENDED_NETWORK
+        maxId = std::max( maxId, std::max( std::max( _socketIds.upright, _socketIds.upleft ),
+                                     std::max( _socketIds.lowright, _socketIds.lowleft ) ) );
+#endif
+        return static_cast< unsigned int >( maxId + 1 );
+    }
+
+    /************************************************************************/
+    /* constructor                                                          */
+    /************************************************************************/
+    MeshRouter::MeshRouter( name_t _name, const SocketIdData& _socketIds,
+        const sc_time_t& _reqDelay, const sc_time_t& _respDelay, const sc_time_t& _commDelay,
+        const sc_time_t& _routingLatency, TLMCOMMSTILE _style )
+        : sc_core::sc_module( _name ),
+          Interconnect_Base( std::string( _name ), getNumberOfSocketIds( _socketIds ), 0,
+              _reqDelay, _respDelay, _commDelay, _routingLatency, _style ),
+          m_sendEv( ( std::string( _name ) + "_sendEv" ).c_str( ) ),
+          m_localQueue( ( std::string( _name ) + "_localQueue" ).c_str( ) ),
+          m_targetPeq( ( std::string( _name ) + "_targetPeq" ).c_str( ), this,
+              &MeshRouter::targetPhaseCallback ),
+          m_initiatorPeq( ( std::string( _name ) + "_initiatorPeq" ).c_str( ), this,
+              &MeshRouter::initiatorPhaseCallback ),
+          m_burstFlushEv( ( std::string( _name ) + "_burstFlushEv" ).c_str( ) ),
+          m_switchQueue( ( std::string( _name ) + "_switchQueue" ).c_str( ) ),
+          m_outputFreeEv( ( std::string( _name ) + "_outputFreeEv" ).c_str( ) )
+    {
+        setSocketIdData( _socketIds );
+
+        auto numOfSockets = getNumberOfSocketIds( _socketIds );
+        auto prefix = std::string( this->name( ) );
+
+        for ( unsigned int i = 0; i < numOfSockets; ++i )
+            {
+                auto idx = std::to_string( i );
+
+                m_initSockets.emplace_back( new initSocket_t( ( "outSocket_" + idx ).c_str( ) ) );
+                m_targetSockets.emplace_back(
+                    new targetSocket_t( ( "inSocket_" + idx ).c_str( ) ) );
+                m_linkReadyEvs.emplace_back(
+                    new event_t( ( prefix + "_linkReadyEv_" + idx ).c_str( ) ) );
+                m_linkFreeEvs.emplace_back(
+                    new event_t( ( prefix + "_linkFreeEv_" + idx ).c_str( ) ) );
+                m_linkKeepers.emplace_back( new quantumKeeper_t( ) );
+                m_endReqEvs.emplace_back(
+                    new event_t( ( prefix + "_endReqEv_" + idx ).c_str( ) ) );
+
+                m_initSockets.back( )->register_nb_transport_bw(
+                    this, &MeshRouter::nb_transport_bw );
+
+                m_targetSockets.back( )->register_b_transport(
+                    this, &MeshRouter::b_transport, static_cast< int >( i ) );
+                m_targetSockets.back( )->register_nb_transport_fw(
+                    this, &MeshRouter::nb_transport_fw, static_cast< int >( i ) );
+
+                sc_core::sc_spawn( sc_bind( &MeshRouter::linkProcess, this, i ),
+                    ( prefix + "_linkProcess_" + idx ).c_str( ) );
+            }
+
+        // one channel per link, unlimited buffers without flow control
+        m_inputDepth.assign( numOfSockets, 0 );
+        m_outputDepth.assign( numOfSockets, 0 );
+        setNumberOfChannels( 1 );
+        m_branchOf.assign( numOfSockets, nullptr );
+
+        SC_THREAD( sendProcess );
+        SC_THREAD( burstProcess );
+        SC_THREAD( switchProcess );
+        SC_THREAD( localProcess );
+    }
+
+    /************************************************************************/
+    /* system building                                                      */
+    /************************************************************************/
+    unsigned int MeshRouter::addOutgoingValue( void )
+    {
+        m_observedValTargetVec.emplace_back( nullptr, 0 );
+
+        return inputObs.addObserver( &m_sendEv,
+            reinterpret_cast< dataPtr_t >( &m_observedValTargetVec.back( ) ),
+            sizeof( obsSendDataVec::value_type ) );
+    }
+
+    MeshRouter::initSocket_t& MeshRouter::getInitiatorSocket( unsigned int _socketId )
+    {
+        sc_assert( _socketId < m_initSockets.size( ) );
+        return *m_initSockets[ _socketId ];
+    }
+
+    MeshRouter::targetSocket_t& MeshRouter::getTargetSocket( unsigned int _socketId )
+    {
+        sc_assert( _socketId < m_targetSockets.size( ) );
+        return *m_targetSockets[ _socketId ];
+    }
+
+    /************************************************************************/
+    /* flow control                                                         */
+    /************************************************************************/
+    void MeshRouter::setBufferDepths( unsigned int _inputDepth, unsigned int _outputDepth )
+    {
+        for ( unsigned int i = 0; i < getNumberOfSockets( ); ++i )
+            {
+                setInputBufferDepth( i, _inputDepth );
+                setOutputBufferDepth( i, _outputDepth );
+            }
+    }
+
+    void MeshRouter::setInputBufferDepth( unsigned int _socketId, unsigned int _depth )
+    {
+        sc_assert( _socketId < m_inputDepth.size( ) );
+        m_inputDepth[ _socketId ] = _depth;
+
+        // credits of the neighbour follow the buffer depth
+        for ( unsigned int vc = 0; vc < m_numOfChannels; ++vc )
+            {
+                auto credits = m_creditReturn[ getChannelIndex( _socketId, vc ) ];
+                if ( credits != nullptr )
+                    credits->setDepth( _depth );
+            }
+    }
+
+    void MeshRouter::setOutputBufferDepth( unsigned int _socketId, unsigned int _depth )
+    {
+        sc_assert( _socketId < m_outputDepth.size( ) );
+        m_outputDepth[ _socketId ] = _depth;
+    }
+
+    void MeshRouter::setNumberOfChannels( unsigned int _numOfChannels )
+    {
+        sc_assert( 0 < _numOfChannels );
+
+        m_numOfChannels = _numOfChannels;
+        auto numOfChannels = getNumberOfSockets( ) * m_numOfChannels;
+
+        m_waiting.clear( );
+        m_waiting.resize( numOfChannels );
+        m_outputBuffers.clear( );
+        m_outputBuffers.resize( numOfChannels );
+        m_creditBlocked.assign( numOfChannels, false );
+        m_blockedSince.assign( numOfChannels, sc_core::SC_ZERO_TIME );
+        m_creditReturn.assign( numOfChannels, nullptr );
+        m_nextChannel.assign( getNumberOfSockets( ), 0 );
+
+        m_outCredits.clear( );
+        for ( unsigned int i = 0; i < numOfChannels; ++i )
+            m_outCredits.emplace_back( new CreditCounter( ) );
+    }
+
+    void MeshRouter::connectCredits(
+        unsigned int _outSocketId, MeshRouter& _neighbour, unsigned int _inSocketId )
+    {
+        sc_assert( _outSocketId < getNumberOfSockets( ) );
+        sc_assert( _inSocketId < _neighbour.getNumberOfSockets( ) );
+        sc_assert( m_numOfChannels == _neighbour.m_numOfChannels );
+
+        for ( unsigned int vc = 0; vc < m_numOfChannels; ++vc )
+            {
+                auto& credits = *m_outCredits[ getChannelIndex( _outSocketId, vc ) ];
+                credits.setDepth( _neighbour.m_inputDepth[ _inSocketId ] );
+                _neighbour.m_creditReturn[ _neighbour.getChannelIndex( _inSocketId, vc ) ] =
+                    &credits;
+            }
+    }
+
+    sc_time_t MeshRouter::getCreditStallTime( void ) const
+    {
+        sc_time_t stallTime = sc_core::SC_ZERO_TIME;
+
+        for ( const auto& credits : m_outCredits )
+            stallTime += credits->getStallTime( );
+
+        return stallTime;
+    }
+
+    void MeshRouter::enterOutputBuffer( unsigned int _channel, trans_t& _trans, int _inChannel )
+    {
+        m_outputBuffers[ _channel ].push_back( &_trans );
+        m_linkReadyEvs[ _channel / m_numOfChannels ]->notify( sc_core::SC_ZERO_TIME );
+
+        returnCredit( _inChannel );
+    }
+
+    void MeshRouter::waitForOutput( unsigned int _channel, trans_t& _trans, int _inChannel )
+    {
+        // input buffer slot stays occupied (backpressure)
+        Waiting entry = {&_trans, _inChannel, sc_core::sc_time_stamp( )};
+        m_waiting[ _channel ].push_back( entry );
+        ++m_numOfBufferStalls;
+    }
+
+    void MeshRouter::acquireCredit( unsigned int _channel )
+    {
+        auto& credits = *m_outCredits[ _channel ];
+
+        if ( !credits.hasCredit( ) )
+            {
+                auto start = sc_core::sc_time_stamp( );
+
+                while ( !credits.hasCredit( ) )
+                    sc_core::wait( credits.getCreditEvent( ) );
+
+                credits.addStall( sc_core::sc_time_stamp( ) - start );
+            }
+
+        credits.consume( );
+    }
+
+    void MeshRouter::returnCredit( int _inChannel )
+    {
+        // local process unit has no credits
+        if ( ( 0 <= _inChannel ) && ( m_creditReturn[ _inChannel ] != nullptr ) )
+            m_creditReturn[ _inChannel ]->giveBack( );
+    }
+
+    int MeshRouter::getInputChannel( unsigned int _socketId, trans_t& _trans ) const
+    {
+        auto ext = _trans.get_extension< RoutingExt >( );
+        sc_assert( ( ext != nullptr ) && ( ext->getChannel( ) < m_numOfChannels ) );
+
+        return static_cast< int >( getChannelIndex( _socketId, ext->getChannel( ) ) );
+    }
+
+    unsigned int MeshRouter::getCongestion( unsigned int _socketId ) const
+    {
+        unsigned int load = 0;
+
+        for ( unsigned int vc = 0; vc < m_numOfChannels; ++vc )
+            {
+                auto channel = getChannelIndex( _socketId, vc );
+                const auto& credits = *m_outCredits[ channel ];
+
+                load += static_cast< unsigned int >(
+                    m_outputBuffers[ channel ].size( ) + m_waiting[ channel ].size( ) );
+                load += credits.getDepth( ) - credits.getCredits( );
+            }
+
+        return load;
+    }
+
+    int MeshRouter::selectSendChannel( unsigned int _socketId )
+    {
+        // round robin between virtual channels with payload and credit
+        for ( unsigned int i = 0; i < m_numOfChannels; ++i )
+            {
+                auto vc = ( m_nextChannel[ _socketId ] + i ) % m_numOfChannels;
+                auto channel = getChannelIndex( _socketId, vc );
+
+                if ( m_outputBuffers[ channel ].empty( ) )
+                    continue;
+
+                auto& credits = *m_outCredits[ channel ];
+
+                if ( !credits.hasCredit( ) )
+                    {
+                        if ( !m_creditBlocked[ channel ] )
+                            {
+                                m_creditBlocked[ channel ] = true;
+                                m_blockedSince[ channel ] = sc_core::sc_time_stamp( );
+                            }
+                        continue;
+                    }
+
+                if ( m_creditBlocked[ channel ] )
+                    {
+                        credits.addStall( sc_core::sc_time_stamp( ) - m_blockedSince[ channel ] );
+                        m_creditBlocked[ channel ] = false;
+                    }
+
+                m_nextChannel[ _socketId ] = vc + 1;
+                return static_cast< int >( channel );
+            }
+
+        return -1;
+    }
+
+    /************************************************************************/
+    /* routing                                                              */
+    /************************************************************************/
+    int MeshRouter::getOutSocketId( trans_t* _tObjPtr ) const
+    {
+        unsigned int channel = 0;
+        return selectOutput( *_tObjPtr, -1, channel );
+    }
+
+    int MeshRouter::selectOutput( trans_t& _trans, int _inChannel, unsigned int& _channel ) const
+    {
+        auto ext = _trans.get_extension< RoutingExt >( );
+
+        if ( ext == nullptr )
+            SC_REPORT_ERROR( this->name( ), "extension is not available!" );
+
+        if ( ext->isTargedReached( ) )
+            return TARGET;
+
+        auto x = ext->getXCoordinate( );
+        auto y = ext->getYCoordinate( );
+
+        // escape channel zero of minimal adaptive routing is never left
+        bool escapeUsed = ( MINIMAL_ADAPTIVE == m_policy ) && ( 1 < m_numOfChannels );
+        bool onEscape = escapeUsed && ( 0 <= _inChannel ) &&
+                        ( 0 == static_cast< unsigned int >( _inChannel ) % m_numOfChannels );
+
+        DIRECTION candidates[ NUMOFDIRECTIONS ];
+        auto numOfCandidates =
+            getRoutingCandidates( onEscape ? XY_ROUTING : m_policy, x, y, candidates );
+
+        unsigned int firstVc = ( escapeUsed && !onEscape ) ? 1 : 0;
+        unsigned int lastVc = onEscape ? 1 : m_numOfChannels;
+
+        // least congested candidate with output buffer space
+        int bestSocket = -1;
+        unsigned int bestVc = firstVc;
+        DIRECTION bestDir = candidates[ 0 ];
+        unsigned int bestLoad = 0;
+
+        for ( unsigned int i = 0; i < numOfCandidates; ++i )
+            {
+                auto socketId =
+                    getDirectionSocket( getDirectionSocketId( *m_socketId, candidates[ i ] ) );
+                auto load = getCongestion( socketId );
+
+                if ( ( 0 <= bestSocket ) && ( bestLoad <= load ) )
+                    continue;
+
+                for ( unsigned int vc = firstVc; vc < lastVc; ++vc )
+                    {
+                        if ( !hasOutputSpace( getChannelIndex( socketId, vc ) ) )
+                            continue;
+
+                        bestSocket = socketId;
+                        bestVc = vc;
+                        bestDir = candidates[ i ];
+                        bestLoad = load;
+                        break;
+                    }
+            }
+
+        if ( 0 > bestSocket )
+            {
+                if ( escapeUsed && !onEscape )
+                    {
+                        // all adaptive channels are full, take the escape channel
+                        getRoutingCandidates( XY_ROUTING, x, y, candidates );
+                        bestDir = candidates[ 0 ];
+                        bestVc = 0;
+                    }
+
+                bestSocket = getDirectionSocket( getDirectionSocketId( *m_socketId, bestDir ) );
+            }
+
+        applyDirection( bestDir, x, y );
+        ext->setCoordinates( x, y );
+        ext->setChannel( bestVc );
+
+        _channel = getChannelIndex( bestSocket, bestVc );
+        return bestSocket;
+    }
+
+    int MeshRouter::getDirectionSocket( int _socketId ) const
+    {
+        if ( ( 0 > _socketId ) ||
+             ( static_cast< unsigned int >( _socketId ) >= m_initSockets.size( ) ) )
+            SC_REPORT_ERROR( this->name( ), "route leaves the mesh, no neighbour in direction" );
+
+        return _socketId;
+    }
+
+    void MeshRouter::route( trans_t& _trans, const sc_time_t& _delay, int _inChannel )
+    {
+        m_inputOf[ &_trans ] = _inChannel;
+        m_switchQueue.notify( _trans, _delay );
+        _trans.get_extension< RoutingExt >( )->addLatency( ROUTING_LATENCY, getRoutingDelay( ) );
+    }
+
+    /************************************************************************/
+    /* processes                                                            */
+    /************************************************************************/
+    void MeshRouter::sendProcess( void )
+    {
+        while ( true )
+            {
+                sc_core::wait( m_sendEv );
+
+                m_changedValues.clear( );
+
+                for ( auto obs : inputObs )
+                    {
+                        if ( obs.second->isValueChanged( true ) )
+                            m_changedValues.emplace_back(
+                                m_observedValTargetVec[ obs.first ].first, obs.first );
+                    }
+
+                if ( !m_multicast )
+                    {
+                        for ( const auto& value : m_changedValues )
+                            sendValue( value.second );
+                        continue;
+                    }
+
+                // Observers of the same producer value share its data pointer
+                std::stable_sort( m_changedValues.begin( ), m_changedValues.end( ),
+                    []( const std::pair< dataPtr_t, unsigned int >& _lhs,
+                        const std::pair< dataPtr_t, unsigned int >& _rhs ) {
+                        return std::less< dataPtr_t >( )( _lhs.first, _rhs.first );
+                    } );
+
+                for ( std::size_t first = 0; first < m_changedValues.size( ); )
+                    {
+                        auto data = m_changedValues[ first ].first;
+                        auto last = first + 1;
+                        while ( ( last < m_changedValues.size( ) ) &&
+                                ( m_changedValues[ last ].first == data ) )
+                            ++last;
+
+                        if ( 1 == last - first )
+                            sendValue( m_changedValues[ first ].second );
+                        else
+                            sendMulticast( first, last );
+
+                        first = last;
+                    }
+            }
+    }
+
+    void MeshRouter::sendValue( unsigned int _obsId )
+    {
+        if ( sc_core::SC_ZERO_TIME != m_burstWindow )
+            {
+                packValue( _obsId );
+                return;
+            }
+
+        auto trans = m_payloads.allocate( );
+        trans->acquire( );
+
+        packTransactionObject( trans, _obsId );
+        route( *trans, getRoutingDelay( ) );
+
+        ++m_sentTransactions;
+        ++m_sentValues;
+    }
+
+    void MeshRouter::sendMulticast( std::size_t _first, std::size_t _last )
+    {
+        auto trans = m_payloads.allocate( );
+        trans->acquire( );
+
+        packTransactionObject( trans, m_changedValues[ _first ].second );
+
+        if ( trans->get_extension< MulticastExt >( ) == nullptr )
+            trans->set_extension< MulticastExt >( new MulticastExt( ) );
+
+        auto multicast = trans->get_extension< MulticastExt >( );
+
+        for ( auto i = _first; i < _last; ++i )
+            {
+                const auto& transmission = getTransmissionData( m_changedValues[ i ].second );
+                multicast->add( transmission.relativXposition, transmission.relativYposition,
+                    transmission.destValueId );
+            }
+
+        route( *trans, getRoutingDelay( ) );
+
+        ++m_sentTransactions;
+        m_sentValues += _last - _first;
+    }
+
+    void MeshRouter::burstProcess( void )
+    {
+        while ( true )
+            {
+                sc_core::wait( m_burstFlushEv );
+
+                for ( auto& burst : m_openBursts )
+                    sendBurst( *burst.second );
+
+                m_openBursts.clear( );
+            }
+    }
+
+    void MeshRouter::packValue( unsigned int _obsId )
+    {
+        const auto& transmission = getTransmissionData( _obsId );
+        auto value = m_observedValTargetVec[ _obsId ];
+        auto key = std::make_pair(
+            transmission.relativXposition, transmission.relativYposition );
+
+        auto& trans = m_openBursts[ key ];
+
+        if ( trans == nullptr )
+            {
+                trans = m_payloads.allocate( );
+                trans->acquire( );
+
+                trans->set_command( tlm::TLM_READ_COMMAND );
+                trans->set_address( transmission.destValueId );
+                trans->get_extension< RoutingExt >( )->setCoordinates(
+                    transmission.relativXposition, transmission.relativYposition );
+
+                if ( trans->get_extension< BurstExt >( ) == nullptr )
+                    trans->set_extension< BurstExt >( new BurstExt( ) );
+
+                // first open burst starts the window
+                if ( 1 == m_openBursts.size( ) )
+                    m_burstFlushEv.notify( m_burstWindow );
+            }
+
+        auto burst = trans->get_extension< BurstExt >( );
+        burst->append( transmission.destValueId, value.first, value.second );
+        ++m_sentValues;
+
+        if ( ( 0 != m_burstMaxValues ) && ( burst->size( ) >= m_burstMaxValues ) )
+            {
+                sendBurst( *trans );
+                m_openBursts.erase( key );
+
+                // a pending window would cut the window of the next burst short
+                if ( m_openBursts.empty( ) )
+                    m_burstFlushEv.cancel( );
+            }
+    }
+
+    void MeshRouter::sendBurst( trans_t& _trans )
+    {
+        auto burst = _trans.get_extension< BurstExt >( );
+
+        _trans.set_data_ptr( burst->getData( ) );
+        _trans.set_data_length( burst->getLength( ) );
+        _trans.set_streaming_width( burst->getLength( ) );
+
+        route( _trans, getRoutingDelay( ) );
+        ++m_sentTransactions;
+    }
+
+    void MeshRouter::switchProcess( void )
+    {
+        while ( true )
+            {
+                sc_core::wait( m_switchQueue.get_event( ) | m_outputFreeEv );
+
+                // waiting payloads first, they keep their order per outgoing channel
+                for ( unsigned int channel = 0; channel < m_waiting.size( ); ++channel )
+                    {
+                        auto& waiting = m_waiting[ channel ];
+
+                        while ( !waiting.empty( ) && hasOutputSpace( channel ) )
+                            {
+                                auto entry = waiting.front( );
+                                waiting.pop_front( );
+
+                                m_bufferStallTime += sc_core::sc_time_stamp( ) - entry.since;
+                                enterOutputBuffer( channel, *entry.trans, entry.inChannel );
+                            }
+                    }
+
+                while ( auto trans = m_switchQueue.get_next_transaction( ) )
+                    {
+                        auto it = m_inputOf.find( trans );
+                        if ( it == m_inputOf.end( ) )
+                            {
+                                SC_REPORT_ERROR(
+                                    this->name( ), "routed payload without input channel" );
+                                continue;
+                            }
+
+                        auto inChannel = it->second;
+                        m_inputOf.erase( it );
+
+                        if ( isMulticastPayload( *trans ) )
+                            {
+                                replicate( *trans, inChannel );
+                                continue;
+                            }
+
+                        unsigned int channel = 0;
+                        auto socketId = selectOutput( *trans, inChannel, channel );
+
+                        if ( TARGET == socketId )
+                            {
+                                m_localQueue.notify( *trans, sc_core::SC_ZERO_TIME );
+                                returnCredit( inChannel );
+                                continue;
+                            }
+
+                        trans->get_extension< RoutingExt >( )->startQueueing( );
+
+                        if ( canEnterOutput( channel ) )
+                            {
+                                enterOutputBuffer( channel, *trans, inChannel );
+                            }
+                        else
+                            {
+                                waitForOutput( channel, *trans, inChannel );
+                            }
+                    }
+            }
+    }
+
+    void MeshRouter::replicate( trans_t& _trans, int _inChannel )
+    {
+        const auto& destinations = _trans.get_extension< MulticastExt >( )->getDestinations( );
+        DIRECTION candidates[ NUMOFDIRECTIONS ];
+
+        // one branch per XY hop, destinations of a branch are relative to the neighbour
+        for ( const auto& destination : destinations )
+            {
+                auto x = destination.relativXposition;
+                auto y = destination.relativYposition;
+
+                if ( 0 == getRoutingCandidates( XY_ROUTING, x, y, candidates ) )
+                    {
+                        auto branch = createBranch( _trans );
+                        branch->set_address( destination.valueId );
+                        m_localQueue.notify( *branch, sc_core::SC_ZERO_TIME );
+                        continue;
+                    }
+
+                auto socketId =
+                    getDirectionSocket( getDirectionSocketId( *m_socketId, candidates[ 0 ] ) );
+                auto& branch = m_branchOf[ socketId ];
+
+                if ( branch == nullptr )
+                    {
+                        branch = createBranch( _trans );
+
+                        if ( branch->get_extension< MulticastExt >( ) == nullptr )
+                            branch->set_extension< MulticastExt >( new MulticastExt( ) );
+                    }
+
+                applyDirection( candidates[ 0 ], x, y );
+                branch->get_extension< MulticastExt >( )->add( x, y, destination.valueId );
+            }
+
+        // the input buffer slot is held by the first branch which has to wait
+        auto inChannel = _inChannel;
+
+        for ( unsigned int socketId = 0; socketId < m_branchOf.size( ); ++socketId )
+            {
+                auto branch = m_branchOf[ socketId ];
+
+                if ( branch == nullptr )
+                    continue;
+
+                m_branchOf[ socketId ] = nullptr;
+
+                auto multicast = branch->get_extension< MulticastExt >( );
+                const auto first = multicast->getDestinations( ).front( );
+                auto ext = branch->get_extension< RoutingExt >( );
+                ext->setCoordinates( first.relativXposition, first.relativYposition );
+                ext->setChannel( 0 );
+                ext->startQueueing( );
+
+                // a single destination continues as unicast
+                if ( 1 == multicast->size( ) )
+                    {
+                        branch->set_address( first.valueId );
+                        multicast->clear( );
+                    }
+
+                auto channel = getChannelIndex( socketId, 0 );
+
+                if ( canEnterOutput( channel ) )
+                    {
+                        enterOutputBuffer( channel, *branch, -1 );
+                    }
+                else
+                    {
+                        waitForOutput( channel, *branch, inChannel );
+                        inChannel = -1;
+                    }
+            }
+
+        returnCredit( inChannel );
+        _trans.release( );
+    }
+
+    trans_t* MeshRouter::createBranch( trans_t& _trans )
+    {
+        auto branch = m_payloads.allocate( );
+        branch->acquire( );
+
+        // the branch continues the hops and latency of the replicated payload
+        *branch->get_extension< RoutingExt >( ) = *_trans.get_extension< RoutingExt >( );
+
+        branch->set_command( _trans.get_command( ) );
+        branch->set_data_ptr( _trans.get_data_ptr( ) );
+        branch->set_data_length( _trans.get_data_length( ) );
+        branch->set_streaming_width( _trans.get_streaming_width( ) );
+        branch->set_byte_enable_ptr( _trans.get_byte_enable_ptr( ) );
+        branch->set_byte_enable_length( _trans.get_byte_enable_length( ) );
+
+        ++m_replications;
+        return branch;
+    }
+
+    void MeshRouter::linkProcess( unsigned int _socketId )
+    {
+        // a payload could be sent if it is queued or a credit is given back
+        sc_core::sc_event_or_list events;
+        events |= *m_linkReadyEvs[ _socketId ];
+        for ( unsigned int vc = 0; vc < m_numOfChannels; ++vc )
+            events |= m_outCredits[ getChannelIndex( _socketId, vc ) ]->getCreditEvent( );
+
+        while ( true )
+            {
+                auto channel = selectSendChannel( _socketId );
+
+                if ( 0 > channel )
+                    {
+                        syncLink( _socketId );
+                        sc_core::wait( events );
+                        continue;
+                    }
+
+                auto& buffer = m_outputBuffers[ channel ];
+                auto trans = buffer.front( );
+                buffer.pop_front( );
+
+                m_outCredits[ channel ]->consume( );
+                m_outputFreeEv.notify( sc_core::SC_ZERO_TIME );
+
+                transmit( _socketId, *trans );
+            }
+    }
+
+    void MeshRouter::localProcess( void )
+    {
+        while ( true )
+            {
+                sc_core::wait( m_localQueue.get_event( ) );
+
+                while ( auto trans = m_localQueue.get_next_transaction( ) )
+                    {
+                        deliver( *trans );
+                        trans->release( );
+                    }
+            }
+    }
+
+    void MeshRouter::transmit( unsigned int _socketId, trans_t& _trans )
+    {
+        sc_time_t delay = sc_core::SC_ZERO_TIME;
+
+        if ( LT == m_style )
+            {
+                if ( requestForOutSocket( *m_linkFreeEvs[ _socketId ], _socketId ) )
+                    {
+                        syncLink( _socketId );
+                        sc_core::wait( *m_linkFreeEvs[ _socketId ] );
+                    }
+                VC_TRACE_SEND( this, _socketId, TRACE_SEND_BEGIN, _trans );
+                startHop( _trans, getLinkDelay( _trans ) );
+
+                if ( m_decoupled )
+                    {
+                        // the whole path is annotated, no hop waits
+                        auto& keeper = *m_linkKeepers[ _socketId ];
+                        keeper.inc( getLinkDelay( _trans ) );
+                        delay = keeper.get_local_time( );
+
+                        // the returned delay holds the downstream path of this payload
+                        // only, the link itself is occupied for the link delay
+                        auto start = sc_core::sc_time_stamp( );
+                        ( *m_initSockets[ _socketId ] )->b_transport( _trans, delay );
+
+                        // a blocked hop downstream already waited out (a part of) the
+                        // offset of the link, only the remainder is still ahead
+                        auto waited = sc_core::sc_time_stamp( ) - start;
+                        if ( sc_core::SC_ZERO_TIME != waited )
+                            keeper.set( ( waited < keeper.get_local_time( ) )
+                                            ? keeper.get_local_time( ) - waited
+                                            : sc_core::SC_ZERO_TIME );
+
+                        m_outSocketFlags[ _socketId ].freeSocketForNextJob( );
+                        VC_TRACE_SEND( this, _socketId, TRACE_SEND_END, _trans );
+
+                        _trans.release( );
+
+                        if ( keeper.need_sync( ) )
+                            keeper.sync( );
+
+                        return;
+                    }
+
+                sc_core::wait( getLinkDelay( _trans ) );
+                ( *m_initSockets[ _socketId ] )->b_transport( _trans, delay );
+
+                if ( sc_core::SC_ZERO_TIME != delay )
+                    sc_core::wait( delay );
+
+                finishTransmission( _socketId, _trans );
+                return;
+            }
+
+        // AT: occupy one slot of the outstanding depth
+        if ( requestForOutSocket( *m_linkFreeEvs[ _socketId ], _socketId ) )
+            sc_core::wait( *m_linkFreeEvs[ _socketId ] );
+        VC_TRACE_SEND( this, _socketId, TRACE_SEND_BEGIN, _trans );
+        // the request phase is counted by the receiver
+        startHop( _trans, sc_core::SC_ZERO_TIME );
+
+        m_outSocketOf[ &_trans ] = _socketId;
+
+        tlm::tlm_phase phase = tlm::BEGIN_REQ;
+        auto status = ( *m_initSockets[ _socketId ] )->nb_transport_fw( _trans, phase, delay );
+
+        switch ( status )
+            {
+            case tlm::TLM_ACCEPTED:
+                // next request is allowed after END_REQ
+                sc_core::wait( *m_endReqEvs[ _socketId ] );
+                break;
+            case tlm::TLM_UPDATED:
+                if ( tlm::END_REQ == phase )
+                    sc_core::wait( delay );
+                else
+                    m_initiatorPeq.notify( _trans, phase, delay );
+                break;
+            case tlm::TLM_COMPLETED:
+                m_outSocketOf.erase( &_trans );
+                sc_core::wait( delay );
+                finishTransmission( _socketId, _trans );
+                break;
+            }
+    }
+
+    void MeshRouter::syncLink( unsigned int _socketId )
+    {
+        auto& keeper = *m_linkKeepers[ _socketId ];
+
+        if ( sc_core::SC_ZERO_TIME != keeper.get_local_time( ) )
+            keeper.sync( );
+    }
+
+    void MeshRouter::syncDelay( sc_time_t& _delay )
+    {
+        if ( sc_core::SC_ZERO_TIME != _delay )
+            {
+                sc_core::wait( _delay );
+                _delay = sc_core::SC_ZERO_TIME;
+            }
+    }
+
+    void MeshRouter::startHop( trans_t& _trans, const sc_time_t& _request )
+    {
+        auto ext = _trans.get_extension< RoutingExt >( );
+        ext->stopQueueing( );
+        ext->addHop( );
+        ext->addLatency( REQUEST_LATENCY, _request );
+    }
+
+    void MeshRouter::finishTransmission( unsigned int _socketId, trans_t& _trans )
+    {
+        m_outSocketFlags[ _socketId ].freeSocketForNextJob( );
+        VC_TRACE_SEND( this, _socketId, TRACE_SEND_END, _trans );
+        _trans.release( );
+    }
+
+    void MeshRouter::deliver( trans_t& _trans, const sc_time_t& _latency )
+    {
+        m_deliveryLatency = _latency;
+        m_currentTObjPtr = &_trans;
+        recordDelivery( _trans, _latency );
+
+        auto burst = _trans.get_extension< BurstExt >( );
+        auto data = _trans.get_data_ptr( );
+
+        if ( ( burst != nullptr ) && !burst->empty( ) )
+            {
+                // unpack burst value by value
+                for ( const auto& entry : burst->getEntries( ) )
+                    notifyValue( static_cast< unsigned int >( entry.valueId ),
+                        data + entry.offset, entry.length, entry.offset );
+            }
+        else
+            {
+                // every beat of streaming width bytes is a value
+                auto valueId = static_cast< unsigned int >( _trans.get_address( ) );
+                auto width = _trans.get_streaming_width( );
+
+                for ( unsigned int offset = 0; offset < _trans.get_data_length( );
+                      offset += width )
+                    notifyValue( valueId, data + offset, width, offset );
+            }
+
+        m_currentTObjPtr = nullptr;
+    }
+
+    void MeshRouter::notifyObservers( unsigned int _outValueId )
+    {
+        auto trans = getCurrenttObjPtr( );
+        sc_assert( trans != nullptr );
+
+        notifyValue( _outValueId, trans->get_data_ptr( ), trans->get_data_length( ), 0 );
+    }
+
+    void MeshRouter::notifyValue(
+        unsigned int _valueId, dataPtr_t _data, unsigned int _length, unsigned int _offset )
+    {
+        auto trans = getCurrenttObjPtr( );
+        auto byteEnable = trans->get_byte_enable_ptr( );
+        auto byteEnableLength = trans->get_byte_enable_length( );
+
+        bool found = false;
+
+        for ( auto obs : this->m_observerVec )
+            {
+                if ( obs.second != _valueId )
+                    continue;
+
+                found = true;
+
+                if ( byteEnable == nullptr )
+                    {
+                        obs.first->notify( m_deliveryLatency, _data, _length );
+                        continue;
+                    }
+
+                // keep disabled bytes of the observed value
+                auto current = obs.first->getValuePtr( );
+                if ( ( current == nullptr ) || ( obs.first->getMemSize( ) < _length ) )
+                    SC_REPORT_ERROR( this->name( ), "byte enables need the observed value" );
+
+                m_mergeBuffer.assign( current, current + _length );
+
+                for ( unsigned int i = 0; i < _length; ++i )
+                    {
+                        if ( tlm::TLM_BYTE_ENABLED ==
+                             byteEnable[ ( _offset + i ) % byteEnableLength ] )
+                            m_mergeBuffer[ i ] = _data[ i ];
+                    }
+
+                obs.first->notify( m_deliveryLatency, m_mergeBuffer.data( ), _length );
+            }
+
+        if ( !found )
+            SC_REPORT_ERROR( this->name( ), "no Observer registered for received value" );
+    }
+
+    /************************************************************************/
+    /* TLM interface                                                        */
+    /************************************************************************/
+    void MeshRouter::b_transport( int _id, trans_t& _trans, sc_time_t& _delay )
+    {
+        auto inChannel = getInputChannel( static_cast< unsigned int >( _id ), _trans );
+
+        if ( !checkForValidDataPackage( &_trans ) )
+            {
+                returnCredit( inChannel );
+                return;
+            }
+
+        // multicast payloads are replicated by the switch stage
+        if ( isMulticastPayload( _trans ) )
+            {
+                _trans.acquire( );
+                route( _trans, _delay + getRoutingDelay( ), inChannel );
+                return;
+            }
+
+        _delay += getRoutingDelay( );
+        _trans.get_extension< RoutingExt >( )->addLatency( ROUTING_LATENCY, getRoutingDelay( ) );
+        unsigned int channel = 0;
+        auto socketId = selectOutput( _trans, inChannel, channel );
+
+        if ( TARGET == socketId )
+            {
+                if ( m_decoupled )
+                    {
+                        deliver( _trans, _delay );
+                        returnCredit( inChannel );
+                        return;
+                    }
+
+                sc_core::wait( _delay );
+                _delay = sc_core::SC_ZERO_TIME;
+                deliver( _trans );
+                returnCredit( inChannel );
+                return;
+            }
+
+        // reserve outgoing link and input buffer of the next hop
+        event_t linkFreeEv;
+        _trans.get_extension< RoutingExt >( )->startQueueing( );
+        if ( requestForOutSocket( linkFreeEv, socketId ) )
+            {
+                // local time offset has to be consumed before blocking
+                syncDelay( _delay );
+                sc_core::wait( linkFreeEv );
+            }
+        VC_TRACE_SEND( this, socketId, TRACE_SEND_BEGIN, _trans );
+
+        if ( !m_outCredits[ channel ]->hasCredit( ) )
+            syncDelay( _delay );
+        acquireCredit( channel );
+        returnCredit( inChannel );
+        startHop( _trans, getLinkDelay( _trans ) );
+
+        if ( m_decoupled )
+            {
+                _delay += getLinkDelay( _trans );
+            }
+        else
+            {
+                sc_core::wait( _delay + getLinkDelay( _trans ) );
+                _delay = sc_core::SC_ZERO_TIME;
+            }
+
+        ( *m_initSockets[ socketId ] )->b_transport( _trans, _delay );
+
+        m_outSocketFlags[ socketId ].freeSocketForNextJob( );
+        VC_TRACE_SEND( this, socketId, TRACE_SEND_END, _trans );
+    }
+
+    tlm::tlm_sync_enum MeshRouter::nb_transport_fw(
+        int _id, trans_t& _trans, tlm::tlm_phase& _phase, sc_time_t& _delay )
+    {
+        ( void ) _id;
+
+        if ( tlm::END_RESP == _phase )
+            return tlm::TLM_COMPLETED;
+
+        if ( tlm::BEGIN_REQ != _phase )
+            SC_REPORT_ERROR( this->name( ), "unexpected phase at incoming link" );
+
+        m_inSocketOf[ &_trans ] = static_cast< unsigned int >( _id );
+        m_targetPeq.notify( _trans, _phase, _delay );
+
+        return tlm::TLM_ACCEPTED;
+    }
+
+    tlm::tlm_sync_enum MeshRouter::nb_transport_bw(
+        trans_t& _trans, tlm::tlm_phase& _phase, sc_time_t& _delay )
+    {
+        m_initiatorPeq.notify( _trans, _phase, _delay );
+
+        return tlm::TLM_ACCEPTED;
+    }
+
+    /************************************************************************/
+    /* AT phase handling                                                    */
+    /************************************************************************/
+    void MeshRouter::targetPhaseCallback( trans_t& _trans, const tlm::tlm_phase& _phase )
+    {
+        if ( tlm::BEGIN_REQ == _phase )
+            {
+                auto socketId = m_inSocketOf[ &_trans ];
+                auto inChannel = getInputChannel( socketId, _trans );
+                auto requestDelay = getRequestDelay( _trans );
+
+                // the payload is forwarded after it is received completely (END_REQ)
+                if ( checkForValidDataPackage( &_trans ) )
+                    {
+                        _trans.acquire( );
+                        route( _trans, requestDelay + getRoutingDelay( ), inChannel );
+                    }
+                else
+                    {
+                        returnCredit( inChannel );
+                    }
+
+                // accept request after request delay, respond after response delay
+                tlm::tlm_phase phase = tlm::END_REQ;
+                sc_time_t delay = requestDelay;
+
+                auto ext = _trans.get_extension< RoutingExt >( );
+                ext->addLatency( REQUEST_LATENCY, requestDelay );
+                ext->addLatency( RESPONSE_LATENCY, m_responseDelay );
+
+                ( *m_targetSockets[ socketId ] )->nb_transport_bw( _trans, phase, delay );
+
+                m_targetPeq.notify( _trans, tlm::BEGIN_RESP, requestDelay + m_responseDelay );
+            }
+        else if ( tlm::BEGIN_RESP == _phase )
+            {
+                auto it = m_inSocketOf.find( &_trans );
+                auto socketId = it->second;
+                m_inSocketOf.erase( it );
+
+                tlm::tlm_phase phase = tlm::BEGIN_RESP;
+                sc_time_t delay = sc_core::SC_ZERO_TIME;
+                ( *m_targetSockets[ socketId ] )->nb_transport_bw( _trans, phase, delay );
+            }
+    }
+
+    void MeshRouter::initiatorPhaseCallback( trans_t& _trans, const tlm::tlm_phase& _phase )
+    {
+        auto it = m_outSocketOf.find( &_trans );
+        if ( it == m_outSocketOf.end( ) )
+            SC_REPORT_ERROR( this->name( ), "phase for unknown transaction at outgoing link" );
+
+        auto socketId = it->second;
+
+        if ( tlm::END_REQ == _phase )
+            {
+                m_endReqEvs[ socketId ]->notify( sc_core::SC_ZERO_TIME );
+            }
+        else if ( tlm::BEGIN_RESP == _phase )
+            {
+                m_outSocketOf.erase( it );
+
+                tlm::tlm_phase phase = tlm::END_RESP;
+                sc_time_t delay = sc_core::SC_ZERO_TIME;
+                ( *m_initSockets[ socketId ] )->nb_transport_fw( _trans, phase, delay );
+
+                finishTransmission( socketId, _trans );
+            }
+    }
+}
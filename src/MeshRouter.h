@@ -0,0 +1,656 @@
+//! \file MeshRouter.h
+//! \brief Router of a two dimensional mesh network on chip
+
+#ifndef MESHROUTER_H_
+#define MESHROUTER_H_
+
+#include "Typedefinitions.h"
+#include "Interconnect_Base.h"
+#include "ObserverManager.h"
+#include "ObserverInterconnect.h"
+#include "RoutingPolicy.h"
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <tlm_utils/peq_with_get.h>
+#include <tlm_utils/peq_with_cb_and_phase.h>
+#include <tlm_utils/tlm_quantumkeeper.h>
+#include <vector>
+#include <memory>
+#include <map>
+#include <deque>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // MeshRouter
+    //!
+    //! \class MeshRouter
+    //!
+    //! \brief Router of a two dimensional mesh network on chip
+    //!
+    //! \details
+    //! Every process unit of a mesh owns one router. The router has one
+    //! initiator and one target socket per existing neighbour. The socket
+    //! index of a direction is taken from the SocketIdData of the router,
+    //! negative values mark directions without neighbour.
+    //!
+    //! Outgoing values:
+    //! For every value which has to be sent to another process unit, an
+    //! ObserverInterconnect is added by addOutgoingValue. Its id selects the
+    //! TransmissionData set (relative position and value id at the target).
+    //! If the observed value changes, a transaction is packed and routed.
+    //! With a burst window, changed values with the same destination
+    //! process unit are copied into one payload (BurstExt) until the window
+    //! expires or the burst is full, and are unpacked value by value at the
+    //! target. Payloads with a streaming width smaller than the data length
+    //! deliver every beat to the value id, and byte enables only overwrite
+    //! enabled bytes of the observed value.
+    //!
+    //! Multicast:
+    //! The Observers of one producer value at different destinations share
+    //! the data pointer of the value. With multicast enabled, all changed
+    //! Observers with the same data pointer are sent as one payload with a
+    //! MulticastExt holding the destination set. The switch stage of every
+    //! router splits the set by the XY hop of each destination and sends one
+    //! branch per outgoing link (dimension order tree). A branch with one
+    //! destination continues as unicast payload. Branches use channel zero,
+    //! and the input buffer slot of the replicated payload is held until the
+    //! first blocked branch gets output buffer space.
+    //!
+    //! Routing:
+    //! Routing is driven by the RoutingExt coordinates (x > 0 right, x < 0
+    //! left, y > 0 down, y < 0 up). The ROUTINGPOLICY selects the allowed
+    //! productive directions; the default is dimension order (XY) routing.
+    //! Adaptive policies take the candidate with the lowest local
+    //! congestion (buffered payloads and used credits of the link). Every
+    //! hop reduces the distance. If both distances are zero the target is
+    //! reached and all Observers registered for the value id (payload
+    //! address) are notified. The outSocketId of TransmissionData is not
+    //! used, because the first hop is routed like every other hop.
+    //!
+    //! Virtual channels:
+    //! Every link has m_numOfChannels virtual channels with own buffers and
+    //! credits. The channel of a hop is stored in the RoutingExt. The link
+    //! process sends round robin from channels with payload and credit, so
+    //! a blocked channel does not block the link. With MINIMAL_ADAPTIVE,
+    //! channel zero is the escape channel: a payload which finds no space in
+    //! the adaptive channels continues with XY routing in channel zero up to
+    //! its target.
+    //!
+    //! Latency:
+    //! Without link parameters every hop costs the constant routing latency
+    //! and m_commDelay (LT) or m_requestDelay (AT). setLinkParameters makes
+    //! the link delay depend on the data length of the payload (flits and
+    //! link width) and adds router pipeline stages to the routing latency,
+    //! so bursts and wide values occupy the links longer. The serialization
+    //! delay is part of the forwarding path of every hop: LT hops wait for
+    //! it before b_transport, AT hops forward at END_REQ. A burst of
+    //! sendBurst is serialized with its data length, i.e. the packed length
+    //! of all its values.
+    //!
+    //! Communication style:
+    //! - LT: blocking transport. Every hop reserves the outgoing socket by
+    //!   its SocketManager and waits routing latency plus m_commDelay.
+    //!   With temporal decoupling, hops do not wait. Routing latency and
+    //!   m_commDelay are accumulated in the b_transport delay, and every
+    //!   link process keeps its local time offset in a tlm_quantumkeeper.
+    //!   The keeper advances only by the link delay; the downstream delay
+    //!   returned by b_transport belongs to the single payload. If a hop
+    //!   downstream blocks, it consumes the offset of the link first, so
+    //!   the keeper keeps only the part of its offset not yet waited. A link
+    //!   synchronizes if the global quantum is exceeded, and a hop consumes
+    //!   its annotated delay before it blocks for a link or credit. Received
+    //!   values are copied at once and the Observer events are notified
+    //!   with the accumulated delay.
+    //! - AT: four phase non-blocking transport. The target puts BEGIN_REQ
+    //!   into a peq_with_cb_and_phase and answers END_REQ after
+    //!   m_requestDelay and BEGIN_RESP after further m_responseDelay. The
+    //!   payload is routed into the payload event queue of the next link
+    //!   at END_REQ, so every hop includes the full receive time. The
+    //!   initiator completes with END_RESP. A new request is sent after
+    //!   END_REQ of the former one, so up to the outstanding depth of the
+    //!   SocketManager transactions are pipelined per link.
+    //!
+    //! Flow control:
+    //! Routed payloads pass a switch stage. A payload enters the output
+    //! buffer (link queue) of its outgoing link if the buffer has space;
+    //! otherwise it waits in the input buffer of its incoming link, queued
+    //! per outgoing link. Every outgoing link holds credits for the input
+    //! buffer of the neighbour (CreditCounter, connected by connectCredits).
+    //! A payload is sent only with a credit. The neighbour gives the credit
+    //! back, when the payload leaves its input buffer. In LT style a hop
+    //! gives the credit back after it reserved the next link (or delivered
+    //! the payload). Time spent waiting for credits and for output buffer
+    //! space is accounted as stall. Depth zero (default) means unlimited
+    //! buffers, i.e. no backpressure.
+    /************************************************************************/
+    class MeshRouter : public sc_core::sc_module, public Interconnect_Base
+    {
+    public:
+        /************************************************************************/
+        /* type definitions                                                     */
+        /************************************************************************/
+        //! \typedef initSocket_t
+        //! \brief outgoing link
+        typedef tlm_utils::simple_initiator_socket< MeshRouter > initSocket_t;
+        //! \typedef targetSocket_t
+        //! \brief incoming link
+        typedef tlm_utils::simple_target_socket_tagged< MeshRouter > targetSocket_t;
+        //! \typedef linkQueue_t
+        //! \brief payloads waiting for a link or local delivery
+        typedef tlm_utils::peq_with_get< trans_t > linkQueue_t;
+        //! \typedef phaseQueue_t
+        //! \brief payload event queue of AT phases
+        typedef tlm_utils::peq_with_cb_and_phase< MeshRouter > phaseQueue_t;
+        //! \typedef quantumKeeper_t
+        //! \brief local time offset of a link process (temporal decoupling)
+        typedef tlm_utils::tlm_quantumkeeper quantumKeeper_t;
+
+    public:
+        SC_HAS_PROCESS( MeshRouter );
+
+        /***************************************************************/
+        // constructor:
+        //!
+        //! \brief    constructor
+        //!
+        //! \param [in] _name sc_module name
+        //! \param [in] _socketIds socket index per direction (negative = no neighbour)
+        //! \param [in] _reqDelay request delay in AT style
+        //! \param [in] _respDelay response delay in AT style
+        //! \param [in] _commDelay communication delay per hop in LT style
+        //! \param [in] _routingLatency latency of a routing decision
+        //! \param [in] _style communication style
+        //!
+        //! \note
+        //! _socketIds has to be valid during the lifetime of the router.
+        /***************************************************************/
+        explicit MeshRouter( name_t _name, const SocketIdData& _socketIds,
+            const sc_time_t& _reqDelay, const sc_time_t& _respDelay, const sc_time_t& _commDelay,
+            const sc_time_t& _routingLatency, TLMCOMMSTILE _style );
+
+        //! \brief destructor
+        virtual ~MeshRouter( ) = default;
+
+    private:
+        // forbidden constructors
+        MeshRouter( ) = delete;                                   //!< \brief forbidden
+        MeshRouter( const MeshRouter& _source ) = delete;         //!< \brief forbidden
+        MeshRouter( MeshRouter&& _source ) = delete;              //!< \brief forbidden
+        MeshRouter& operator=( const MeshRouter& _rhs ) = delete; //!< \brief forbidden
+        MeshRouter& operator=( MeshRouter&& _rhs ) = delete;      //!< \brief forbidden
+
+    public:
+        /************************************************************************/
+        // Observers
+        //! \var inputObs
+        //! \brief Observers for values which are sent to other process units
+        /************************************************************************/
+        ObserverManager< ObserverInterconnect > inputObs;
+
+    public:
+        /***************************************************************/
+        // addOutgoingValue
+        //!
+        //! \brief    add Observer for a value which is sent to another process unit
+        //!
+        //! \return   unsigned int: Observer id, also index of the TransmissionData set
+        /***************************************************************/
+        unsigned int addOutgoingValue( void );
+
+        //! \brief initiator socket of a link (socket index of SocketIdData)
+        initSocket_t& getInitiatorSocket( unsigned int _socketId );
+
+        //! \brief target socket of a link (socket index of SocketIdData)
+        targetSocket_t& getTargetSocket( unsigned int _socketId );
+
+        //! \brief number of links (neighbours)
+        unsigned int getNumberOfSockets( void ) const
+        {
+            return static_cast< unsigned int >( m_initSockets.size( ) );
+        }
+
+        /***************************************************************/
+        // notifyObservers
+        //!
+        //! \brief    notify all Observers of a received value
+        //!
+        //! \param [in] _outValueId value id at this process unit (payload address)
+        //!
+        //! \details
+        //! The data is taken from the current transaction object.
+        /***************************************************************/
+        virtual void notifyObservers( unsigned int _outValueId ) override;
+
+        /***************************************************************/
+        // setTemporalDecoupling
+        //!
+        //! \brief    switch temporal decoupling of LT transport
+        //!
+        //! \param [in] _enable true = hops accumulate their delay, false = wait per hop
+        //!
+        //! \details
+        //! The quantum is the global TLM quantum, see setGlobalQuantum.
+        //! Has to be set before the simulation starts.
+        /***************************************************************/
+        void setTemporalDecoupling( bool _enable ) { m_decoupled = _enable; }
+
+        //! \brief true if LT transport is temporally decoupled
+        bool isTemporalDecoupled( void ) const { return m_decoupled; }
+
+        //! \brief set global TLM quantum used by all decoupled routers
+        static void setGlobalQuantum( const sc_time_t& _quantum )
+        {
+            quantumKeeper_t::set_global_quantum( _quantum );
+        }
+
+        /***************************************************************/
+        // setBurstWindow
+        //!
+        //! \brief    coalesce outgoing values with the same destination
+        //!
+        //! \param [in] _window time values are collected, zero = one transaction per value
+        //! \param [in] _maxValues burst is sent if it holds _maxValues values (0 = no limit)
+        /***************************************************************/
+        void setBurstWindow( const sc_time_t& _window, unsigned int _maxValues = 0 )
+        {
+            m_burstWindow = _window;
+            m_burstMaxValues = _maxValues;
+        }
+
+        /***************************************************************/
+        // setBufferDepths
+        //!
+        //! \brief    set input and output buffer depth of all links
+        //!
+        //! \param [in] _inputDepth payloads an incoming link buffers (0 = unlimited)
+        //! \param [in] _outputDepth payloads waiting for an outgoing link (0 = unlimited)
+        //!
+        //! \details
+        //! Has to be set before the simulation starts, because connected
+        //! credit counters are reset.
+        /***************************************************************/
+        void setBufferDepths( unsigned int _inputDepth, unsigned int _outputDepth );
+
+        //! \brief set input buffer depth of incoming link _socketId (0 = unlimited)
+        void setInputBufferDepth( unsigned int _socketId, unsigned int _depth );
+
+        //! \brief set output buffer depth of outgoing link _socketId (0 = unlimited)
+        void setOutputBufferDepth( unsigned int _socketId, unsigned int _depth );
+
+        /***************************************************************/
+        // connectCredits
+        //!
+        //! \brief    connect credits of an outgoing link with the input buffer of the neighbour
+        //!
+        //! \param [in] _outSocketId outgoing link of this router
+        //! \param [in] _neighbour router bound to _outSocketId
+        //! \param [in] _inSocketId incoming link of _neighbour
+        /***************************************************************/
+        void connectCredits(
+            unsigned int _outSocketId, MeshRouter& _neighbour, unsigned int _inSocketId );
+
+        /***************************************************************/
+        // setNumberOfChannels
+        //!
+        //! \brief    set number of virtual channels per link
+        //!
+        //! \param [in] _numOfChannels virtual channels (at least one)
+        //!
+        //! \details
+        //! Buffers and credits are created again, so connectCredits has to be
+        //! called again for all links of this router and its neighbours.
+        /***************************************************************/
+        void setNumberOfChannels( unsigned int _numOfChannels );
+
+        //! \brief number of virtual channels per link
+        unsigned int getNumberOfChannels( void ) const { return m_numOfChannels; }
+
+        //! \brief set routing policy
+        void setRoutingPolicy( ROUTINGPOLICY _policy ) { m_policy = _policy; }
+
+        //! \brief return routing policy
+        ROUTINGPOLICY getRoutingPolicy( void ) const { return m_policy; }
+
+        //! \brief credits of virtual channel _vc of outgoing link _socketId
+        const CreditCounter& getCredits( unsigned int _socketId, unsigned int _vc = 0 ) const
+        {
+            sc_assert( ( _socketId < getNumberOfSockets( ) ) && ( _vc < m_numOfChannels ) );
+            return *m_outCredits[ getChannelIndex( _socketId, _vc ) ];
+        }
+
+        //! \brief time payloads waited for credits at all outgoing links
+        sc_time_t getCreditStallTime( void ) const;
+
+        //! \brief time payloads waited for output buffer space
+        const sc_time_t& getBufferStallTime( void ) const { return m_bufferStallTime; }
+
+        //! \brief number of payloads which waited for output buffer space
+        unsigned long getNumberOfBufferStalls( void ) const { return m_numOfBufferStalls; }
+
+        //! \brief send values with several destinations as one multicast payload
+        void setMulticast( bool _enable ) { m_multicast = _enable; }
+
+        //! \brief true if multicast is enabled
+        bool isMulticast( void ) const { return m_multicast; }
+
+        //! \brief number of branches created by replication of multicast payloads
+        std::size_t getNumberOfReplications( void ) const { return m_replications; }
+
+        //! \brief number of transactions started at this router
+        std::size_t getNumberOfSentTransactions( void ) const { return m_sentTransactions; }
+
+        //! \brief number of values sent by this router
+        std::size_t getNumberOfSentValues( void ) const { return m_sentValues; }
+
+        //! \brief return kind of SystemC module as string
+        virtual const char* kind( ) const override { return "MeshRouter"; }
+
+    public:
+        /************************************************************************/
+        /* TLM interface                                                        */
+        /************************************************************************/
+        //! \brief blocking transport of incoming link _id (LT style)
+        void b_transport( int _id, trans_t& _trans, sc_time_t& _delay );
+
+        //! \brief non-blocking forward transport of incoming link _id (AT style)
+        tlm::tlm_sync_enum nb_transport_fw(
+            int _id, trans_t& _trans, tlm::tlm_phase& _phase, sc_time_t& _delay );
+
+        //! \brief non-blocking backward transport of outgoing links (AT style)
+        tlm::tlm_sync_enum nb_transport_bw(
+            trans_t& _trans, tlm::tlm_phase& _phase, sc_time_t& _delay );
+
+    private:
+        //! \struct Waiting
+        //! \brief payload in an input buffer waiting for output buffer space
+        struct Waiting
+        {
+            trans_t* trans;  //!< \brief waiting payload
+            int inChannel;   //!< \brief incoming channel (negative = local process unit)
+            sc_time_t since; //!< \brief start of waiting
+        };
+
+        /***************************************************************/
+        // getOutSocketId
+        //!
+        //! \brief    routing decision for a payload of the local process unit
+        //!
+        //! \param [in] _tObjPtr transaction object with RoutingExt
+        //! \return   int: outgoing socket index or TARGET
+        /***************************************************************/
+        virtual int getOutSocketId( trans_t* _tObjPtr ) const override;
+
+        /***************************************************************/
+        // selectOutput
+        //!
+        //! \brief    routing decision and virtual channel allocation
+        //!
+        //! \param [in] _trans transaction object with RoutingExt
+        //! \param [in] _inChannel incoming channel (negative = local process unit)
+        //! \param [out] _channel outgoing channel index
+        //! \return   int: outgoing socket index or TARGET
+        //!
+        //! \details
+        //! The coordinates and the channel of the RoutingExt are updated.
+        /***************************************************************/
+        int selectOutput( trans_t& _trans, int _inChannel, unsigned int& _channel ) const;
+
+        //! \brief index of virtual channel _vc of link _socketId in channel vectors
+        unsigned int getChannelIndex( unsigned int _socketId, unsigned int _vc ) const
+        {
+            return _socketId * m_numOfChannels + _vc;
+        }
+
+        //! \brief index of incoming channel of a payload received at link _socketId
+        int getInputChannel( unsigned int _socketId, trans_t& _trans ) const;
+
+        //! \brief local congestion of outgoing link _socketId
+        unsigned int getCongestion( unsigned int _socketId ) const;
+
+        //! \brief next channel of link _socketId with payload and credit (-1 = none)
+        int selectSendChannel( unsigned int _socketId );
+
+        //! \brief return socket index of a direction and check that the link exists
+        int getDirectionSocket( int _socketId ) const;
+
+        //! \brief send changed outgoing values
+        void sendProcess( void );
+
+        //! \brief send all open bursts after the burst window
+        void burstProcess( void );
+
+        //! \brief copy outgoing value _obsId into the open burst of its destination
+        void packValue( unsigned int _obsId );
+
+        //! \brief send a burst
+        void sendBurst( trans_t& _trans );
+
+        //! \brief send outgoing value _obsId as unicast payload or into a burst
+        void sendValue( unsigned int _obsId );
+
+        //! \brief send changed values [_first, _last) of m_changedValues as one multicast
+        void sendMulticast( std::size_t _first, std::size_t _last );
+
+        //! \brief true if _trans carries a multicast destination set
+        bool isMulticastPayload( trans_t& _trans ) const
+        {
+            auto multicast = _trans.get_extension< MulticastExt >( );
+            return ( multicast != nullptr ) && !multicast->empty( );
+        }
+
+        /***************************************************************/
+        // replicate
+        //!
+        //! \brief    split a multicast payload into one branch per outgoing link
+        //!
+        //! \param [in] _trans multicast payload, released afterwards
+        //! \param [in] _inChannel incoming channel (negative = local process unit)
+        /***************************************************************/
+        void replicate( trans_t& _trans, int _inChannel );
+
+        //! \brief new payload with the data of _trans and without destination
+        trans_t* createBranch( trans_t& _trans );
+
+        //! \brief notify Observers of _valueId with one value of the current transaction
+        void notifyValue(
+            unsigned int _valueId, dataPtr_t _data, unsigned int _length, unsigned int _offset );
+
+        //! \brief transmit queued payloads over outgoing link _socketId
+        void linkProcess( unsigned int _socketId );
+
+        //! \brief deliver queued payloads to local Observers
+        void localProcess( void );
+
+        //! \brief route payload from incoming channel _inChannel (negative = local) to the switch
+        void route( trans_t& _trans, const sc_time_t& _delay, int _inChannel = -1 );
+
+        //! \brief move routed payloads into output buffers or the local queue
+        void switchProcess( void );
+
+        //! \brief true if output buffer of outgoing channel _channel has space
+        bool hasOutputSpace( unsigned int _channel ) const
+        {
+            auto depth = m_outputDepth[ _channel / m_numOfChannels ];
+            return ( 0 == depth ) || ( m_outputBuffers[ _channel ].size( ) < depth );
+        }
+
+        //! \brief true if a new payload could enter the output buffer of _channel at once
+        bool canEnterOutput( unsigned int _channel ) const
+        {
+            return m_waiting[ _channel ].empty( ) && hasOutputSpace( _channel );
+        }
+
+        //! \brief let payload wait in input buffer of _inChannel for output buffer of _channel
+        void waitForOutput( unsigned int _channel, trans_t& _trans, int _inChannel );
+
+        //! \brief put payload into output buffer of _channel and free its input buffer slot
+        void enterOutputBuffer( unsigned int _channel, trans_t& _trans, int _inChannel );
+
+        //! \brief wait for a credit of outgoing channel _channel and take it
+        void acquireCredit( unsigned int _channel );
+
+        //! \brief give credit of incoming channel _inChannel back to the neighbour
+        void returnCredit( int _inChannel );
+
+        //! \brief transmit one payload over outgoing link _socketId and release it
+        void transmit( unsigned int _socketId, trans_t& _trans );
+
+        //! \brief consume the local time offset of link _socketId before the link process blocks
+        void syncLink( unsigned int _socketId );
+
+        //! \brief wait for the annotated _delay and reset it before a blocking wait
+        void syncDelay( sc_time_t& _delay );
+
+        //! \brief _trans got its outgoing link, count the hop and its request latency _request
+        void startHop( trans_t& _trans, const sc_time_t& _request );
+
+        //! \brief AT phases received at incoming links
+        void targetPhaseCallback( trans_t& _trans, const tlm::tlm_phase& _phase );
+
+        //! \brief AT phases received at outgoing links
+        void initiatorPhaseCallback( trans_t& _trans, const tlm::tlm_phase& _phase );
+
+        //! \brief free link slot and release payload of a finished transaction
+        void finishTransmission( unsigned int _socketId, trans_t& _trans );
+
+        //! \brief notify local Observers of a received payload after _latency
+        void deliver( trans_t& _trans, const sc_time_t& _latency = sc_core::SC_ZERO_TIME );
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_sendEv
+        //! \brief notified by ObserverInterconnect if an outgoing value changed
+        event_t m_sendEv;
+        //! \var m_initSockets
+        //! \brief outgoing links (index = socket index)
+        std::vector< std::unique_ptr< initSocket_t > > m_initSockets;
+        //! \var m_targetSockets
+        //! \brief incoming links (index = socket index)
+        std::vector< std::unique_ptr< targetSocket_t > > m_targetSockets;
+        //! \var m_linkReadyEvs
+        //! \brief notified if a payload enters an output buffer (index = socket index)
+        std::vector< std::unique_ptr< event_t > > m_linkReadyEvs;
+        //! \var m_linkFreeEvs
+        //! \brief synchronization events of link processes at SocketManager
+        std::vector< std::unique_ptr< event_t > > m_linkFreeEvs;
+        //! \var m_linkKeepers
+        //! \brief local time offsets of link processes (index = socket index)
+        std::vector< std::unique_ptr< quantumKeeper_t > > m_linkKeepers;
+        //! \var m_endReqEvs
+        //! \brief notified if request phase of a link ends (index = socket index)
+        std::vector< std::unique_ptr< event_t > > m_endReqEvs;
+        //! \var m_localQueue
+        //! \brief payloads waiting for local delivery
+        linkQueue_t m_localQueue;
+        //! \var m_targetPeq
+        //! \brief AT phases of incoming links
+        phaseQueue_t m_targetPeq;
+        //! \var m_initiatorPeq
+        //! \brief AT phases of outgoing links
+        phaseQueue_t m_initiatorPeq;
+        //! \var m_inSocketOf
+        //! \brief incoming socket index of open AT transactions
+        std::map< trans_t*, unsigned int > m_inSocketOf;
+        //! \var m_outSocketOf
+        //! \brief outgoing socket index of open AT transactions
+        std::map< trans_t*, unsigned int > m_outSocketOf;
+        //! \var m_deliveryLatency
+        //! \brief notification latency of the current delivery
+        sc_time_t m_deliveryLatency;
+        //! \var m_decoupled
+        //! \brief temporal decoupling of LT transport
+        bool m_decoupled = {false};
+        //! \var m_burstWindow
+        //! \brief time outgoing values are collected in bursts
+        sc_time_t m_burstWindow;
+        //! \var m_burstMaxValues
+        //! \brief maximal number of values per burst (0 = no limit)
+        unsigned int m_burstMaxValues = {0};
+        //! \var m_burstFlushEv
+        //! \brief notified at the end of a burst window
+        event_t m_burstFlushEv;
+        //! \var m_openBursts
+        //! \brief bursts collecting values (key = relative x and y position of destination)
+        std::map< std::pair< int, int >, trans_t* > m_openBursts;
+        //! \var m_mergeBuffer
+        //! \brief buffer to merge byte enabled data with observed values
+        std::vector< unsigned char > m_mergeBuffer;
+        //! \var m_sentTransactions
+        //! \brief number of transactions started at this router
+        std::size_t m_sentTransactions = {0};
+        //! \var m_sentValues
+        //! \brief number of values sent by this router
+        std::size_t m_sentValues = {0};
+        //! \var m_multicast
+        //! \brief values with several destinations are sent as multicast
+        bool m_multicast = {false};
+        //! \var m_changedValues
+        //! \brief data pointer and Observer id of changed outgoing values
+        std::vector< std::pair< dataPtr_t, unsigned int > > m_changedValues;
+        //! \var m_branchOf
+        //! \brief branch of a multicast per outgoing link during replication
+        std::vector< trans_t* > m_branchOf;
+        //! \var m_replications
+        //! \brief number of branches created by replication
+        std::size_t m_replications = {0};
+        //! \var m_switchQueue
+        //! \brief routed payloads after routing latency
+        linkQueue_t m_switchQueue;
+        //! \var m_outputFreeEv
+        //! \brief notified if a payload leaves an output buffer
+        event_t m_outputFreeEv;
+        //! \var m_inputOf
+        //! \brief incoming link of payloads in the switch queue
+        std::map< trans_t*, int > m_inputOf;
+        //! \var m_policy
+        //! \brief routing policy
+        ROUTINGPOLICY m_policy = {XY_ROUTING};
+        //! \var m_numOfChannels
+        //! \brief virtual channels per link
+        unsigned int m_numOfChannels = {1};
+        //! \var m_waiting
+        //! \brief payloads waiting for output buffer space (index = outgoing channel)
+        std::vector< std::deque< Waiting > > m_waiting;
+        //! \var m_outputBuffers
+        //! \brief payloads waiting for an outgoing link (index = outgoing channel)
+        std::vector< std::deque< trans_t* > > m_outputBuffers;
+        //! \var m_nextChannel
+        //! \brief round robin start of channel selection (index = socket index)
+        std::vector< unsigned int > m_nextChannel;
+        //! \var m_inputDepth
+        //! \brief input buffer depth per channel (index = incoming socket index, 0 = unlimited)
+        std::vector< unsigned int > m_inputDepth;
+        //! \var m_outputDepth
+        //! \brief output buffer depth per channel (index = outgoing socket index, 0 = unlimited)
+        std::vector< unsigned int > m_outputDepth;
+        //! \var m_outCredits
+        //! \brief credits for input buffers of neighbours (index = outgoing channel)
+        std::vector< std::unique_ptr< CreditCounter > > m_outCredits;
+        //! \var m_creditReturn
+        //! \brief credits of neighbours for own input buffers (index = incoming channel)
+        std::vector< CreditCounter* > m_creditReturn;
+        //! \var m_creditBlocked
+        //! \brief true if the first payload of an output buffer waits for a credit
+        std::vector< bool > m_creditBlocked;
+        //! \var m_blockedSince
+        //! \brief start of waiting for a credit (index = outgoing channel)
+        std::vector< sc_time_t > m_blockedSince;
+        //! \var m_bufferStallTime
+        //! \brief time payloads waited for output buffer space
+        sc_time_t m_bufferStallTime;
+        //! \var m_numOfBufferStalls
+        //! \brief number of payloads which waited for output buffer space
+        unsigned long m_numOfBufferStalls = {0};
+    };
+
+
+    //! \brief return number of sockets of a SocketIdData (highest socket index + 1)
+    unsigned int getNumberOfSocketIds( const SocketIdData& _socketIds );
+}
+
+
+#endif // !MESHROUTER_H_
@@ -5,6 +5,7 @@
 #define MODVERTEX_H_
 
 #include "Task_Base.h"
+#include "Capability.h"
 #include <utility>
 #include <memory>
 #include <tuple>
@@ -132,13 +133,17 @@ namespace vc_utils
                 {
                     // parent value synchronization
                     sc_core::wait( m_exeProcEvAndList );
+                    VC_TRACE_EVENT( m_ProcessUnit, this->getVertexNumber( ), TRACE_READY );
 
                     m_ProcessUnit->isCoreUsed( &m_coreFreeEv );
                     sc_core::wait( m_coreFreeEv );
+                    VC_TRACE_EVENT( m_ProcessUnit, this->getVertexNumber( ), TRACE_START );
 
                     m_returnOneVal.second =
                         static_cast< O >( m_inputOneVal.second % m_inputTwoVal.second );
 
+                    VC_TRACE_EVENT_AT( m_ProcessUnit, this->getVertexNumber( ), TRACE_FINISH,
+                        this->getVertexLatency( ) );
                     m_ProcessUnit->freeUsedCore( this->getVertexLatency( ) );
 
                     // notify children observers for output value
@@ -225,6 +230,12 @@ namespace vc_utils
         //! \brief short description
         ProcessUnit_Base* const m_ProcessUnit;
     };
+
+    //! \brief ModVertex needs a divider
+    template < typename T, typename G, typename O > struct VertexCapability< ModVertex< T, G, O > >
+    {
+        static const capability_t value = DIV; //!< \brief needed capability class
+    };
 } // end of namespace vc_utils
 
 #endif
@@ -51,10 +51,11 @@ namespace vc_utils
         /***************************************************************/
         void notify( const sc_time_t& _latency, dataPtr_t _data, std::size_t _numOfBytes ) override
         {
-            sc_assert( ( getValuePtr( ) != nullptr ) && ( getMemSize( ) >= _numOfBytes ) );
-
             // build information tuple for data source and number of bytes has to be copied
-            auto tmp = std::make_pair( _data, _numOfBytes );
+            // (same layout as Interconnect_Base::obsSendDataVec entries)
+            auto tmp = std::make_pair( _data, static_cast< unsigned int >( _numOfBytes ) );
+
+            sc_assert( ( getValuePtr( ) != nullptr ) && ( getMemSize( ) >= sizeof( tmp ) ) );
 
             // save values in interconnect to generate external communication
             memcpy( getValuePtr( ), &tmp, sizeof( tmp ) );
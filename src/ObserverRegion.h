@@ -0,0 +1,119 @@
+//! \file ObserverRegion.h
+//! \brief specialized Observer for one element of a region of values
+
+#ifndef OBSERVERREGION_H_
+#define OBSERVERREGION_H_
+
+#include "Observer.h"
+#include <vector>
+
+namespace vc_utils
+{
+    /************************************************************************/
+    // RegionJoin
+    //!
+    //! \struct RegionJoin
+    //!
+    //! \brief joins the element notifications of a region to one event
+    //!
+    //! \details
+    //! Every element of a region is marked when its Observer is notified.
+    //! After all elements are marked, the region event is notified once and
+    //! the marks are reset for the next iteration.
+    /************************************************************************/
+    struct RegionJoin
+    {
+        //! \brief constructor
+        RegionJoin( event_t* _event, unsigned int _numOfElements )
+            : m_event( _event ), m_arrived( _numOfElements, false ), m_pending( _numOfElements )
+        {
+        }
+
+        //! \brief mark element as written and notify region event if all are written
+        void arrive( unsigned int _element, const sc_time_t& _latency )
+        {
+            if ( m_arrived[ _element ] )
+                return;
+
+            m_arrived[ _element ] = true;
+
+            if ( 0 == --m_pending )
+                {
+                    m_arrived.assign( m_arrived.size( ), false );
+                    m_pending = static_cast< unsigned int >( m_arrived.size( ) );
+                    m_event->notify( _latency );
+                }
+        }
+
+        event_t* m_event;              //!< \brief region event
+        std::vector< bool > m_arrived; //!< \brief written elements of current iteration
+        unsigned int m_pending;        //!< \brief number of elements not written yet
+    };
+
+
+    /************************************************************************/
+    // ObserverRegion
+    //!
+    //! \class ObserverRegion
+    //!
+    //! \brief specialized Observer for one element of a region of values
+    //!
+    //! \details
+    //! The observed value is copied into its element of the region. Instead
+    //! of a notification per element, the RegionJoin notifies the region
+    //! event after all elements are written.
+    /************************************************************************/
+    class ObserverRegion : public Observer
+    {
+    public:
+        //! \fn ObserverRegion
+        //! \brief constructor
+        explicit ObserverRegion( RegionJoin* _join, unsigned int _element, dataPtr_t _value,
+            unsigned int _memSize )
+            : Observer( _join->m_event, _value, _memSize ), m_join( _join ), m_element( _element )
+        {
+        }
+
+        //! \fn ObserverRegion
+        //! \brief destructor
+        ~ObserverRegion( ) = default;
+
+        /***************************************************************/
+        // notify
+        //!
+        //! \fn       notify
+        //! \brief    copy element value and mark it at the region join
+        //!
+        //! \param [in] _latency latency for region event
+        //! \param [in] _data byte pointer to copied data
+        //! \param [in] _numOfBytes number of bytes to be copied
+        /***************************************************************/
+        void notify( const sc_time_t& _latency, dataPtr_t _data, std::size_t _numOfBytes ) override
+        {
+            sc_assert( ( getValuePtr( ) != nullptr ) && ( getMemSize( ) >= _numOfBytes ) );
+
+            memcpy( getValuePtr( ), _data, _numOfBytes );
+
+            m_join->arrive( m_element, _latency );
+        }
+
+        //! \fn getElement
+        //! \brief return index of observed element in region
+        unsigned int getElement( ) const { return m_element; }
+
+    private:
+        // forbidden constructors
+        ObserverRegion( ) = delete;                                       //!< \brief forbidden
+        ObserverRegion( const ObserverRegion& _source ) = delete;         //!< \brief forbidden
+        ObserverRegion( ObserverRegion&& _source ) = delete;              //!< \brief forbidden
+        ObserverRegion& operator=( const ObserverRegion& _rhs ) = delete; //!< \brief forbidden
+        ObserverRegion& operator=( ObserverRegion&& _rhs ) = delete;      //!< \brief forbidden
+
+    private:
+        RegionJoin* m_join;     //!< \brief join of all elements of the region
+        unsigned int m_element; //!< \brief index of observed element in region
+    };
+}
+
+
+#endif // !OBSERVERREGION_H_
@@ -24,18 +24,21 @@ namespace vc_utils
     //! \brief	  	Explicit constructor
     //!
     //! \param [in]	a_name	name of payload manager
+    //! \param [in]	a_slabSize	number of payload objects created at once
     //! \return    	payload manager object
     //!
     //!
     //!	\author   	Andre Werner
     //!	\version  	2015-4-17 : initial
     /***************************************************************/
-    PayloadManager::PayloadManager( const std::string& a_name )
-        : m_name( a_name ), m_poolTobjIndex( -1 )
+    PayloadManager::PayloadManager( const std::string& a_name, unsigned int a_slabSize )
+        : m_name( a_name ),
+          m_freeList( nullptr ),
+          m_slabSize( a_slabSize ),
+          m_numOfFree( 0 ),
+          m_numOfAll( 0 )
     {
-        // generate empty payload pool
-        m_payloadFreePool.clear( );
-        m_globalPayloadPool.clear( );
+        sc_assert( 0 < m_slabSize );
     }
 
     /***************************************************************/
@@ -51,12 +54,13 @@ namespace vc_utils
     /***************************************************************/
     PayloadManager::~PayloadManager( )
     {
-        for ( auto it : m_globalPayloadPool )
-            {
-                if ( it->get_ref_count( ) )
-                    SC_REPORT_INFO( m_name.c_str( ), "Still payload objects inn use." );
-                delete it;
-            }
+        if ( m_numOfFree != m_numOfAll )
+            SC_REPORT_INFO( m_name.c_str( ), "Still payload objects inn use." );
+
+        // routing extensions are members of their payload objects
+        for ( auto& slab : m_slabs )
+            for ( unsigned int i = 0; i < m_slabSize; ++i )
+                slab[ i ].clear_extension< RoutingExt >( );
     }
 
     //===============================================================
@@ -78,18 +82,13 @@ namespace vc_utils
     //!
     //! \return    	unsigned int:	number of free payload objects
     //!
-    //!	\details
-    //!	A negative value of m_poolFreeIndex means, that no free payload
-    //!	objects available. So the number of free payload objects is zero
-    //!	or the value of the variable.
-    //!
     //!	\author   	Andre Werner
     //!	\version  	2015-4-17 : initial
     /***************************************************************/
-    unsigned int PayloadManager::getNumberOfFreeObjects( void ) const
-    {
-        return ( 0 > m_poolTobjIndex ) ? 0 : m_poolTobjIndex;
-    }
+    unsigned int PayloadManager::getNumberOfFreeObjects( void ) const { return m_numOfFree; }
+
+    //! \brief return number of all payload objects (free and in use)
+    unsigned int PayloadManager::getNumberOfObjects( void ) const { return m_numOfAll; }
 
     //===============================================================
 
@@ -103,59 +102,66 @@ namespace vc_utils
     //!
     //!	\details
     //! As long as the reference counter of the object is bigger than zero,
-    //! the payload object could be used exclusively.
+    //! the payload object could be used exclusively. The object is taken
+    //! from the free list; a new slab is created if the list is empty.
+    //! The RoutingExt of the object is already set and cleared, its
+    //! injection time is the current simulation time.
     //!
     //!	\author   	Andre Werner
     //!	\version  	2015-4-17 : initial
     /***************************************************************/
     tlm::tlm_generic_payload* PayloadManager::allocate( void )
     {
-        tlm::tlm_generic_payload* t_tObjPtr = nullptr;
-        if ( 0 > m_poolTobjIndex )
-            {
-                // generate new transport object and define it as memory managed
-                // by this (payloadManager)
-                t_tObjPtr = new tlm::tlm_generic_payload( this );
-                m_globalPayloadPool.push_back( t_tObjPtr );
-            }
-        else
-            {
-                // use free transport object and set pool index to next free
-                // object in pool
-                t_tObjPtr = m_payloadFreePool[ m_poolTobjIndex ];
-                m_payloadFreePool[ m_poolTobjIndex-- ] = nullptr;
-            }
+        if ( m_freeList == nullptr )
+            prewarm( m_slabSize );
 
-#ifndef EXTENSIONPOOL_UNSED
-        // could not save extension objects in vector compiler error!
-        RoutingExt* tmpExt = nullptr;
-        if ( 0 > m_poolExtIndex )
-            {
-                tmpExt = new RoutingExt( 0 );
-                m_globalExtPool.push_back( tmpExt );
-            }
-        else
-            {
-                tmpExt = m_freeExtPool[ m_poolExtIndex ];
-                m_freeExtPool[ m_poolExtIndex-- ] = nullptr;
-            }
-
-
-        // put extension into transaction object
-        t_tObjPtr->set_extension< RoutingExt >(tmpExt);
-#endif
-#ifdef EXTENSIONPOOL_UNSED
-
-        //alternative
-        RoutingExt* tmpExt = new RoutingExt(0);
-        t_tObjPtr->set_auto_extension< RoutingExt >(tmpExt);
-#endif
+        auto t_tObjPtr = m_freeList;
+        m_freeList = t_tObjPtr->m_next;
+        t_tObjPtr->m_next = nullptr;
+        --m_numOfFree;
 
+        t_tObjPtr->m_routingExt.setInjectionTime( sc_core::sc_time_stamp( ) );
 
+        // ids are shared by all managers, a payload passes several interconnects
+        static std::uint32_t s_nextTransactionId = 0;
+        t_tObjPtr->m_routingExt.setTransactionId( ++s_nextTransactionId );
 
         return t_tObjPtr;
     }
 
+    /***************************************************************/
+    // prewarm
+    //!
+    //! \brief	  	create free payload objects in advance
+    //!
+    //! \param [in]	a_numOfObjects	minimal number of created objects
+    //!
+    //!	\details
+    //!	Objects are created in slabs of m_slabSize payloads, so that no
+    //!	allocation happens during the simulation if the pool is warm.
+    /***************************************************************/
+    void PayloadManager::prewarm( unsigned int a_numOfObjects )
+    {
+        for ( unsigned int created = 0; created < a_numOfObjects; created += m_slabSize )
+            {
+                std::unique_ptr< PooledPayload[] > slab( new PooledPayload[ m_slabSize ] );
+
+                // link new objects in front of free list
+                for ( unsigned int i = m_slabSize; i-- > 0; )
+                    {
+                        auto& payload = slab[ i ];
+                        payload.set_mm( this );
+                        payload.set_extension< RoutingExt >( &payload.m_routingExt );
+                        payload.m_next = m_freeList;
+                        m_freeList = &payload;
+                    }
+
+                m_slabs.push_back( std::move( slab ) );
+                m_numOfFree += m_slabSize;
+                m_numOfAll += m_slabSize;
+            }
+    }
+
     /***************************************************************/
     //! \brief	  	Manage free payload object pool
     //!
@@ -164,8 +170,8 @@ namespace vc_utils
     //!
     //!	\details
     //! If reference count of a payload object is zero, these method is called
-    //! automatically. If the pool vector is empty or to short, it is increased,
-    //! else the payload object pointer is placed on the next free location.
+    //! automatically. The payload object is reset and put in front of the
+    //! free list. Its RoutingExt stays at the payload.
     //!
     //!	\author   	Andre Werner
     //!	\version  	2015-4-17 : initial
@@ -183,22 +189,23 @@ namespace vc_utils
         a_tObjPtr->set_dmi_allowed( false );
         a_tObjPtr->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE );
 
-        m_poolTobjIndex++;
-        // check if dynamic payload pool is to small and increase its size if
-        // necessary
-        if ( ( m_payloadFreePool.empty( ) ) || ( m_poolTobjIndex > m_payloadFreePool.size( ) - 1 ) )
-            m_payloadFreePool.push_back( a_tObjPtr );
-        else
-            m_payloadFreePool[ m_poolTobjIndex ] = a_tObjPtr;
-
-
-#ifndef EXTENSIONPOOL_UNSED
-        m_poolExtIndex++;
-        if ( ( m_freeExtPool.empty( ) ) || ( m_poolExtIndex > m_freeExtPool.size( ) - 1 ) )
-            m_freeExtPool.push_back( a_tObjPtr->get_extension< RoutingExt >( ) );
-        else
-            m_freeExtPool[ m_poolExtIndex ] = a_tObjPtr->get_extension< RoutingExt >( );
-#endif
+        // keep burst buffer and destination set capacity for next use
+        auto burstExt = a_tObjPtr->get_extension< BurstExt >( );
+        if ( burstExt != nullptr )
+            burstExt->clear( );
+
+        auto multicastExt = a_tObjPtr->get_extension< MulticastExt >( );
+        if ( multicastExt != nullptr )
+            multicastExt->clear( );
+
+        // only payloads of this manager are released to it
+        auto payload = static_cast< PooledPayload* >( a_tObjPtr );
+        payload->m_routingExt.clearCoodinates( );
+        payload->m_routingExt.setChannel( 0 );
+        payload->m_routingExt.clearStatistics( );
+        payload->m_next = m_freeList;
+        m_freeList = payload;
+        ++m_numOfFree;
     }
 
     //===============================================================
@@ -211,30 +218,48 @@ namespace vc_utils
     /* constructor, destructor                                              */
     /************************************************************************/
 
-    RoutingExt::RoutingExt( ) : m_xRefCoordinate( 0 ), m_yRefCoordinate( 0 ) {}
+    RoutingExt::RoutingExt( )
+        : m_xRefCoordinate( 0 ), m_yRefCoordinate( 0 ), m_channel( 0 ), m_hops( 0 ),
+          m_transactionId( 0 )
+    {
+    }
 
-    RoutingExt::RoutingExt( int _inital ) : m_xRefCoordinate( _inital ), m_yRefCoordinate( _inital )
+    RoutingExt::RoutingExt( int _inital )
+        : m_xRefCoordinate( _inital ), m_yRefCoordinate( _inital ), m_channel( 0 ), m_hops( 0 ),
+          m_transactionId( 0 )
     {
     }
 
     RoutingExt::RoutingExt( int _xInital, int _yInitial )
-        : m_xRefCoordinate( _xInital ), m_yRefCoordinate( _yInitial )
+        : m_xRefCoordinate( _xInital ), m_yRefCoordinate( _yInitial ), m_channel( 0 ), m_hops( 0 ),
+          m_transactionId( 0 )
     {
     }
 
     RoutingExt::RoutingExt( const RoutingExt& _source )
     {
-        m_xRefCoordinate = _source.getXCoordinate( );
-        m_yRefCoordinate = _source.getYCoordinate( );
+        *this = _source;
     }
 
     RoutingExt& RoutingExt::operator=( const RoutingExt& _rhs )
     {
         this->m_xRefCoordinate = _rhs.getXCoordinate( );
         this->m_yRefCoordinate = _rhs.getYCoordinate( );
+        this->m_channel = _rhs.getChannel( );
+        this->m_hops = _rhs.m_hops;
+        this->m_transactionId = _rhs.m_transactionId;
+        this->m_injectionTime = _rhs.m_injectionTime;
+        this->m_queueingStart = _rhs.m_queueingStart;
+        this->m_latencies = _rhs.m_latencies;
         return *this;
     }
 
+    void RoutingExt::clearStatistics( void )
+    {
+        m_hops = 0;
+        m_latencies.fill( sc_core::SC_ZERO_TIME );
+    }
+
 
 
     /***************************************************************/
@@ -265,7 +290,7 @@ namespace vc_utils
     /***************************************************************/
     void RoutingExt::copy_from( tlm::tlm_extension_base const& ext )
     {
-        *this = dynamic_cast< const RoutingExt& >( ext );
+        *this = static_cast< const RoutingExt& >( ext );
     }
 
     //! \brief return relative steps of coordinates (x, y)
@@ -332,4 +357,61 @@ namespace vc_utils
     }
 
 
-}
\ No newline at end of file
+
+    /************************************************************************/
+    /* burst extension implementation                                       */
+    /************************************************************************/
+
+    /***************************************************************/
+    // append
+    //!
+    //! \brief	  	append a value to the burst buffer
+    //!
+    //! \param [in]	_valueId	identification of value at destination
+    //! \param [in]	_data	begin of value
+    //! \param [in]	_length	number of bytes of value
+    /***************************************************************/
+    void BurstExt::append(
+        sc_dt::uint64 _valueId, const unsigned char* _data, unsigned int _length )
+    {
+        Entry entry;
+        entry.valueId = _valueId;
+        entry.offset = static_cast< unsigned int >( m_data.size( ) );
+        entry.length = _length;
+
+        m_entries.push_back( entry );
+        m_data.insert( m_data.end( ), _data, _data + _length );
+    }
+
+    //! \brief remove all values, the buffer capacity is kept
+    void BurstExt::clear( void )
+    {
+        m_entries.clear( );
+        m_data.clear( );
+    }
+
+    //! \brief copy of extension
+    tlm::tlm_extension_base* BurstExt::clone( ) const { return new BurstExt( *this ); }
+
+    //! \brief copy from extension
+    void BurstExt::copy_from( tlm::tlm_extension_base const& ext )
+    {
+        *this = static_cast< const BurstExt& >( ext );
+    }
+
+
+
+    /************************************************************************/
+    /* multicast extension implementation                                   */
+    /************************************************************************/
+
+    //! \brief copy of extension
+    tlm::tlm_extension_base* MulticastExt::clone( ) const { return new MulticastExt( *this ); }
+
+    //! \brief copy from extension
+    void MulticastExt::copy_from( tlm::tlm_extension_base const& ext )
+    {
+        *this = static_cast< const MulticastExt& >( ext );
+    }
+
+}
@@ -9,16 +9,17 @@
 
 #include <systemc>
 #include <tlm>
+#include "Statistics.h"
 #include <vector>
 #include <string>
 #include <utility>
-
-#define EXTENSIONPOOL_UNSED
+#include <memory>
+#include <cstdint>
 
 namespace vc_utils
 {
 
-    class RoutingExt;
+    class PooledPayload;
     /*!
     * \class PayloadManager
     *
@@ -30,6 +31,11 @@ namespace vc_utils
     * used yet, he returns the access to one of these. Otherwise he generates a
     * new one and return the access to this one.
     *
+    * Payload objects are created in slabs together with their RoutingExt
+    * (PooledPayload). The extension stays at its payload during the whole
+    * lifetime, so neither allocate nor free call new or delete after the
+    * pool is warm. Free objects are linked by an intrusive free list.
+    *
     * \note
     * Copy and move is forbidden because of the binding of transaction
     * objects to there own memory manager. So there is only one memory
@@ -46,24 +52,19 @@ namespace vc_utils
     {
     private:
         std::string m_name; /*!< \brief name of the payload manager */
-        std::vector< tlm::tlm_generic_payload* >
-            m_payloadFreePool; /*!< \brief pool of free payload objects */
-        std::vector< tlm::tlm_generic_payload* >
-            m_globalPayloadPool; /*!< \brief pool of all payload objects */
-        int m_poolTobjIndex;     /*!< \brief number of free payload objects */
-
-#ifndef EXTENSIONPOOL_UNSED
-        std::vector< RoutingExt* > m_globalExtPool; //!< \brief pool of all extensions
-        std::vector< RoutingExt* > m_freeExtPool;   //!< \brief  pool of free extensions
-        int m_poolExtIndex;        //!< number of free extensions
-#endif                 
+        std::vector< std::unique_ptr< PooledPayload[] > >
+            m_slabs;               /*!< \brief all payload objects, allocated in slabs */
+        PooledPayload* m_freeList; /*!< \brief first free payload object */
+        unsigned int m_slabSize;   /*!< \brief number of payload objects per slab */
+        unsigned int m_numOfFree;  /*!< \brief number of free payload objects */
+        unsigned int m_numOfAll;   /*!< \brief number of all payload objects */
 
 
     public:
         //========================= constructor =========================
         // constructors:
         PayloadManager( );
-        explicit PayloadManager( const std::string& a_name );
+        explicit PayloadManager( const std::string& a_name, unsigned int a_slabSize = 16 );
         virtual ~PayloadManager( );
 
         // forbidden constructors
@@ -78,12 +79,14 @@ namespace vc_utils
 
         void free( tlm::tlm_generic_payload* a_tObjPtr ) override;
         tlm::tlm_generic_payload* allocate( void );
+        void prewarm( unsigned int a_numOfObjects );
 
         //===============================================================
 
         //====================== getter and setter ======================
 
         unsigned int getNumberOfFreeObjects( void ) const;
+        unsigned int getNumberOfObjects( void ) const;
         const std::string& getName( void ) const;
 
         //===============================================================
@@ -103,7 +106,9 @@ namespace vc_utils
      * The extension stores two relative coordinate counters which describe the
      * distance between start and goal.
      * It also has methods to write and read the values and to check if target is
-     * reached easily.
+     * reached easily. Further it stores the virtual channel of the current hop.
+     * For the InterconnectStatistics it records the injection time, the
+     * number of hops and the latency parts of the transaction.
      *
      * \author Andre Werner
      * \date Juno 2015
@@ -133,6 +138,45 @@ namespace vc_utils
         void setCoodrinates( std::pair< int, int > _values );
         void clearCoodinates( void );
 
+        //! \brief return virtual channel of the current hop
+        unsigned int getChannel( void ) const { return m_channel; }
+        //! \brief set virtual channel of the next hop
+        void setChannel( unsigned int _channel ) { m_channel = _channel; }
+
+        //! \brief return number of links the transaction passed
+        unsigned int getNumberOfHops( void ) const { return m_hops; }
+        //! \brief count a passed link
+        void addHop( void ) { ++m_hops; }
+
+        //! \brief return time the payload was allocated by the source
+        const sc_core::sc_time& getInjectionTime( void ) const { return m_injectionTime; }
+        //! \brief set time the payload was allocated by the source
+        void setInjectionTime( const sc_core::sc_time& _time ) { m_injectionTime = _time; }
+
+        //! \brief return id of the transaction, unique among the allocated payloads
+        std::uint32_t getTransactionId( void ) const { return m_transactionId; }
+        //! \brief set id of the transaction
+        void setTransactionId( std::uint32_t _id ) { m_transactionId = _id; }
+
+        //! \brief return latency parts of all passed hops
+        const latencyParts_t& getLatencies( void ) const { return m_latencies; }
+        //! \brief add _time to latency part _part
+        void addLatency( LATENCY_PART _part, const sc_core::sc_time& _time )
+        {
+            m_latencies[ _part ] += _time;
+        }
+
+        //! \brief start waiting for the output of the current hop
+        void startQueueing( void ) { m_queueingStart = sc_core::sc_time_stamp( ); }
+        //! \brief stop waiting for the output, the time is added to QUEUEING_LATENCY
+        void stopQueueing( void )
+        {
+            m_latencies[ QUEUEING_LATENCY ] += sc_core::sc_time_stamp( ) - m_queueingStart;
+        }
+
+        //! \brief set hops and latency parts to zero
+        void clearStatistics( void );
+
         virtual tlm_extension_base* clone( ) const override;
 
         virtual void copy_from( tlm_extension_base const& ext ) override;
@@ -146,6 +190,181 @@ namespace vc_utils
     private:
         int m_xRefCoordinate; //!< \brief relative steps to goal in x direction
         int m_yRefCoordinate; //!< \brief relative steps to goal in y direction
+        unsigned int m_channel; //!< \brief virtual channel of the current hop
+        unsigned int m_hops;    //!< \brief number of passed links
+        std::uint32_t m_transactionId; //!< \brief id of the transaction (0 = not allocated)
+
+        sc_core::sc_time m_injectionTime; //!< \brief allocation time at the source
+        sc_core::sc_time m_queueingStart; //!< \brief begin of waiting at the current hop
+        latencyParts_t m_latencies;       //!< \brief latency parts of all passed hops
+    };
+
+
+
+    /************************************************************************/
+    /* pooled payload description                                           */
+    /************************************************************************/
+    /*!
+     * \class PooledPayload
+     *
+     * \brief payload object of a PayloadManager slab
+     *
+     * \details
+     * The RoutingExt is a member and set as (non auto) extension once, when
+     * the slab is created. The payload manager removes it before the payload
+     * is destroyed, because the payload would delete its extensions.
+     */
+    class PooledPayload : public tlm::tlm_generic_payload
+    {
+    public:
+        PooledPayload( ) = default;          //!< \brief constructor
+        virtual ~PooledPayload( ) = default; //!< \brief destructor
+
+    private:
+        // forbidden constructors
+        PooledPayload( const PooledPayload& _source ) = delete;         //!< \brief forbidden
+        PooledPayload& operator=( const PooledPayload& _rhs ) = delete; //!< \brief forbidden
+
+    private:
+        friend class PayloadManager;
+
+        RoutingExt m_routingExt;            //!< \brief routing extension of this payload
+        PooledPayload* m_next = {nullptr}; //!< \brief next free payload object
+    };
+
+
+
+    /************************************************************************/
+    /* burst extension description                                          */
+    /************************************************************************/
+    /*!
+     * \class BurstExt
+     *
+     * \brief payload extension for several values in one transaction
+     *
+     * \details
+     * The extension owns the data buffer of a burst and stores for every
+     * packed value its identification at the destination, its offset in the
+     * buffer and its size in bytes. A payload with a non empty BurstExt uses
+     * the buffer as data and is unpacked value by value at the target.
+     *
+     * The extension stays at its payload object after the first use, so the
+     * buffer capacity is reused. It is cleared when the payload is freed.
+     */
+    class BurstExt : public tlm::tlm_extension< BurstExt >
+    {
+    public:
+        //! \struct Entry
+        //! \brief one value of a burst
+        struct Entry
+        {
+            sc_dt::uint64 valueId; //!< \brief identification of value at destination
+            unsigned int offset;   //!< \brief first byte in burst buffer
+            unsigned int length;   //!< \brief number of bytes
+        };
+
+    public:
+        BurstExt( ) = default;                                 //!< \brief constructor
+        BurstExt( const BurstExt& _source ) = default;         //!< \brief constructor
+        BurstExt& operator=( const BurstExt& _rhs ) = default; //!< \brief copy
+        virtual ~BurstExt( ) = default;                        //!< \brief destructor
+
+        //! \brief append a value to the burst buffer
+        void append( sc_dt::uint64 _valueId, const unsigned char* _data, unsigned int _length );
+
+        //! \brief remove all values (buffer capacity is kept)
+        void clear( void );
+
+        //! \brief true if no value is packed
+        bool empty( void ) const { return m_entries.empty( ); }
+
+        //! \brief number of packed values
+        std::size_t size( void ) const { return m_entries.size( ); }
+
+        //! \brief packed values
+        const std::vector< Entry >& getEntries( void ) const { return m_entries; }
+
+        //! \brief begin of burst buffer
+        unsigned char* getData( void ) { return m_data.data( ); }
+
+        //! \brief number of bytes in burst buffer
+        unsigned int getLength( void ) const
+        {
+            return static_cast< unsigned int >( m_data.size( ) );
+        }
+
+        virtual tlm_extension_base* clone( ) const override;
+
+        virtual void copy_from( tlm_extension_base const& ext ) override;
+
+    private:
+        std::vector< unsigned char > m_data; //!< \brief packed values
+        std::vector< Entry > m_entries;      //!< \brief value descriptions
+    };
+
+
+
+    /************************************************************************/
+    /* multicast extension description                                      */
+    /************************************************************************/
+    /*!
+     * \class MulticastExt
+     *
+     * \brief payload extension for one value with several destinations
+     *
+     * \details
+     * The extension stores the destination set of a value: the relative
+     * position of every destination process unit from the current router
+     * and the value id at the destination. A payload with a non empty
+     * MulticastExt is replicated at the routers, every branch gets the
+     * destinations of its outgoing link.
+     *
+     * The extension stays at its payload object after the first use and is
+     * cleared when the payload is freed.
+     */
+    class MulticastExt : public tlm::tlm_extension< MulticastExt >
+    {
+    public:
+        //! \struct Destination
+        //! \brief one destination of a multicast
+        struct Destination
+        {
+            int relativXposition;  //!< \brief relative steps in x direction
+            int relativYposition;  //!< \brief relative steps in y direction
+            sc_dt::uint64 valueId; //!< \brief identification of value at destination
+        };
+
+    public:
+        MulticastExt( ) = default;                                     //!< \brief constructor
+        MulticastExt( const MulticastExt& _source ) = default;         //!< \brief constructor
+        MulticastExt& operator=( const MulticastExt& _rhs ) = default; //!< \brief copy
+        virtual ~MulticastExt( ) = default;                            //!< \brief destructor
+
+        //! \brief add a destination
+        void add( int _relativXposition, int _relativYposition, sc_dt::uint64 _valueId )
+        {
+            Destination destination = {_relativXposition, _relativYposition, _valueId};
+            m_destinations.push_back( destination );
+        }
+
+        //! \brief remove all destinations (capacity is kept)
+        void clear( void ) { m_destinations.clear( ); }
+
+        //! \brief true if no destination is set
+        bool empty( void ) const { return m_destinations.empty( ); }
+
+        //! \brief number of destinations
+        std::size_t size( void ) const { return m_destinations.size( ); }
+
+        //! \brief destination set
+        const std::vector< Destination >& getDestinations( void ) const { return m_destinations; }
+
+        virtual tlm_extension_base* clone( ) const override;
+
+        virtual void copy_from( tlm_extension_base const& ext ) override;
+
+    private:
+        std::vector< Destination > m_destinations; //!< \brief destination set
     };
 
 } // end of vc_utils
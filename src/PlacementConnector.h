@@ -0,0 +1,201 @@
+//! \file PlacementConnector.h
+//! \brief Placement aware wiring of task graph edges on a mesh
+
+#ifndef PLACEMENTCONNECTOR_H_
+#define PLACEMENTCONNECTOR_H_
+
+#include "Typedefinitions.h"
+#include "Subject.h"
+#include "MeshFabric.h"
+#include <string>
+#include <iostream>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // PlacementConnector
+    //!
+    //! \class PlacementConnector
+    //!
+    //! \brief Wire edges directly or through the mesh depending on placement
+    //!
+    //! \details
+    //! Every vertex is placed on a node of the MeshFabric, either by
+    //! addVertex (the vertex is created at the process unit of the node) or
+    //! by place for existing subjects like Memory. connect decides per edge:
+    //! - producer and consumer at the same node: the Observer of the
+    //!   consumer is registered directly at the producer, like
+    //!   ProcessUnit_Base::connect (no interconnect cost),
+    //! - different nodes: the edge is routed by MeshFabric::connectVertices.
+    //!
+    //! A remapping experiment only changes the placement before the edge
+    //! list is connected, co-located vertices never use the network. The
+    //! numbers of local and remote edges are counted for reports.
+    //!
+    //! \code
+    //! PlacementConnector< > connector( fabric );
+    //! auto a = connector.addVertex< AddVertex<> >( 1, 0, 0, "add", 0, latency );
+    //! auto b = connector.addVertex< MulVertex<> >( 2, 0, 0, "mul", 0, latency );
+    //! auto c = connector.addVertex< SubVertex<> >( 3, 1, 0, "sub", 0, latency );
+    //! connector.connect< Task_Base >( 1, a, 0, 2, b, 0 ); // local
+    //! connector.connect< Task_Base >( 2, b, 0, 3, c, 0 ); // remote
+    //! connector.print( );
+    //! \endcode
+    //!
+    //! \tparam unitT type of process unit of the MeshFabric
+    /************************************************************************/
+    template < class unitT = MeshProcessUnit > class PlacementConnector
+    {
+    public:
+        //! \brief constructor
+        explicit PlacementConnector( MeshFabric< unitT >& _fabric ) : m_fabric( _fabric ) {}
+
+        //! \brief destructor
+        ~PlacementConnector( ) = default;
+
+    private:
+        // forbidden constructors
+        PlacementConnector( ) = delete; //!< \brief forbidden
+        PlacementConnector( const PlacementConnector& _source ) = delete; //!< \brief forbidden
+        PlacementConnector& operator=(
+            const PlacementConnector& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // addVertex
+        //!
+        //! \brief    create a vertex at the process unit of node (_x, _y)
+        //!
+        //! \param [in] _id vertex id, also used as placement id
+        //! \param [in] _x x position of node
+        //! \param [in] _y y position of node
+        //! \param [in] _name sc_module name
+        //! \param [in] _color clustering color
+        //! \param [in] _latency process latency
+        //! \return   Subject*: created vertex
+        //!
+        //! \tparam vertexT type of vertex (derived from Task_Base)
+        /***************************************************************/
+        template < class vertexT >
+        Subject* addVertex( unsigned int _id, unsigned int _x, unsigned int _y,
+            const std::string& _name, unsigned int _color, const sc_time_t& _latency )
+        {
+            auto unit = m_fabric.getUnit( _x, _y );
+            unit->template addVertex< vertexT >( _id, _name, _color, _latency );
+            place( _id, _x, _y );
+
+            return unit->getVertex( _id );
+        }
+
+        //! \brief place vertex or external subject _id on node (_x, _y)
+        void place( unsigned int _id, unsigned int _x, unsigned int _y )
+        {
+            m_fabric.placeVertex( _id, _x, _y );
+        }
+
+        //! \brief true if vertices _a and _b are placed on the same node
+        bool isLocal( unsigned int _a, unsigned int _b ) const
+        {
+            const auto& table = m_fabric.getRouteTable( );
+            return table.getPlacement( _a ) == table.getPlacement( _b );
+        }
+
+        /***************************************************************/
+        // connect
+        //!
+        //! \brief    connect a producer value with a consumer Observer
+        //!
+        //! \param [in] _srcId placement id of producer
+        //! \param [in] _producer Subject which is observed
+        //! \param [in] _producerValueId observed output value of _producer
+        //! \param [in] _dstId placement id of consumer
+        //! \param [in] _consumer module which has an ObserverManager inputObs
+        //! \param [in] _consumerObsId Observer id at _consumer
+        //! \return   bool: true = local edge, false = remote edge
+        //!
+        //! \tparam nodetypeT type of _consumer that includes an ObserverManager
+        /***************************************************************/
+        template < class nodetypeT >
+        bool connect( unsigned int _srcId, Subject* _producer, unsigned int _producerValueId,
+            unsigned int _dstId, Subject* _consumer, unsigned int _consumerObsId )
+        {
+            sc_assert( ( _producer != nullptr ) && ( _consumer != nullptr ) );
+
+            auto obs =
+                static_cast< nodetypeT* >( _consumer )->inputObs.getObserver( _consumerObsId );
+
+            if ( obs == nullptr )
+                SC_REPORT_ERROR( _consumer->getName_Cstr( ), "Observer not found." );
+
+            return connectObserver( _srcId, _producer, _producerValueId, _dstId, obs );
+        }
+
+        //! \brief connect a producer value with the Observer _obs of consumer _dstId
+        bool connectObserver( unsigned int _srcId, Subject* _producer,
+            unsigned int _producerValueId, unsigned int _dstId, Observer* _obs )
+        {
+            sc_assert( ( _producer != nullptr ) && ( _obs != nullptr ) );
+
+            if ( isLocal( _srcId, _dstId ) )
+                {
+                    _producer->registerObserver( _obs, _producerValueId );
+                    ++m_numOfLocalEdges;
+                    return true;
+                }
+
+            m_fabric.connectVertices( _srcId, _producer, _producerValueId, _dstId, _obs );
+            ++m_numOfRemoteEdges;
+            return false;
+        }
+
+    public:
+        //! \brief mesh of the connector
+        MeshFabric< unitT >& getFabric( void ) const { return m_fabric; }
+
+        //! \brief number of edges wired directly
+        unsigned int getNumberOfLocalEdges( void ) const { return m_numOfLocalEdges; }
+
+        //! \brief number of edges routed through the mesh
+        unsigned int getNumberOfRemoteEdges( void ) const { return m_numOfRemoteEdges; }
+
+        //! \brief local edges per all edges (0 without edges)
+        double getLocalRatio( void ) const
+        {
+            auto numOfEdges = m_numOfLocalEdges + m_numOfRemoteEdges;
+            return ( 0 == numOfEdges ) ? 0.0
+                                       : static_cast< double >( m_numOfLocalEdges ) / numOfEdges;
+        }
+
+        //! \brief reset edge counters, e.g. before a remapping is connected
+        void resetStatistics( void )
+        {
+            m_numOfLocalEdges = 0;
+            m_numOfRemoteEdges = 0;
+        }
+
+        //! \brief print local and remote edges
+        void print( ::std::ostream& os = ::std::cout ) const
+        {
+            os << "local edges: " << m_numOfLocalEdges << ", remote edges: " << m_numOfRemoteEdges
+               << ", local ratio: " << getLocalRatio( ) << ::std::endl;
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_fabric
+        //! \brief mesh with placement and routes
+        MeshFabric< unitT >& m_fabric;
+        //! \var m_numOfLocalEdges
+        //! \brief number of edges wired directly
+        unsigned int m_numOfLocalEdges = {0};
+        //! \var m_numOfRemoteEdges
+        //! \brief number of edges routed through the mesh
+        unsigned int m_numOfRemoteEdges = {0};
+    };
+}
+
+
+#endif // !PLACEMENTCONNECTOR_H_
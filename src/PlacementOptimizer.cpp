@@ -0,0 +1,517 @@
+//! \file PlacementOptimizer.cpp
+//! \brief Simulated annealing of vertex placements on a mesh
+
+#include "PlacementOptimizer.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <cmath>
+
+namespace vc_utils
+{
+
+    PlacementOptimizer::PlacementOptimizer( unsigned int _width, unsigned int _height )
+        : m_width( _width ), m_height( _height )
+    {
+        sc_assert( ( 0 < m_width ) && ( 0 < m_height ) );
+    }
+
+    /************************************************************************/
+    /* setup                                                                */
+    /************************************************************************/
+    void PlacementOptimizer::setGraph( const GraphBuilder::EdgeList& _edges,
+        const std::vector< double >& _loads, const std::vector< unsigned int >& _placement,
+        const std::vector< bool >& _fixed )
+    {
+        auto numOfVertices = _loads.size( );
+
+        if ( _edges.rowPtr.size( ) != numOfVertices + 1 )
+            SC_REPORT_ERROR( "PlacementOptimizer", "row pointer size does not match loads" );
+        if ( ( _placement.size( ) != numOfVertices ) || ( _fixed.size( ) != numOfVertices ) )
+            SC_REPORT_ERROR( "PlacementOptimizer", "placement size does not match loads" );
+
+        m_loads = _loads;
+        m_best = _placement;
+        m_validated = false;
+        m_required.clear( );
+        m_offered.clear( );
+        m_movable.clear( );
+        m_totalLoad = 0.0;
+
+        for ( unsigned int v = 0; v < numOfVertices; ++v )
+            {
+                if ( m_best[ v ] >= m_width * m_height )
+                    SC_REPORT_ERROR( "PlacementOptimizer", "vertex placed on a not existing node" );
+
+                if ( !_fixed[ v ] )
+                    m_movable.push_back( v );
+
+                m_totalLoad += m_loads[ v ];
+            }
+
+        computeEdgeWeights( _edges );
+        m_initialCost = evaluate( m_best );
+    }
+
+    void PlacementOptimizer::setGraph(
+        const ColorMapper& _mapper, const GraphBuilder::EdgeList& _edges )
+    {
+        auto numOfVertices = static_cast< unsigned int >( _mapper.getNumberOfVertices( ) );
+        std::vector< double > loads( numOfVertices );
+        std::vector< unsigned int > placement( numOfVertices );
+        std::vector< bool > fixed( numOfVertices );
+        std::vector< capability_t > required( numOfVertices );
+        std::vector< capability_t > offered( m_width * m_height );
+
+        for ( unsigned int v = 0; v < numOfVertices; ++v )
+            {
+                loads[ v ] = _mapper.getLoadOfVertex( v );
+                placement[ v ] = _mapper.getNodeOfVertex( v );
+                fixed[ v ] = _mapper.isFixed( v );
+                required[ v ] = _mapper.getRequiredCapabilities( v );
+            }
+
+        for ( unsigned int node = 0; node < offered.size( ); ++node )
+            offered[ node ] = _mapper.getNodeCapabilities( node );
+
+        setGraph( _edges, loads, placement, fixed );
+        setCapabilities( required, offered );
+    }
+
+    void PlacementOptimizer::setCapabilities(
+        const std::vector< capability_t >& _required, const std::vector< capability_t >& _offered )
+    {
+        auto numOfNodes = m_width * m_height;
+
+        if ( ( _required.size( ) != m_loads.size( ) ) || ( _offered.size( ) != numOfNodes ) )
+            SC_REPORT_ERROR( "PlacementOptimizer", "capability size does not match graph" );
+
+        m_required = _required;
+        m_offered = _offered;
+    }
+
+    void PlacementOptimizer::setSchedule( unsigned int _numOfSteps, double _movesPerVertex )
+    {
+        sc_assert( ( 0 < _numOfSteps ) && ( 0.0 < _movesPerVertex ) );
+
+        m_numOfSteps = _numOfSteps;
+        m_movesPerVertex = _movesPerVertex;
+    }
+
+    void PlacementOptimizer::setParallelTempering( unsigned int _numOfReplicas )
+    {
+        sc_assert( 0 < _numOfReplicas );
+
+        m_numOfReplicas = _numOfReplicas;
+    }
+
+    void PlacementOptimizer::computeEdgeWeights( const GraphBuilder::EdgeList& _edges )
+    {
+        auto numOfVertices = static_cast< unsigned int >( m_loads.size( ) );
+
+        // topological order, a vertex of a cycle is taken when no vertex is ready
+        std::vector< unsigned int > inDegree( numOfVertices, 0 );
+        std::vector< unsigned int > order;
+        std::vector< unsigned int > position( numOfVertices, 0 );
+        std::vector< char > state( numOfVertices, 0 ); // 0 = new, 1 = ready, 2 = ordered
+        std::vector< unsigned int > ready;
+
+        for ( auto d : _edges.dst )
+            {
+                if ( d >= numOfVertices )
+                    SC_REPORT_ERROR( "PlacementOptimizer", "edge consumer out of range" );
+                ++inDegree[ d ];
+            }
+
+        order.reserve( numOfVertices );
+        unsigned int next = 0;
+
+        while ( order.size( ) < numOfVertices )
+            {
+                if ( ready.empty( ) )
+                    {
+                        while ( 0 != state[ next ] )
+                            ++next;
+
+                        state[ next ] = 1;
+                        ready.push_back( next );
+                    }
+
+                auto v = ready.back( );
+                ready.pop_back( );
+                state[ v ] = 2;
+                position[ v ] = static_cast< unsigned int >( order.size( ) );
+                order.push_back( v );
+
+                for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                    {
+                        auto d = _edges.dst[ e ];
+
+                        if ( ( 0 == state[ d ] ) && ( 0 == --inDegree[ d ] ) )
+                            {
+                                state[ d ] = 1;
+                                ready.push_back( d );
+                            }
+                    }
+            }
+
+        // longest path up to and from every vertex over forward edges
+        std::vector< double > top( numOfVertices, 0.0 );
+        std::vector< double > bottom( numOfVertices, 0.0 );
+        double criticalPath = 0.0;
+
+        for ( auto v : order )
+            {
+                top[ v ] += m_loads[ v ];
+                criticalPath = std::max( criticalPath, top[ v ] );
+
+                for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                    {
+                        auto d = _edges.dst[ e ];
+                        if ( position[ v ] < position[ d ] )
+                            top[ d ] = std::max( top[ d ], top[ v ] );
+                    }
+            }
+
+        for ( auto it = order.rbegin( ); it != order.rend( ); ++it )
+            {
+                auto v = *it;
+                double longest = 0.0;
+
+                for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                    {
+                        auto d = _edges.dst[ e ];
+                        if ( position[ v ] < position[ d ] )
+                            longest = std::max( longest, bottom[ d ] );
+                    }
+
+                bottom[ v ] = m_loads[ v ] + longest;
+            }
+
+        // adjacency in both directions, edges inside a vertex are free
+        m_adjRowPtr.assign( numOfVertices + 1, 0 );
+
+        for ( unsigned int v = 0; v < numOfVertices; ++v )
+            for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                {
+                    auto d = _edges.dst[ e ];
+                    if ( d == v )
+                        continue;
+
+                    ++m_adjRowPtr[ v + 1 ];
+                    ++m_adjRowPtr[ d + 1 ];
+                }
+
+        for ( unsigned int v = 0; v < numOfVertices; ++v )
+            m_adjRowPtr[ v + 1 ] += m_adjRowPtr[ v ];
+
+        m_adjVertex.resize( m_adjRowPtr.back( ) );
+        m_adjWeight.resize( m_adjRowPtr.back( ) );
+
+        std::vector< unsigned int > fill( m_adjRowPtr.begin( ), m_adjRowPtr.end( ) - 1 );
+        m_numOfEdges = 0.0;
+
+        for ( unsigned int v = 0; v < numOfVertices; ++v )
+            for ( auto e = _edges.rowPtr[ v ]; e < _edges.rowPtr[ v + 1 ]; ++e )
+                {
+                    auto d = _edges.dst[ e ];
+                    if ( d == v )
+                        continue;
+
+                    double criticality = 0.0;
+                    if ( ( 0.0 < criticalPath ) && ( position[ v ] < position[ d ] ) )
+                        criticality = ( top[ v ] + bottom[ d ] ) / criticalPath;
+
+                    auto weight = 1.0 + m_criticalPathWeight * criticality;
+                    m_numOfEdges += 1.0;
+
+                    m_adjVertex[ fill[ v ] ] = d;
+                    m_adjWeight[ fill[ v ]++ ] = weight;
+                    m_adjVertex[ fill[ d ] ] = v;
+                    m_adjWeight[ fill[ d ]++ ] = weight;
+                }
+    }
+
+    /************************************************************************/
+    /* annealing                                                            */
+    /************************************************************************/
+    void PlacementOptimizer::optimize( void )
+    {
+        if ( m_adjRowPtr.empty( ) )
+            SC_REPORT_ERROR( "PlacementOptimizer", "graph is not set" );
+
+        for ( auto v : m_movable )
+            if ( !isSupported( v, m_best[ v ] ) )
+                SC_REPORT_ERROR( "PlacementOptimizer", "start placement violates capabilities" );
+
+        auto numOfNodes = m_width * m_height;
+        m_loadScale = ( 0.0 < m_totalLoad ) ? getBalanceScale( m_balanceWeight, m_numOfEdges ) *
+                                                  numOfNodes / ( m_totalLoad * m_totalLoad )
+                                            : 0.0;
+        m_initialCost = evaluate( m_best );
+        m_numOfMoves = 0;
+        m_numOfAccepted = 0;
+        m_validated = false;
+
+        if ( m_movable.empty( ) || ( 1 == numOfNodes ) )
+            return;
+
+        std::vector< Replica > replicas( m_numOfReplicas );
+
+        for ( unsigned int r = 0; r < m_numOfReplicas; ++r )
+            {
+                auto& replica = replicas[ r ];
+                replica.nodeOf = m_best;
+                replica.nodeLoad = getNodeLoads( m_best );
+                replica.cost = m_initialCost;
+                replica.temperature = 0.0;
+                replica.random.seed( m_seed + r );
+                replica.accepted = 0;
+            }
+
+        auto startTemperature = getStartTemperature( replicas[ 0 ] );
+        auto cooling = std::pow( 1e-3, 1.0 / std::max( 1u, m_numOfSteps - 1 ) );
+        auto ladder = ( 1 < m_numOfReplicas ) ? std::pow( 1.5, 1.0 / ( m_numOfReplicas - 1 ) )
+                                              : 1.0;
+        auto numOfMoves = std::max< std::uint64_t >(
+            1, static_cast< std::uint64_t >( m_movesPerVertex * m_movable.size( ) ) );
+        auto span = std::max( m_width, m_height );
+        auto bestCost = m_initialCost;
+
+        std::mt19937 random( m_seed );
+        std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+
+        for ( unsigned int step = 0; step < m_numOfSteps; ++step )
+            {
+                auto temperature = startTemperature * std::pow( cooling, step );
+                auto window = std::ceil( span * temperature / startTemperature );
+                auto radius = std::max( 1u, static_cast< unsigned int >( window ) );
+
+                for ( unsigned int r = 0; r < m_numOfReplicas; ++r )
+                    replicas[ r ].temperature = temperature * std::pow( ladder, r );
+
+                // replica 0 runs in the calling thread
+                std::vector< std::thread > threads;
+
+                for ( unsigned int r = 1; r < m_numOfReplicas; ++r )
+                    threads.emplace_back( &PlacementOptimizer::sweep, this,
+                        std::ref( replicas[ r ] ), numOfMoves, radius );
+
+                sweep( replicas[ 0 ], numOfMoves, radius );
+
+                for ( auto& thread : threads )
+                    thread.join( );
+
+                // remove rounding errors of the incremental cost
+                for ( auto& replica : replicas )
+                    {
+                        replica.cost = evaluate( replica.nodeOf );
+
+                        if ( replica.cost < bestCost )
+                            {
+                                bestCost = replica.cost;
+                                m_best = replica.nodeOf;
+                            }
+                    }
+
+                // exchange placements of neighbouring temperatures
+                for ( unsigned int r = 0; r + 1 < m_numOfReplicas; ++r )
+                    {
+                        auto& cold = replicas[ r ];
+                        auto& hot = replicas[ r + 1 ];
+                        auto exponent = ( cold.cost - hot.cost ) *
+                                        ( 1.0 / cold.temperature - 1.0 / hot.temperature );
+
+                        if ( ( 0.0 <= exponent ) || ( uniform( random ) < std::exp( exponent ) ) )
+                            {
+                                std::swap( cold.nodeOf, hot.nodeOf );
+                                std::swap( cold.nodeLoad, hot.nodeLoad );
+                                std::swap( cold.cost, hot.cost );
+                            }
+                    }
+            }
+
+        for ( const auto& replica : replicas )
+            m_numOfAccepted += replica.accepted;
+
+        m_numOfMoves = numOfMoves * m_numOfSteps * m_numOfReplicas;
+    }
+
+    void PlacementOptimizer::sweep(
+        Replica& _replica, std::uint64_t _numOfMoves, unsigned int _radius ) const
+    {
+        std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+        std::uniform_int_distribution< std::size_t > pick( 0, m_movable.size( ) - 1 );
+
+        for ( std::uint64_t i = 0; i < _numOfMoves; ++i )
+            {
+                auto vertex = m_movable[ pick( _replica.random ) ];
+                auto node = getTarget( _replica, vertex, _radius );
+                auto current = _replica.nodeOf[ vertex ];
+
+                if ( ( node == current ) || !isSupported( vertex, node ) )
+                    continue;
+
+                auto delta = getMoveDelta( _replica, vertex, node );
+
+                if ( ( 0.0 < delta ) &&
+                     ( uniform( _replica.random ) >= std::exp( -delta / _replica.temperature ) ) )
+                    continue;
+
+                _replica.nodeLoad[ current ] -= m_loads[ vertex ];
+                _replica.nodeLoad[ node ] += m_loads[ vertex ];
+                _replica.nodeOf[ vertex ] = node;
+                _replica.cost += delta;
+                ++_replica.accepted;
+            }
+    }
+
+    unsigned int PlacementOptimizer::getTarget(
+        Replica& _replica, unsigned int _vertex, unsigned int _radius ) const
+    {
+        auto begin = m_adjRowPtr[ _vertex ];
+        auto degree = m_adjRowPtr[ _vertex + 1 ] - begin;
+
+        // half of the moves pull the vertex to a neighbour
+        if ( ( 0 < degree ) && ( 0 == ( _replica.random( ) & 1u ) ) )
+            return _replica.nodeOf[ m_adjVertex[ begin + _replica.random( ) % degree ] ];
+
+        auto current = _replica.nodeOf[ _vertex ];
+        auto x = current % m_width;
+        auto y = current / m_width;
+        auto left = ( x > _radius ) ? x - _radius : 0;
+        auto up = ( y > _radius ) ? y - _radius : 0;
+        auto right = std::min( m_width - 1, x + _radius );
+        auto low = std::min( m_height - 1, y + _radius );
+
+        x = left + _replica.random( ) % ( right - left + 1 );
+        y = up + _replica.random( ) % ( low - up + 1 );
+
+        return y * m_width + x;
+    }
+
+    double PlacementOptimizer::getMoveDelta(
+        const Replica& _replica, unsigned int _vertex, unsigned int _node ) const
+    {
+        auto current = _replica.nodeOf[ _vertex ];
+        double delta = 0.0;
+
+        for ( auto a = m_adjRowPtr[ _vertex ]; a < m_adjRowPtr[ _vertex + 1 ]; ++a )
+            {
+                auto other = _replica.nodeOf[ m_adjVertex[ a ] ];
+                delta += m_adjWeight[ a ] *
+                         ( static_cast< double >( getMeshHops( m_width, _node, other ) ) -
+                             getMeshHops( m_width, current, other ) );
+            }
+
+        // (L_current - l)^2 + (L_node + l)^2 - L_current^2 - L_node^2
+        auto load = m_loads[ _vertex ];
+        delta += m_loadScale * 2.0 * load *
+                 ( _replica.nodeLoad[ _node ] - _replica.nodeLoad[ current ] + load );
+
+        return delta;
+    }
+
+    double PlacementOptimizer::getStartTemperature( Replica& _replica ) const
+    {
+        auto numOfSamples = std::min< std::size_t >( 1000, 10 * m_movable.size( ) );
+        auto radius = std::max( m_width, m_height );
+        std::uniform_int_distribution< std::size_t > pick( 0, m_movable.size( ) - 1 );
+        double uphill = 0.0;
+        unsigned int numOfUphill = 0;
+
+        for ( std::size_t i = 0; i < numOfSamples; ++i )
+            {
+                auto vertex = m_movable[ pick( _replica.random ) ];
+                auto node = getTarget( _replica, vertex, radius );
+
+                if ( ( node == _replica.nodeOf[ vertex ] ) || !isSupported( vertex, node ) )
+                    continue;
+
+                auto delta = getMoveDelta( _replica, vertex, node );
+                if ( 0.0 < delta )
+                    {
+                        uphill += delta;
+                        ++numOfUphill;
+                    }
+            }
+
+        // exp( -average / T ) = 0.5
+        if ( 0 == numOfUphill )
+            return 1.0;
+
+        return uphill / numOfUphill / std::log( 2.0 );
+    }
+
+    /************************************************************************/
+    /* cost                                                                 */
+    /************************************************************************/
+    std::vector< double > PlacementOptimizer::getNodeLoads(
+        const std::vector< unsigned int >& _nodeOf ) const
+    {
+        std::vector< double > nodeLoad( m_width * m_height, 0.0 );
+
+        for ( unsigned int v = 0; v < _nodeOf.size( ); ++v )
+            nodeLoad[ _nodeOf[ v ] ] += m_loads[ v ];
+
+        return nodeLoad;
+    }
+
+    double PlacementOptimizer::evaluate( const std::vector< unsigned int >& _nodeOf ) const
+    {
+        double cost = 0.0;
+
+        // every edge is stored at both vertices
+        for ( unsigned int v = 0; v + 1 < m_adjRowPtr.size( ); ++v )
+            for ( auto a = m_adjRowPtr[ v ]; a < m_adjRowPtr[ v + 1 ]; ++a )
+                cost += 0.5 * m_adjWeight[ a ] *
+                        getMeshHops( m_width, _nodeOf[ v ], _nodeOf[ m_adjVertex[ a ] ] );
+
+        return cost + getBalanceScale( m_balanceWeight, m_numOfEdges ) *
+                          getImbalance( getNodeLoads( _nodeOf ) );
+    }
+
+    /************************************************************************/
+    /* validation                                                           */
+    /************************************************************************/
+    sc_time_t PlacementOptimizer::validate( const validator_t& _validator )
+    {
+        if ( !_validator )
+            SC_REPORT_ERROR( "PlacementOptimizer", "no validator given" );
+        if ( m_best.empty( ) )
+            SC_REPORT_ERROR( "PlacementOptimizer", "graph is not set" );
+
+        m_makespan = _validator( m_best );
+        m_validated = true;
+
+        return m_makespan;
+    }
+
+    void PlacementOptimizer::print( ::std::ostream& os ) const
+    {
+        os << "initial cost: " << m_initialCost << ", cost: " << getCost( )
+           << ", communication: " << getCommunicationCost( )
+           << ", imbalance: " << getImbalance( ) << ::std::endl;
+        os << "moves: " << m_numOfMoves << ", accepted: " << m_numOfAccepted << ::std::endl;
+
+        if ( m_validated )
+            os << "simulated makespan: " << m_makespan << ::std::endl;
+        else
+            os << "simulated makespan: not validated" << ::std::endl;
+    }
+
+    double PlacementOptimizer::getCommunicationCost( void ) const
+    {
+        return getCost( ) - getBalanceScale( m_balanceWeight, m_numOfEdges ) * getImbalance( );
+    }
+
+    double PlacementOptimizer::getImbalance( void ) const
+    {
+        return getImbalance( getNodeLoads( m_best ) );
+    }
+
+    double PlacementOptimizer::getImbalance( const std::vector< double >& _nodeLoad ) const
+    {
+        return getLoadImbalance( _nodeLoad, m_totalLoad );
+    }
+}
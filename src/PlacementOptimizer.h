@@ -0,0 +1,331 @@
+//! \file PlacementOptimizer.h
+//! \brief Simulated annealing of vertex placements on a mesh
+
+#ifndef PLACEMENTOPTIMIZER_H_
+#define PLACEMENTOPTIMIZER_H_
+
+#include "Typedefinitions.h"
+#include "GraphBuilder.h"
+#include "ColorMapper.h"
+#include "Capability.h"
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // PlacementOptimizer
+    //!
+    //! \class PlacementOptimizer
+    //!
+    //! \brief Improve a placement of single vertices by simulated annealing
+    //!
+    //! \details
+    //! The optimizer starts from a placement, usually the cluster mapping of
+    //! a ColorMapper, and moves single vertices between the nodes of the
+    //! mesh. The cost of a placement is
+    //!
+    //!   cost = sum of edge weight * hops + balance weight * edges * imbalance
+    //!
+    //! - hops: distance of the nodes in the mesh (XY routing, diagonal
+    //!   links with USE_EXTENDED_NETWORK),
+    //! - edge weight: 1 + critical path weight * criticality, where the
+    //!   criticality is the length of the longest path through the edge
+    //!   divided by the critical path (feedback edges are not critical),
+    //! - edges: number of edges without self loops (getBalanceScale),
+    //! - imbalance: nodes * sum of squared node loads / total load^2 - 1
+    //!   (0 = balanced), see getLoadImbalance. The ColorMapper uses the
+    //!   same imbalance and scale; with critical path weight 0 both report
+    //!   the same cost for the same placement.
+    //!
+    //! A move changes only the terms of the edges of the moved vertex and
+    //! the loads of two nodes, so its cost change is computed in
+    //! O(degree). Targets are the node of a random neighbour or a random
+    //! node in a window which shrinks with the temperature. Moves to nodes
+    //! without the capability class of the vertex are skipped.
+    //!
+    //! With more than one replica, the replicas run at a ladder of
+    //! temperatures in parallel threads (parallel tempering). After every
+    //! temperature step neighbouring replicas exchange their placements
+    //! with the Metropolis probability, so good placements of hot replicas
+    //! get refined by cold ones. The best placement of all replicas is the
+    //! result.
+    //!
+    //! validate() runs the best placement through the SystemC simulation
+    //! and print() reports the simulated makespan next to the model cost:
+    //!
+    //! \code
+    //! mapper.map( edges );
+    //! PlacementOptimizer optimizer( fabric.getWidth( ), fabric.getHeight( ) );
+    //! optimizer.setGraph( mapper, edges );
+    //! optimizer.setParallelTempering( 4 );
+    //! optimizer.optimize( );
+    //! optimizer.validate( [&]( const std::vector< unsigned int >& _placement ) {
+    //!     mapper.setPlacement( _placement );
+    //!     mapper.build( connector, edges );
+    //!     sc_core::sc_start( );
+    //!     return sc_core::sc_time_stamp( );
+    //! } );
+    //! optimizer.print( );
+    //! \endcode
+    /************************************************************************/
+    class PlacementOptimizer
+    {
+    private:
+        //! \struct Replica
+        //! \brief placement at one temperature of the ladder
+        struct Replica
+        {
+            std::vector< unsigned int > nodeOf; //!< \brief node per vertex index
+            std::vector< double > nodeLoad;     //!< \brief load per node
+            double cost;                        //!< \brief cost of placement
+            double temperature;                 //!< \brief current temperature
+            std::mt19937 random;                //!< \brief random generator of the thread
+            std::uint64_t accepted;             //!< \brief number of accepted moves
+        };
+
+    public:
+        //! \typedef validator_t
+        //! \brief simulate a placement (node per vertex index) and return its makespan
+        typedef std::function< sc_time_t( const std::vector< unsigned int >& ) > validator_t;
+
+    public:
+        //! \brief constructor for a mesh of _width x _height nodes
+        explicit PlacementOptimizer( unsigned int _width, unsigned int _height );
+
+        //! \brief destructor
+        ~PlacementOptimizer( ) = default;
+
+    private:
+        // forbidden constructors
+        PlacementOptimizer( ) = delete;                                   //!< \brief forbidden
+        PlacementOptimizer( const PlacementOptimizer& _source ) = delete; //!< \brief forbidden
+        PlacementOptimizer& operator=(
+            const PlacementOptimizer& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // setGraph
+        //!
+        //! \brief    set graph, loads and start placement
+        //!
+        //! \param [in] _edges CSR edge list over the vertex indices
+        //! \param [in] _loads load per vertex index
+        //! \param [in] _placement start node per vertex index
+        //! \param [in] _fixed true per vertex index which must not move
+        /***************************************************************/
+        void setGraph( const GraphBuilder::EdgeList& _edges, const std::vector< double >& _loads,
+            const std::vector< unsigned int >& _placement, const std::vector< bool >& _fixed );
+
+        //! \brief set graph, loads, capabilities and start placement of a mapped ColorMapper
+        void setGraph( const ColorMapper& _mapper, const GraphBuilder::EdgeList& _edges );
+
+        /***************************************************************/
+        // setCapabilities
+        //!
+        //! \brief    restrict vertices to nodes with their capability classes
+        //!
+        //! \param [in] _required needed capability classes per vertex index
+        //! \param [in] _offered offered capability classes per node index
+        /***************************************************************/
+        void setCapabilities( const std::vector< capability_t >& _required,
+            const std::vector< capability_t >& _offered );
+
+        //! \brief weight of critical edges (default 1, 0 = all edges equal), set before setGraph
+        void setCriticalPathWeight( double _weight ) { m_criticalPathWeight = _weight; }
+
+        //! \brief weight of load imbalance against communication (default 1)
+        void setBalanceWeight( double _weight ) { m_balanceWeight = _weight; }
+
+        /***************************************************************/
+        // setSchedule
+        //!
+        //! \brief    set cooling schedule
+        //!
+        //! \param [in] _numOfSteps number of temperature steps (default 100)
+        //! \param [in] _movesPerVertex moves per movable vertex and step (default 4)
+        //!
+        //! \details
+        //! The temperature starts where half of the uphill moves are
+        //! accepted and is cooled geometrically by a factor of 1000.
+        /***************************************************************/
+        void setSchedule( unsigned int _numOfSteps, double _movesPerVertex );
+
+        //! \brief number of replicas and threads (default 1 = plain annealing)
+        void setParallelTempering( unsigned int _numOfReplicas );
+
+        //! \brief seed of the random generators
+        void setSeed( unsigned int _seed ) { m_seed = _seed; }
+
+        //! \brief anneal the placement set by setGraph
+        void optimize( void );
+
+        /***************************************************************/
+        // validate
+        //!
+        //! \brief    simulate the best placement by the SystemC model
+        //!
+        //! \param [in] _validator elaborates the placement and runs sc_start
+        //! \return   sc_time_t: simulated makespan of the best placement
+        //!
+        //! \details
+        //! SystemC elaborates a model only once per process, so the
+        //! validator builds the vertices and edges of the placement, runs
+        //! the simulation and returns the time the last vertex finished.
+        //! It is usually the last step of an optimization program.
+        /***************************************************************/
+        sc_time_t validate( const validator_t& _validator );
+
+        //! \brief print costs, moves and the simulated makespan of the best placement
+        void print( ::std::ostream& os = ::std::cout ) const;
+
+    public:
+        //! \brief best node per vertex index (start placement before optimize)
+        const std::vector< unsigned int >& getPlacement( void ) const { return m_best; }
+
+        //! \brief best node of vertex index _vertex
+        unsigned int getNodeOfVertex( unsigned int _vertex ) const { return m_best.at( _vertex ); }
+
+        //! \brief cost of the start placement
+        double getInitialCost( void ) const { return m_initialCost; }
+
+        //! \brief cost of the best placement
+        double getCost( void ) const { return evaluate( m_best ); }
+
+        //! \brief sum of edge weight times hops of the best placement
+        double getCommunicationCost( void ) const;
+
+        //! \brief imbalance of the best placement (0 = balanced)
+        double getImbalance( void ) const;
+
+        //! \brief number of tried moves of the last optimize
+        std::uint64_t getNumberOfMoves( void ) const { return m_numOfMoves; }
+
+        //! \brief number of accepted moves of the last optimize
+        std::uint64_t getNumberOfAcceptedMoves( void ) const { return m_numOfAccepted; }
+
+        //! \brief true if the best placement is simulated by validate
+        bool isValidated( void ) const { return m_validated; }
+
+        //! \brief simulated makespan of the best placement (valid after validate)
+        const sc_time_t& getMakespan( void ) const { return m_makespan; }
+
+    private:
+        //! \brief edge weights by the longest paths through the edges
+        void computeEdgeWeights( const GraphBuilder::EdgeList& _edges );
+
+        //! \brief loads of all nodes of a placement
+        std::vector< double > getNodeLoads( const std::vector< unsigned int >& _nodeOf ) const;
+
+        //! \brief cost of a placement
+        double evaluate( const std::vector< unsigned int >& _nodeOf ) const;
+
+        //! \brief imbalance of node loads
+        double getImbalance( const std::vector< double >& _nodeLoad ) const;
+
+        //! \brief cost change if vertex _vertex of _replica moves to node _node
+        double getMoveDelta( const Replica& _replica, unsigned int _vertex,
+            unsigned int _node ) const;
+
+        //! \brief target node of a move of vertex _vertex
+        unsigned int getTarget(
+            Replica& _replica, unsigned int _vertex, unsigned int _radius ) const;
+
+        //! \brief start temperature where half of the sampled uphill moves are accepted
+        double getStartTemperature( Replica& _replica ) const;
+
+        //! \brief _numOfMoves Metropolis moves of one replica (thread function)
+        void sweep( Replica& _replica, std::uint64_t _numOfMoves, unsigned int _radius ) const;
+
+        //! \brief true if node _node offers the capability classes of vertex _vertex
+        bool isSupported( unsigned int _vertex, unsigned int _node ) const
+        {
+            return m_required.empty( ) ||
+                   supportsCapabilities( m_offered[ _node ], m_required[ _vertex ] );
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_width
+        //! \brief number of nodes in x direction
+        unsigned int m_width;
+        //! \var m_height
+        //! \brief number of nodes in y direction
+        unsigned int m_height;
+        //! \var m_adjRowPtr
+        //! \brief first neighbour per vertex index (+ end), edges in both directions
+        std::vector< unsigned int > m_adjRowPtr;
+        //! \var m_adjVertex
+        //! \brief neighbour vertex index per entry
+        std::vector< unsigned int > m_adjVertex;
+        //! \var m_adjWeight
+        //! \brief edge weight per entry
+        std::vector< double > m_adjWeight;
+        //! \var m_loads
+        //! \brief load per vertex index
+        std::vector< double > m_loads;
+        //! \var m_required
+        //! \brief needed capability classes per vertex index (empty = no restriction)
+        std::vector< capability_t > m_required;
+        //! \var m_offered
+        //! \brief offered capability classes per node index
+        std::vector< capability_t > m_offered;
+        //! \var m_movable
+        //! \brief vertex indices which may move
+        std::vector< unsigned int > m_movable;
+        //! \var m_best
+        //! \brief best placement
+        std::vector< unsigned int > m_best;
+        //! \var m_totalLoad
+        //! \brief load of all vertices
+        double m_totalLoad = {0.0};
+        //! \var m_numOfEdges
+        //! \brief number of edges without self loops, see getBalanceScale
+        double m_numOfEdges = {0.0};
+        //! \var m_loadScale
+        //! \brief factor of the sum of squared node loads in the cost
+        double m_loadScale = {0.0};
+        //! \var m_initialCost
+        //! \brief cost of the start placement
+        double m_initialCost = {0.0};
+        //! \var m_criticalPathWeight
+        //! \brief weight of critical edges
+        double m_criticalPathWeight = {1.0};
+        //! \var m_balanceWeight
+        //! \brief weight of load imbalance
+        double m_balanceWeight = {1.0};
+        //! \var m_numOfSteps
+        //! \brief number of temperature steps
+        unsigned int m_numOfSteps = {100};
+        //! \var m_movesPerVertex
+        //! \brief moves per movable vertex and temperature step
+        double m_movesPerVertex = {4.0};
+        //! \var m_numOfReplicas
+        //! \brief number of replicas of parallel tempering
+        unsigned int m_numOfReplicas = {1};
+        //! \var m_seed
+        //! \brief seed of the random generators
+        unsigned int m_seed = {1};
+        //! \var m_numOfMoves
+        //! \brief number of tried moves
+        std::uint64_t m_numOfMoves = {0};
+        //! \var m_numOfAccepted
+        //! \brief number of accepted moves
+        std::uint64_t m_numOfAccepted = {0};
+        //! \var m_validated
+        //! \brief true if m_makespan belongs to the best placement
+        bool m_validated = {false};
+        //! \var m_makespan
+        //! \brief simulated makespan of the best placement
+        sc_time_t m_makespan = {sc_core::SC_ZERO_TIME};
+    };
+}
+
+
+#endif // !PLACEMENTOPTIMIZER_H_
@@ -13,20 +13,32 @@ namespace vc_utils
     void ProcessUnit_Base::isCoreUsed(event_t* _event)
     {
         if (m_coreUsed)
+        {
             m_processWaitingQueue.push(_event);
+            m_requestTimes.push(sc_core::sc_time_stamp());
+            m_statistics.recordRequest(m_processWaitingQueue.size());
+        }
         else
         {
             m_coreUsed = true;
             _event->notify(sc_core::SC_ZERO_TIME);
+            m_statistics.recordRequest(0);
+            m_statistics.recordGrant(sc_core::SC_ZERO_TIME);
         }
     }
 
     void ProcessUnit_Base::freeUsedCore(const sc_time_t& _latency)
     {
+        m_statistics.recordExecution(_latency);
+
         if (!m_processWaitingQueue.empty())
         {
+            // the next request gets the core when this execution ends
             m_processWaitingQueue.front()->notify(_latency);
             m_processWaitingQueue.pop();
+            m_statistics.recordGrant(
+                sc_core::sc_time_stamp() + _latency - m_requestTimes.front());
+            m_requestTimes.pop();
         }
         else
         {
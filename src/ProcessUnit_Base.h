@@ -6,12 +6,21 @@
 
 #include "Typedefinitions.h"
 #include "Subject.h"
+#include "VertexTable.h"
+#include "Capability.h"
+#include "ExecutionTrace.h"
+#include "Statistics.h"
 #include <queue>
-#include <map>
+#include <array>
 
 
 namespace vc_utils
 {
+    /************************************************************************/
+    // declarations
+    /************************************************************************/
+    class IfVertex;
+
     /************************************************************************/
     //! \struct ProcessUnit_Base
     //!
@@ -24,6 +33,17 @@ namespace vc_utils
     //! A method for Observer connections between added tasks is also provided.
     //! A derived class has to implement memory and interconnect requirements.
     //!
+    //! A process unit offers a set of capability classes (all by default).
+    //! Vertices are only accepted if their VertexCapability is offered,
+    //! and a latency set for a class replaces the latency of its vertices.
+    //!
+    //! Every unit counts busy time, executions, queue depth and wait times
+    //! in its ProcessUnitStatistics, see writeStatisticsCsv and
+    //! writeStatisticsJson for the output at the end of the simulation.
+    //!
+    //! With USE_EXECUTION_TRACE, every unit owns a TraceBuffer. Vertices
+    //! record their events by VC_TRACE_EVENT, which is empty otherwise.
+    //!
     //!
     //! \attention
     //! If other nodes then Task_Base or IfVertex are constructed a specified
@@ -31,7 +51,7 @@ namespace vc_utils
     /************************************************************************/
     struct ProcessUnit_Base : public sc_core::sc_module
     {
-        typedef std::map< unsigned int, Subject* > vertices_t;
+        typedef VertexTable vertices_t;
         typedef std::queue< event_t* > eventQueue_t;
 
     public:
@@ -129,12 +149,11 @@ namespace vc_utils
         //! \param [in] _latency process latency of the task graph vertex
         //!
         //! \details
-        //! This function adds a vertex into the vertex map of the current process
-        //! unit.
+        //! This function adds a vertex into the vertex table of the current process
+        //! unit. The process unit owns the vertex.
         //! The vertex is described by the template parameter vertexT.
-        //! The data field is a map, so the vertex number has to be unique because it
-        //! is
-        //! used as the key of the map.
+        //! The vertex number has to be unique because it is used as index of the
+        //! vertex table. The unit has to offer the capability class of vertexT.
         //!
         //! \tparam  vertexT type of generated vertex.
         //!
@@ -145,8 +164,11 @@ namespace vc_utils
         unsigned int addVertex( unsigned int _id, const std::string _name, unsigned int _color,
             const sc_time_t& _latency )
         {
-            auto tmp = m_vertices.emplace(
-                _id, new vertexT( this, _name.c_str( ), _id, _color, _latency ) );
+            auto latency = admitVertex< vertexT >( _latency );
+
+            if ( !m_vertices.emplace(
+                     _id, new vertexT( this, _name.c_str( ), _id, _color, latency ) ) )
+                SC_REPORT_ERROR( this->name( ), "vertex id already used at process unit." );
 
             return _id;
         }
@@ -162,12 +184,11 @@ namespace vc_utils
         //! \param [in] _latency process latency of the task graph vertex
         //!
         //! \details
-        //! This function adds a vertex into the vertex map of the current process
-        //! unit.
+        //! This function adds a vertex into the vertex table of the current process
+        //! unit. The process unit owns the vertex.
         //! The vertex is described by the template parameter vertexT.
-        //! The data field is a map, so the vertex number has to be unique because it
-        //! is
-        //! used as the key of the map.
+        //! The vertex number has to be unique because it is used as index of the
+        //! vertex table.
         //!
         //! \tparam  vertexT type of generated vertex.
         //!
@@ -179,13 +200,107 @@ namespace vc_utils
             unsigned int _vertexColor, const sc_time_t& _latency, unsigned int _numOfInEdges,
             Subject* const _condition )
         {
-            auto tmp = m_vertices.emplace(
-                _vertexNumber, new vertexT( _name, this, _vertexColor, _vertexNumber, _latency,
-                                   _numOfInEdges, _condition ) );
+            auto latency = admitVertex< vertexT >( _latency );
+
+            if ( !m_vertices.emplace( _vertexNumber, new vertexT( _name, this, _vertexColor,
+                                                         _vertexNumber, latency, _numOfInEdges,
+                                                         _condition ) ) )
+                SC_REPORT_ERROR( this->name( ), "vertex id already used at process unit." );
 
             return _vertexNumber;
         }
 
+        //! \brief reserve vertex table slots for the vertices of this unit
+        //! \param [in] _numOfVertices number of vertices added to this unit
+        void reserveVertices( std::size_t _numOfVertices ) { m_vertices.reserve( _numOfVertices ); }
+
+        //! \brief return vertex with id _id or nullptr if not added to this unit
+        Subject* getVertex( unsigned int _id ) const { return m_vertices[ _id ]; }
+
+        /***************************************************************/
+        // admitVertex
+        //!
+        //! \brief    check and count a vertex of type vertexT
+        //!
+        //! \param [in] _latency process latency of the vertex
+        //! \return   sc_time_t: latency set for the capability class or _latency
+        //!
+        //! \details
+        //! Called before a vertex executed by this unit is created, also by
+        //! the then and else paths of an IfVertex. Reports an error if the
+        //! unit does not offer the capability class of vertexT.
+        //!
+        //! \tparam  vertexT type of vertex
+        /***************************************************************/
+        template < class vertexT > sc_time_t admitVertex( const sc_time_t& _latency )
+        {
+            auto capability = VertexCapability< vertexT >::value;
+
+            if ( !supportsCapabilities( m_capabilities, capability ) )
+                SC_REPORT_ERROR( this->name( ), "vertex type not supported by process unit." );
+
+            auto index = getCapabilityIndex( capability );
+            ++m_numOfVertices[ index ];
+
+            return ( sc_core::SC_ZERO_TIME != m_capabilityLatency[ index ] )
+                       ? m_capabilityLatency[ index ]
+                       : _latency;
+        }
+
+#ifdef USE_EXECUTION_TRACE
+        //! \brief record event _kind of vertex _vertexId _offset after now
+        //! (use VC_TRACE_EVENT or VC_TRACE_EVENT_AT)
+        void traceEvent( unsigned int _vertexId, TRACE_EVENT _kind,
+            const sc_time_t& _offset = sc_core::SC_ZERO_TIME )
+        {
+            m_trace.record( _vertexId, static_cast< std::uint16_t >( m_unitId ), _kind, _offset );
+        }
+#endif
+
+        /************************************************************************/
+        /* capabilities                                                         */
+        /************************************************************************/
+
+        //! \brief set offered capability classes (before vertices are added)
+        void setCapabilities( capability_t _capabilities ) { m_capabilities = _capabilities; }
+
+        //! \brief offered capability classes
+        capability_t getCapabilities( void ) const { return m_capabilities; }
+
+        //! \brief true if all classes of _capabilities are offered
+        bool supports( capability_t _capabilities ) const
+        {
+            return supportsCapabilities( m_capabilities, _capabilities );
+        }
+
+        //! \brief latency of all vertices of the single class _class (SC_ZERO_TIME = own latency)
+        void setCapabilityLatency( capability_t _class, const sc_time_t& _latency )
+        {
+            m_capabilityLatency[ getCapabilityIndex( _class ) ] = _latency;
+        }
+
+        //! \brief latency set for the single class _class (SC_ZERO_TIME = not set)
+        sc_time_t getCapabilityLatency( capability_t _class ) const
+        {
+            return m_capabilityLatency[ getCapabilityIndex( _class ) ];
+        }
+
+        //! \brief number of added vertices of the single class _class
+        unsigned int getNumberOfVertices( capability_t _class ) const
+        {
+            return m_numOfVertices[ getCapabilityIndex( _class ) ];
+        }
+
+        /************************************************************************/
+        /* statistics                                                           */
+        /************************************************************************/
+
+        //! \brief utilization and waiting counters of this unit
+        const ProcessUnitStatistics& getStatistics( void ) const { return m_statistics; }
+
+        //! \brief set all counters to zero (e.g. after a warm up phase)
+        void resetStatistics( void ) { m_statistics.reset( ); }
+
 
         /***************************************************************/
         // connect
@@ -230,9 +345,29 @@ namespace vc_utils
         //! \var m_processWaitingQueue
         //! \brief waiting queue so serialize parallel access to process unit
         eventQueue_t m_processWaitingQueue;
+        //! \var m_requestTimes
+        //! \brief time of the core request of every entry of m_processWaitingQueue
+        std::queue< sc_time_t > m_requestTimes;
         //! \var m_vertices
-        //! \brief data field with all added vertices identified by there vertex id
+        //! \brief owning table with all added vertices indexed by there vertex id
         vertices_t m_vertices;
+        //! \var m_capabilities
+        //! \brief offered capability classes
+        capability_t m_capabilities = {ALL_CAPABILITIES};
+        //! \var m_capabilityLatency
+        //! \brief latency per capability class (SC_ZERO_TIME = latency of vertex)
+        std::array< sc_time_t, NUM_OF_CAPABILITIES > m_capabilityLatency;
+        //! \var m_numOfVertices
+        //! \brief number of added vertices per capability class
+        std::array< unsigned int, NUM_OF_CAPABILITIES > m_numOfVertices = {};
+        //! \var m_statistics
+        //! \brief utilization and waiting counters
+        ProcessUnitStatistics m_statistics;
+#ifdef USE_EXECUTION_TRACE
+        //! \var m_trace
+        //! \brief buffer of execution trace events
+        TraceBuffer m_trace;
+#endif
     };
 }
 
@@ -0,0 +1,153 @@
+//! \file RouteTable.cpp
+//! \brief Generation of TransmissionData sets from placement and mesh geometry
+
+#include "RouteTable.h"
+
+namespace vc_utils
+{
+
+    RouteTableGenerator::RouteTableGenerator( unsigned int _width, unsigned int _height )
+        : m_width( _width ),
+          m_height( _height ),
+          m_socketIds( _width * _height ),
+          m_routes( _width * _height ),
+          m_nextValueId( _width * _height, 0 )
+    {
+        sc_assert( ( 0 < m_width ) && ( 0 < m_height ) );
+
+        // number sockets of existing neighbours
+        for ( unsigned int y = 0; y < m_height; ++y )
+            for ( unsigned int x = 0; x < m_width; ++x )
+                {
+                    int socketId = 0;
+                    auto& ids = m_socketIds[ getNodeIndex( x, y ) ];
+                    ids.left = ( 0 < x ) ? socketId++ : -1;
+                    ids.right = ( x + 1 < m_width ) ? socketId++ : -1;
+                    ids.up = ( 0 < y ) ? socketId++ : -1;
+                    ids.down = ( y + 1 < m_height ) ? socketId++ : -1;
+#ifdef USE_EXTENDED_NETWORK
+                    bool right = ( x + 1 < m_width );
+                    bool low = ( y + 1 < m_height );
+                    ids.upright = ( right && ( 0 < y ) ) ? socketId++ : -1;
+                    ids.upleft = ( ( 0 < x ) && ( 0 < y ) ) ? socketId++ : -1;
+                    ids.lowright = ( right && low ) ? socketId++ : -1;
+                    ids.lowleft = ( ( 0 < x ) && low ) ? socketId++ : -1;
+#endif
+                }
+    }
+
+    void RouteTableGenerator::place( unsigned int _vertexId, unsigned int _node )
+    {
+        if ( getNumberOfNodes( ) <= _node )
+            SC_REPORT_ERROR( "RouteTableGenerator", "vertex placed on a not existing node" );
+
+        if ( m_placement.size( ) <= _vertexId )
+            m_placement.resize( _vertexId + 1, -1 );
+
+        m_placement[ _vertexId ] = static_cast< int >( _node );
+    }
+
+    bool RouteTableGenerator::isPlaced( unsigned int _vertexId ) const
+    {
+        return ( _vertexId < m_placement.size( ) ) && ( 0 <= m_placement[ _vertexId ] );
+    }
+
+    unsigned int RouteTableGenerator::getPlacement( unsigned int _vertexId ) const
+    {
+        if ( !isPlaced( _vertexId ) )
+            SC_REPORT_ERROR( "RouteTableGenerator", "vertex is not placed" );
+
+        return static_cast< unsigned int >( m_placement[ _vertexId ] );
+    }
+
+    RouteTableGenerator::Route RouteTableGenerator::connect(
+        unsigned int _srcVertexId, unsigned int _srcValueId, unsigned int _dstVertexId )
+    {
+        auto key = ( static_cast< std::uint64_t >( _srcVertexId ) << 32 ) | _srcValueId;
+
+        return addRoute(
+            getPlacement( _srcVertexId ), getPlacement( _dstVertexId ), key, ROUTE_KEY_VERTEX );
+    }
+
+    RouteTableGenerator::Route RouteTableGenerator::addRoute( unsigned int _srcNode,
+        unsigned int _dstNode, std::uint64_t _sourceKey, ROUTE_KEY _keySpace )
+    {
+        if ( ( getNumberOfNodes( ) <= _srcNode ) || ( getNumberOfNodes( ) <= _dstNode ) )
+            SC_REPORT_ERROR( "RouteTableGenerator", "route to a not existing node" );
+        if ( _srcNode == _dstNode )
+            SC_REPORT_ERROR( "RouteTableGenerator", "edge inside a node needs no route" );
+
+        auto& routes = m_routes[ _srcNode ];
+        auto index = static_cast< unsigned int >( routes.size( ) );
+        auto inserted = m_routeOf.insert( std::make_pair(
+            std::make_tuple( _srcNode, _keySpace, _sourceKey, _dstNode ), index ) );
+
+        // value is already sent to this node
+        if ( !inserted.second )
+            {
+                auto route = routes[ inserted.first->second ];
+                route.created = false;
+                return route;
+            }
+
+        Route route;
+        route.srcNode = _srcNode;
+        route.obsId = index;
+        route.dstNode = _dstNode;
+        route.destValueId = m_nextValueId[ _dstNode ]++;
+        route.created = true;
+
+        routes.push_back( route );
+        return route;
+    }
+
+    RouteCache RouteTableGenerator::build( void ) const
+    {
+        RouteCache cache;
+        cache.m_rowPtr.assign( getNumberOfNodes( ) + 1, 0 );
+
+        for ( unsigned int node = 0; node < getNumberOfNodes( ); ++node )
+            cache.m_rowPtr[ node + 1 ] =
+                cache.m_rowPtr[ node ] + static_cast< unsigned int >( m_routes[ node ].size( ) );
+
+        cache.m_routes.reserve( cache.m_rowPtr.back( ) );
+
+        for ( unsigned int node = 0; node < getNumberOfNodes( ); ++node )
+            for ( const auto& route : m_routes[ node ] )
+                {
+                    TransmissionData data;
+                    data.relativXposition = static_cast< int >( route.dstNode % m_width ) -
+                                            static_cast< int >( route.srcNode % m_width );
+                    data.relativYposition = static_cast< int >( route.dstNode / m_width ) -
+                                            static_cast< int >( route.srcNode / m_width );
+                    data.destValueId = route.destValueId;
+                    data.outSocketId =
+                        getFirstHop( node, data.relativXposition, data.relativYposition );
+
+                    cache.m_routes.push_back( data );
+                }
+
+        return cache;
+    }
+
+    void RouteTableGenerator::clearRoutes( void )
+    {
+        for ( auto& routes : m_routes )
+            routes.clear( );
+
+        m_nextValueId.assign( m_nextValueId.size( ), 0 );
+        m_routeOf.clear( );
+    }
+
+    int RouteTableGenerator::getFirstHop( unsigned int _node, int _x, int _y ) const
+    {
+        const auto& ids = m_socketIds[ _node ];
+
+        if ( 0 != _x )
+            return ( 0 < _x ) ? ids.right : ids.left;
+        if ( 0 != _y )
+            return ( 0 < _y ) ? ids.down : ids.up;
+
+        return TARGET;
+    }
+}
@@ -0,0 +1,248 @@
+//! \file RouteTable.h
+//! \brief Generation of TransmissionData sets from placement and mesh geometry
+
+#ifndef ROUTETABLE_H_
+#define ROUTETABLE_H_
+
+#include "Typedefinitions.h"
+#include "Interconnect_Base.h"
+#include <vector>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <cstdint>
+
+namespace vc_utils
+{
+    /************************************************************************/
+    /* enumerations                                                         */
+    /************************************************************************/
+    //! \enum ROUTE_KEY
+    //! \brief Identification space of the source key of a route
+    enum ROUTE_KEY : unsigned int {
+        ROUTE_KEY_VERTEX = 0,  //!< \brief vertex id << 32 | value id
+        ROUTE_KEY_SUBJECT = 1, //!< \brief subject id << 32 | value id
+    };
+
+
+    /************************************************************************/
+    // RouteCache
+    //!
+    //! \class RouteCache
+    //!
+    //! \brief Invariant TransmissionData sets of all nodes
+    //!
+    //! \details
+    //! All sets are stored in one array (compressed rows, one row per node).
+    //! The set of an outgoing value is found by node and Observer id in
+    //! constant time. A router gets access to its row by
+    //! Interconnect_Base::setRouteCache.
+    /************************************************************************/
+    class RouteCache
+    {
+    public:
+        //! \brief constructor of an empty cache
+        RouteCache( ) : m_rowPtr( 1, 0 ) {}
+
+        //! \brief number of nodes
+        unsigned int getNumberOfNodes( void ) const
+        {
+            return static_cast< unsigned int >( m_rowPtr.size( ) - 1 );
+        }
+
+        //! \brief first TransmissionData set of _node
+        const TransmissionData* getRoutes( unsigned int _node ) const
+        {
+            sc_assert( _node < getNumberOfNodes( ) );
+            return m_routes.data( ) + m_rowPtr[ _node ];
+        }
+
+        //! \brief number of TransmissionData sets of _node
+        unsigned int getNumberOfRoutes( unsigned int _node ) const
+        {
+            sc_assert( _node < getNumberOfNodes( ) );
+            return m_rowPtr[ _node + 1 ] - m_rowPtr[ _node ];
+        }
+
+        //! \brief TransmissionData set of Observer _obsId at _node
+        const TransmissionData& at( unsigned int _node, unsigned int _obsId ) const
+        {
+            sc_assert( _obsId < getNumberOfRoutes( _node ) );
+            return m_routes[ m_rowPtr[ _node ] + _obsId ];
+        }
+
+    private:
+        friend class RouteTableGenerator;
+
+        std::vector< unsigned int > m_rowPtr;     //!< \brief first set of node, size = nodes + 1
+        std::vector< TransmissionData > m_routes; //!< \brief sets of all nodes
+    };
+
+
+    /************************************************************************/
+    // RouteTableGenerator
+    //!
+    //! \class RouteTableGenerator
+    //!
+    //! \brief Derive TransmissionData sets from placement and mesh geometry
+    //!
+    //! \details
+    //! The mesh has width x height nodes. Node (x, y) has the index
+    //! y * width + x. The generator numbers the sockets of every node
+    //! (left, right, up, down and with USE_EXTENDED_NETWORK upright, upleft,
+    //! lowright, lowleft for existing neighbours) and computes the
+    //! relative position and the first XY hop of every route.
+    //!
+    //! Vertices are placed on nodes by place(). connect() adds a remote edge
+    //! between two placed vertices, addRoute() adds it by nodes. A value is
+    //! sent once per destination node: edges of the same source value to
+    //! several consumers at one node share the route and the destination
+    //! value id. build() returns the sets of all nodes as RouteCache, where
+    //! the Observer id of a route is the index in the row of its source node.
+    //!
+    //! A Route keeps the source and destination node resolved when the edge
+    //! is added; build() does not read the placement again. A remapping
+    //! experiment therefore changes the placement, calls clearRoutes() and
+    //! connects the edge list again before build().
+    /************************************************************************/
+    class RouteTableGenerator
+    {
+    public:
+        //! \struct Route
+        //! \brief result of adding an edge
+        struct Route
+        {
+            unsigned int srcNode;     //!< \brief node of producer
+            unsigned int obsId;       //!< \brief Observer id at router of srcNode
+            unsigned int dstNode;     //!< \brief node of consumer
+            unsigned int destValueId; //!< \brief value id at router of dstNode
+            bool created;             //!< \brief false if an existing route is shared
+        };
+
+    public:
+        //! \brief constructor
+        explicit RouteTableGenerator( unsigned int _width, unsigned int _height );
+
+        //! \brief destructor
+        virtual ~RouteTableGenerator( ) = default;
+
+    private:
+        // forbidden constructors
+        RouteTableGenerator( ) = delete; //!< \brief forbidden
+        RouteTableGenerator( const RouteTableGenerator& _source ) = delete; //!< \brief forbidden
+        RouteTableGenerator& operator=(
+            const RouteTableGenerator& _rhs ) = delete; //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // place
+        //!
+        //! \brief    place a vertex on a node
+        //!
+        //! \param [in] _vertexId identification of vertex
+        //! \param [in] _node node index
+        /***************************************************************/
+        void place( unsigned int _vertexId, unsigned int _node );
+
+        //! \brief return node of a placed vertex
+        unsigned int getPlacement( unsigned int _vertexId ) const;
+
+        //! \brief true if vertex is placed
+        bool isPlaced( unsigned int _vertexId ) const;
+
+        /***************************************************************/
+        // connect
+        //!
+        //! \brief    add a remote edge between two placed vertices
+        //!
+        //! \param [in] _srcVertexId producer vertex
+        //! \param [in] _srcValueId observed output value of producer
+        //! \param [in] _dstVertexId consumer vertex
+        //! \return   Route: route of the edge
+        /***************************************************************/
+        Route connect( unsigned int _srcVertexId, unsigned int _srcValueId,
+            unsigned int _dstVertexId );
+
+        /***************************************************************/
+        // addRoute
+        //!
+        //! \brief    add a route between two nodes
+        //!
+        //! \param [in] _srcNode node of producer
+        //! \param [in] _dstNode node of consumer
+        //! \param [in] _sourceKey identification of sent value, unique in _keySpace
+        //! \param [in] _keySpace identification space of _sourceKey
+        //! \return   Route: new route or the existing route of the value to _dstNode
+        //!
+        //! \details
+        //! A route is shared if source node, key space, source key and
+        //! destination node are equal. Keys of different spaces never match,
+        //! so vertex ids of connect() and subject ids may overlap.
+        /***************************************************************/
+        Route addRoute( unsigned int _srcNode, unsigned int _dstNode, std::uint64_t _sourceKey,
+            ROUTE_KEY _keySpace = ROUTE_KEY_VERTEX );
+
+        //! \brief compute TransmissionData sets of all nodes
+        RouteCache build( void ) const;
+
+        //! \brief remove all routes, placement and geometry are kept
+        void clearRoutes( void );
+
+    public:
+        //! \brief return node index of position
+        unsigned int getNodeIndex( unsigned int _x, unsigned int _y ) const
+        {
+            sc_assert( ( _x < m_width ) && ( _y < m_height ) );
+            return _y * m_width + _x;
+        }
+
+        //! \brief socket numbering of a node
+        const SocketIdData& getSocketIdData( unsigned int _node ) const
+        {
+            return m_socketIds.at( _node );
+        }
+
+        //! \brief socket of first XY hop or TARGET
+        int getFirstHop( unsigned int _node, int _x, int _y ) const;
+
+        //! \brief number of nodes
+        unsigned int getNumberOfNodes( void ) const { return m_width * m_height; }
+
+        //! \brief number of nodes in x direction
+        unsigned int getWidth( void ) const { return m_width; }
+
+        //! \brief number of nodes in y direction
+        unsigned int getHeight( void ) const { return m_height; }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_width
+        //! \brief number of nodes in x direction
+        unsigned int m_width;
+        //! \var m_height
+        //! \brief number of nodes in y direction
+        unsigned int m_height;
+        //! \var m_socketIds
+        //! \brief socket numbering per node
+        std::vector< SocketIdData > m_socketIds;
+        //! \var m_placement
+        //! \brief node of vertex (index = vertex id, -1 = not placed)
+        std::vector< int > m_placement;
+        //! \var m_routes
+        //! \brief routes per source node (index = Observer id)
+        std::vector< std::vector< Route > > m_routes;
+        //! \var m_nextValueId
+        //! \brief next free value id per destination node
+        std::vector< unsigned int > m_nextValueId;
+        //! \var m_routeOf
+        //! \brief route index at source node of (source node, key space, source key,
+        //! destination node)
+        std::map< std::tuple< unsigned int, ROUTE_KEY, std::uint64_t, unsigned int >, unsigned int >
+            m_routeOf;
+    };
+}
+
+
+#endif // !ROUTETABLE_H_
@@ -0,0 +1,205 @@
+//! \file RoutingPolicy.cpp
+//! \brief Routing policies of the mesh network on chip and their deadlock check
+
+#include "RoutingPolicy.h"
+#include <vector>
+#include <utility>
+
+namespace vc_utils
+{
+    const char* getRoutingPolicyName( ROUTINGPOLICY _policy )
+    {
+        switch ( _policy )
+            {
+            case XY_ROUTING: return "XY_ROUTING";
+            case WEST_FIRST: return "WEST_FIRST";
+            case MINIMAL_ADAPTIVE: return "MINIMAL_ADAPTIVE";
+            default: return "unknown";
+            }
+    }
+
+    unsigned int getRoutingCandidates(
+        ROUTINGPOLICY _policy, int _x, int _y, DIRECTION* _candidates )
+    {
+        unsigned int num = 0;
+
+        if ( ( 0 == _x ) && ( 0 == _y ) )
+            return num;
+
+        switch ( _policy )
+            {
+            case XY_ROUTING:
+                if ( 0 != _x )
+                    _candidates[ num++ ] = ( 0 < _x ) ? EAST : WEST;
+                else
+                    _candidates[ num++ ] = ( 0 < _y ) ? SOUTH : NORTH;
+                break;
+
+            case WEST_FIRST:
+                // all hops to the west first
+                if ( 0 > _x )
+                    {
+                        _candidates[ num++ ] = WEST;
+                        break;
+                    }
+#ifdef USE_EXTENDED_NETWORK
+                if ( ( 0 < _x ) && ( 0 != _y ) )
+                    _candidates[ num++ ] = ( 0 < _y ) ? SOUTHEAST : NORTHEAST;
+#endif
+                if ( 0 < _x )
+                    _candidates[ num++ ] = EAST;
+                if ( 0 != _y )
+                    _candidates[ num++ ] = ( 0 < _y ) ? SOUTH : NORTH;
+                break;
+
+            case MINIMAL_ADAPTIVE:
+#ifdef USE_EXTENDED_NETWORK
+                if ( ( 0 != _x ) && ( 0 != _y ) )
+                    {
+                        if ( 0 < _x )
+                            _candidates[ num++ ] = ( 0 < _y ) ? SOUTHEAST : NORTHEAST;
+                        else
+                            _candidates[ num++ ] = ( 0 < _y ) ? SOUTHWEST : NORTHWEST;
+                    }
+#endif
+                if ( 0 != _x )
+                    _candidates[ num++ ] = ( 0 < _x ) ? EAST : WEST;
+                if ( 0 != _y )
+                    _candidates[ num++ ] = ( 0 < _y ) ? SOUTH : NORTH;
+                break;
+            }
+
+        return num;
+    }
+
+    void getDirectionOffset( DIRECTION _dir, int& _dx, int& _dy )
+    {
+        _dx = 0;
+        _dy = 0;
+
+        switch ( _dir )
+            {
+            case WEST: _dx = -1; break;
+            case EAST: _dx = 1; break;
+            case NORTH: _dy = -1; break;
+            case SOUTH: _dy = 1; break;
+#ifdef USE_EXTENDED_NETWORK
+            case NORTHEAST:
+                _dx = 1;
+                _dy = -1;
+                break;
+            case NORTHWEST:
+                _dx = -1;
+                _dy = -1;
+                break;
+            case SOUTHEAST:
+                _dx = 1;
+                _dy = 1;
+                break;
+            case SOUTHWEST:
+                _dx = -1;
+                _dy = 1;
+                break;
+#endif
+            default: SC_REPORT_ERROR( "RoutingPolicy", "unknown direction" );
+            }
+    }
+
+    int getDirectionSocketId( const SocketIdData& _socketIds, DIRECTION _dir )
+    {
+        switch ( _dir )
+            {
+            case WEST: return _socketIds.left;
+            case EAST: return _socketIds.right;
+            case NORTH: return _socketIds.up;
+            case SOUTH: return _socketIds.down;
+#ifdef USE_EXTENDED_NETWORK
+            case NORTHEAST: return _socketIds.upright;
+            case NORTHWEST: return _socketIds.upleft;
+            case SOUTHEAST: return _socketIds.lowright;
+            case SOUTHWEST: return _socketIds.lowleft;
+#endif
+            default: return -1;
+            }
+    }
+
+    bool isDeadlockFree( ROUTINGPOLICY _policy, unsigned int _width, unsigned int _height )
+    {
+        const int width = static_cast< int >( _width );
+        const int height = static_cast< int >( _height );
+        const unsigned int numOfChannels = _width * _height * NUMOFDIRECTIONS;
+
+        auto channel = [&]( int _x, int _y, DIRECTION _dir ) {
+            return static_cast< unsigned int >( ( _y * width + _x ) * NUMOFDIRECTIONS + _dir );
+        };
+
+        // build channel dependency graph
+        std::vector< std::vector< unsigned int > > successors( numOfChannels );
+        DIRECTION first[ NUMOFDIRECTIONS ];
+        DIRECTION second[ NUMOFDIRECTIONS ];
+
+        for ( int y = 0; y < height; ++y )
+            for ( int x = 0; x < width; ++x )
+                for ( int ry = -2; ry <= 2; ++ry )
+                    for ( int rx = -2; rx <= 2; ++rx )
+                        {
+                            if ( ( x + rx < 0 ) || ( x + rx >= width ) || ( y + ry < 0 ) ||
+                                 ( y + ry >= height ) )
+                                continue;
+
+                            auto numOfFirst = getRoutingCandidates( _policy, rx, ry, first );
+
+                            for ( unsigned int i = 0; i < numOfFirst; ++i )
+                                {
+                                    int dx = 0;
+                                    int dy = 0;
+                                    getDirectionOffset( first[ i ], dx, dy );
+
+                                    auto numOfSecond = getRoutingCandidates(
+                                        _policy, rx - dx, ry - dy, second );
+
+                                    for ( unsigned int j = 0; j < numOfSecond; ++j )
+                                        successors[ channel( x, y, first[ i ] ) ].push_back(
+                                            channel( x + dx, y + dy, second[ j ] ) );
+                                }
+                        }
+
+        // depth first search for a cycle (0 = unvisited, 1 = on stack, 2 = done)
+        std::vector< unsigned char > state( numOfChannels, 0 );
+        std::vector< std::pair< unsigned int, unsigned int > > stack;
+
+        for ( unsigned int start = 0; start < numOfChannels; ++start )
+            {
+                if ( 0 != state[ start ] )
+                    continue;
+
+                state[ start ] = 1;
+                stack.emplace_back( start, 0 );
+
+                while ( !stack.empty( ) )
+                    {
+                        auto& top = stack.back( );
+
+                        if ( top.second == successors[ top.first ].size( ) )
+                            {
+                                state[ top.first ] = 2;
+                                stack.pop_back( );
+                                continue;
+                            }
+
+                        auto next = successors[ top.first ][ top.second++ ];
+
+                        if ( 1 == state[ next ] )
+                            return false;
+
+                        if ( 0 == state[ next ] )
+                            {
+                                state[ next ] = 1;
+                                stack.emplace_back( next, 0 );
+                            }
+                    }
+            }
+
+        return true;
+    }
+}
@@ -0,0 +1,118 @@
+//! \file RoutingPolicy.h
+//! \brief Routing policies of the mesh network on chip and their deadlock check
+
+#ifndef ROUTINGPOLICY_H_
+#define ROUTINGPOLICY_H_
+
+#include "Typedefinitions.h"
+#include "Interconnect_Base.h"
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    /* enumerations                                                         */
+    /************************************************************************/
+
+    //! \enum ROUTINGPOLICY
+    //! \brief routing algorithm of mesh routers
+    //! \details
+    //! - XY_ROUTING: dimension order, x first, then y (deterministic)
+    //! - WEST_FIRST: all hops to the left first, then adaptive between the
+    //!   remaining productive directions (turn model)
+    //! - MINIMAL_ADAPTIVE: adaptive between all productive directions. Needs
+    //!   at least two virtual channels, channel zero is the XY escape channel.
+    //!
+    //! With USE_EXTENDED_NETWORK the adaptive policies also use diagonal hops.
+    enum ROUTINGPOLICY
+    {
+        XY_ROUTING = 0,
+        WEST_FIRST,
+        MINIMAL_ADAPTIVE
+    };
+
+    //! \enum DIRECTION
+    //! \brief hop directions (x grows to the right/east, y grows downwards/south)
+    //! \details
+    //! The directions correspond to the members of SocketIdData:
+    //! WEST = left, EAST = right, NORTH = up, SOUTH = down, NORTHEAST = upright,
+    //! NORTHWEST = upleft, SOUTHEAST = lowright, SOUTHWEST = lowleft.
+    enum DIRECTION
+    {
+        WEST = 0,
+        EAST,
+        NORTH,
+        SOUTH,
+#ifdef USE_EXTENDED_NETWORK
+        NORTHEAST,
+        NORTHWEST,
+        SOUTHEAST,
+        SOUTHWEST,
+#endif
+        NUMOFDIRECTIONS
+    };
+
+
+    /************************************************************************/
+    /* routing functions                                                    */
+    /************************************************************************/
+
+    //! \brief name of routing policy _policy
+    const char* getRoutingPolicyName( ROUTINGPOLICY _policy );
+
+    /***************************************************************/
+    // getRoutingCandidates
+    //!
+    //! \brief    productive directions allowed by a routing policy
+    //!
+    //! \param [in] _policy routing policy
+    //! \param [in] _x relative steps to target in x direction
+    //! \param [in] _y relative steps to target in y direction
+    //! \param [out] _candidates directions, at least NUMOFDIRECTIONS entries
+    //! \return   unsigned int: number of candidates (0 = target reached)
+    //!
+    //! \details
+    //! Diagonal hops are listed first, so they are preferred if the
+    //! congestion of all candidates is equal.
+    /***************************************************************/
+    unsigned int getRoutingCandidates(
+        ROUTINGPOLICY _policy, int _x, int _y, DIRECTION* _candidates );
+
+    //! \brief position change of a hop in _dir
+    void getDirectionOffset( DIRECTION _dir, int& _dx, int& _dy );
+
+    //! \brief update relative steps to target after a hop in _dir
+    inline void applyDirection( DIRECTION _dir, int& _x, int& _y )
+    {
+        int dx = 0;
+        int dy = 0;
+        getDirectionOffset( _dir, dx, dy );
+        _x -= dx;
+        _y -= dy;
+    }
+
+    //! \brief socket index of _dir (negative = no neighbour)
+    int getDirectionSocketId( const SocketIdData& _socketIds, DIRECTION _dir );
+
+    /***************************************************************/
+    // isDeadlockFree
+    //!
+    //! \brief    check channel dependency graph of a routing policy
+    //!
+    //! \param [in] _policy routing policy
+    //! \param [in] _width number of nodes in x direction
+    //! \param [in] _height number of nodes in y direction
+    //! \return   bool: true if the channel dependency graph is acyclic
+    //!
+    //! \details
+    //! A channel is a link leaving a node in one direction. Channel a
+    //! depends on channel b, if a packet which arrives over a may leave
+    //! over b. The policies only depend on the sign of the relative
+    //! position, so relative positions up to two steps in every direction
+    //! cover all dependencies.
+    /***************************************************************/
+    bool isDeadlockFree( ROUTINGPOLICY _policy, unsigned int _width, unsigned int _height );
+}
+
+
+#endif // !ROUTINGPOLICY_H_
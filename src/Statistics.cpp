@@ -0,0 +1,291 @@
+//! \file Statistics.cpp
+//! \brief Utilization, waiting and latency statistics of process units and interconnects
+
+#include "Statistics.h"
+#include "ProcessUnit_Base.h"
+#include "Interconnect_Base.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vc_utils
+{
+    namespace
+    {
+        //! \brief write the used bins of _histogram as JSON array
+        void writeHistogramJson( ::std::ostream& _os, const Log2Histogram& _histogram )
+        {
+            bool first = true;
+
+            _os << "[";
+            for ( unsigned int bin = 0; bin < _histogram.getNumberOfUsedBins( ); ++bin )
+                {
+                    if ( 0 == _histogram.getCount( bin ) )
+                        continue;
+
+                    _os << ( first ? "" : ", " )
+                        << "{\"min_s\": " << Log2Histogram::getLowerBound( bin )
+                        << ", \"max_s\": " << Log2Histogram::getUpperBound( bin )
+                        << ", \"count\": " << _histogram.getCount( bin ) << "}";
+                    first = false;
+                }
+            _os << "]";
+        }
+    }
+
+    const char* getLatencyPartName( unsigned int _part )
+    {
+        static const char* names[ NUM_OF_LATENCY_PARTS + 1 ] = {
+            "request", "routing", "queueing", "response", "latency"};
+
+        return ( _part <= NUM_OF_LATENCY_PARTS ) ? names[ _part ] : "unknown";
+    }
+
+    /************************************************************************/
+    /* Log2Histogram                                                        */
+    /************************************************************************/
+    double Log2Histogram::getLowerBound( unsigned int _bin )
+    {
+        auto resolution = sc_core::sc_get_time_resolution( ).to_seconds( );
+        return ( 0 == _bin ) ? 0.0 : std::ldexp( resolution, _bin - 1 );
+    }
+
+    double Log2Histogram::getUpperBound( unsigned int _bin )
+    {
+        auto resolution = sc_core::sc_get_time_resolution( ).to_seconds( );
+        return ( 0 == _bin ) ? 0.0 : std::ldexp( resolution, _bin ) - resolution;
+    }
+
+    unsigned int Log2Histogram::getNumberOfUsedBins( void ) const
+    {
+        unsigned int numOfBins = NUM_OF_BINS;
+        while ( ( 0 < numOfBins ) && ( 0 == m_bins[ numOfBins - 1 ] ) )
+            --numOfBins;
+
+        return numOfBins;
+    }
+
+    /************************************************************************/
+    /* ProcessUnitStatistics                                                */
+    /************************************************************************/
+    void ProcessUnitStatistics::reset( void ) { *this = ProcessUnitStatistics( ); }
+
+    double ProcessUnitStatistics::getUtilization( const sc_time_t& _now ) const
+    {
+        if ( sc_core::SC_ZERO_TIME == _now )
+            return 0.0;
+
+        return std::min( 1.0, m_busyTime / _now );
+    }
+
+    /************************************************************************/
+    /* InterconnectStatistics                                               */
+    /************************************************************************/
+    void InterconnectStatistics::recordDelivery(
+        unsigned int _hops, const sc_time_t& _latency, const latencyParts_t& _parts )
+    {
+        ++m_numOfDelivered;
+        m_hopSum += _hops;
+
+        if ( _hops >= m_hopCounts.size( ) )
+            m_hopCounts.resize( _hops + 1, 0 );
+        ++m_hopCounts[ _hops ];
+
+        for ( unsigned int part = 0; part < NUM_OF_LATENCY_PARTS; ++part )
+            {
+                m_latencySums[ part ] += _parts[ part ];
+                m_histograms[ part ].add( _parts[ part ] );
+            }
+
+        m_latencySums[ NUM_OF_LATENCY_PARTS ] += _latency;
+        m_histograms[ NUM_OF_LATENCY_PARTS ].add( _latency );
+    }
+
+    /************************************************************************/
+    /* output                                                               */
+    /************************************************************************/
+    void writeStatisticsCsv(
+        ::std::ostream& _os, const std::vector< const ProcessUnit_Base* >& _units )
+    {
+        auto now = sc_core::sc_time_stamp( );
+        auto precision = _os.precision( 12 );
+
+        unsigned int numOfBins = 0;
+        for ( auto unit : _units )
+            numOfBins = std::max(
+                numOfBins, unit->getStatistics( ).getWaitHistogram( ).getNumberOfUsedBins( ) );
+
+        _os << "unit,unit_id,executions,requests,busy_s,idle_s,utilization,max_queue_depth,"
+               "mean_queue_depth,mean_wait_s,max_wait_s";
+        for ( unsigned int bin = 0; bin < numOfBins; ++bin )
+            _os << ",wait_bin_" << bin;
+        _os << "\n";
+
+        for ( auto unit : _units )
+            {
+                const auto& statistics = unit->getStatistics( );
+                auto requests = statistics.getNumberOfRequests( );
+
+                _os << unit->name( ) << "," << unit->m_unitId << ","
+                    << statistics.getNumberOfExecutions( ) << "," << requests << ","
+                    << statistics.getBusyTime( ).to_seconds( ) << ","
+                    << statistics.getIdleTime( now ).to_seconds( ) << ","
+                    << statistics.getUtilization( now ) << "," << statistics.getMaxQueueDepth( )
+                    << "," << statistics.getMeanQueueDepth( ) << ","
+                    << ( ( 0 != requests ) ? statistics.getWaitTime( ).to_seconds( ) / requests
+                                           : 0.0 )
+                    << "," << statistics.getMaxWaitTime( ).to_seconds( );
+
+                for ( unsigned int bin = 0; bin < numOfBins; ++bin )
+                    _os << "," << statistics.getWaitHistogram( ).getCount( bin );
+                _os << "\n";
+            }
+
+        _os.precision( precision );
+    }
+
+    void writeStatisticsJson(
+        ::std::ostream& _os, const std::vector< const ProcessUnit_Base* >& _units )
+    {
+        auto now = sc_core::sc_time_stamp( );
+        auto precision = _os.precision( 12 );
+
+        _os << "{\n  \"time_s\": " << now.to_seconds( ) << ",\n  \"units\": [";
+
+        for ( std::size_t i = 0; i < _units.size( ); ++i )
+            {
+                const auto& statistics = _units[ i ]->getStatistics( );
+                const auto& histogram = statistics.getWaitHistogram( );
+                auto requests = statistics.getNumberOfRequests( );
+
+                _os << ( ( 0 == i ) ? "\n" : ",\n" ) << "    {\"unit\": \"" << _units[ i ]->name( )
+                    << "\", \"unit_id\": " << _units[ i ]->m_unitId
+                    << ", \"executions\": " << statistics.getNumberOfExecutions( )
+                    << ", \"requests\": " << requests
+                    << ", \"busy_s\": " << statistics.getBusyTime( ).to_seconds( )
+                    << ", \"idle_s\": " << statistics.getIdleTime( now ).to_seconds( )
+                    << ", \"utilization\": " << statistics.getUtilization( now )
+                    << ", \"max_queue_depth\": " << statistics.getMaxQueueDepth( )
+                    << ", \"mean_queue_depth\": " << statistics.getMeanQueueDepth( )
+                    << ", \"mean_wait_s\": "
+                    << ( ( 0 != requests ) ? statistics.getWaitTime( ).to_seconds( ) / requests
+                                           : 0.0 )
+                    << ", \"max_wait_s\": " << statistics.getMaxWaitTime( ).to_seconds( )
+                    << ", \"wait_histogram\": ";
+
+                writeHistogramJson( _os, histogram );
+                _os << "}";
+            }
+
+        _os << "\n  ]\n}\n";
+        _os.precision( precision );
+    }
+
+    void writeLinkStatisticsCsv(
+        ::std::ostream& _os, const std::vector< const Interconnect_Base* >& _interconnects )
+    {
+        auto now = sc_core::sc_time_stamp( );
+        auto precision = _os.precision( 12 );
+
+        _os << "interconnect,socket,transactions,contended,contention_s,mean_contention_s,"
+               "max_contention_s,busy_s,utilization\n";
+
+        for ( auto interconnect : _interconnects )
+            {
+                for ( unsigned int id = 0; id < interconnect->getNumberOfOutSockets( ); ++id )
+                    {
+                        const auto& socket = interconnect->getOutSocket( id );
+                        const auto& statistics = socket.getStatistics( );
+                        auto grants = statistics.getNumberOfGrants( );
+                        auto busy = socket.getBusyTime( );
+
+                        _os << interconnect->getName_Cstr( ) << "," << id << "," << grants << ","
+                            << statistics.getNumberOfContended( ) << ","
+                            << statistics.getContentionTime( ).to_seconds( ) << ","
+                            << ( ( 0 != grants )
+                                       ? statistics.getContentionTime( ).to_seconds( ) / grants
+                                       : 0.0 )
+                            << "," << statistics.getMaxContentionTime( ).to_seconds( ) << ","
+                            << busy.to_seconds( ) << ","
+                            << ( ( sc_core::SC_ZERO_TIME != now ) ? busy / now : 0.0 ) << "\n";
+                    }
+            }
+
+        _os.precision( precision );
+    }
+
+    void writeLatencyStatisticsCsv(
+        ::std::ostream& _os, const std::vector< const Interconnect_Base* >& _interconnects )
+    {
+        auto precision = _os.precision( 12 );
+
+        _os << "interconnect,delivered,mean_hops,max_hops";
+        for ( unsigned int part = 0; part <= NUM_OF_LATENCY_PARTS; ++part )
+            _os << ",mean_" << getLatencyPartName( part ) << "_s";
+        _os << "\n";
+
+        for ( auto interconnect : _interconnects )
+            {
+                const auto& statistics = interconnect->getStatistics( );
+
+                _os << interconnect->getName_Cstr( ) << "," << statistics.getNumberOfDelivered( )
+                    << "," << statistics.getMeanHops( ) << "," << statistics.getMaxHops( );
+                for ( unsigned int part = 0; part <= NUM_OF_LATENCY_PARTS; ++part )
+                    _os << "," << statistics.getMeanLatency( part ).to_seconds( );
+                _os << "\n";
+            }
+
+        _os.precision( precision );
+    }
+
+    void writeStatisticsJson(
+        ::std::ostream& _os, const std::vector< const Interconnect_Base* >& _interconnects )
+    {
+        auto now = sc_core::sc_time_stamp( );
+        auto precision = _os.precision( 12 );
+
+        _os << "{\n  \"time_s\": " << now.to_seconds( ) << ",\n  \"interconnects\": [";
+
+        for ( std::size_t i = 0; i < _interconnects.size( ); ++i )
+            {
+                auto interconnect = _interconnects[ i ];
+                const auto& statistics = interconnect->getStatistics( );
+
+                _os << ( ( 0 == i ) ? "\n" : ",\n" ) << "    {\"interconnect\": \""
+                    << interconnect->getName_Cstr( ) << "\",\n     \"sockets\": [";
+
+                for ( unsigned int id = 0; id < interconnect->getNumberOfOutSockets( ); ++id )
+                    {
+                        const auto& socket = interconnect->getOutSocket( id );
+                        const auto& socketStatistics = socket.getStatistics( );
+
+                        _os << ( ( 0 == id ) ? "" : ", " ) << "{\"socket\": " << id
+                            << ", \"transactions\": " << socketStatistics.getNumberOfGrants( )
+                            << ", \"contended\": " << socketStatistics.getNumberOfContended( )
+                            << ", \"contention_s\": "
+                            << socketStatistics.getContentionTime( ).to_seconds( )
+                            << ", \"max_contention_s\": "
+                            << socketStatistics.getMaxContentionTime( ).to_seconds( )
+                            << ", \"busy_s\": " << socket.getBusyTime( ).to_seconds( ) << "}";
+                    }
+
+                _os << "],\n     \"delivered\": " << statistics.getNumberOfDelivered( )
+                    << ", \"mean_hops\": " << statistics.getMeanHops( ) << ", \"hops\": [";
+                for ( unsigned int hops = 0; hops <= statistics.getMaxHops( ); ++hops )
+                    _os << ( ( 0 == hops ) ? "" : ", " ) << statistics.getNumberOfDelivered( hops );
+                _os << "]";
+
+                for ( unsigned int part = 0; part <= NUM_OF_LATENCY_PARTS; ++part )
+                    {
+                        _os << ",\n     \"" << getLatencyPartName( part ) << "\": {\"mean_s\": "
+                            << statistics.getMeanLatency( part ).to_seconds( )
+                            << ", \"histogram\": ";
+                        writeHistogramJson( _os, statistics.getHistogram( part ) );
+                        _os << "}";
+                    }
+                _os << "}";
+            }
+
+        _os << "\n  ]\n}\n";
+        _os.precision( precision );
+    }
+}
@@ -0,0 +1,437 @@
+//! \file Statistics.h
+//! \brief Utilization, waiting and latency statistics of process units and interconnects
+
+#ifndef STATISTICS_H_
+#define STATISTICS_H_
+
+#include "Typedefinitions.h"
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace vc_utils
+{
+    /************************************************************************/
+    // declarations
+    /************************************************************************/
+    struct ProcessUnit_Base;
+    struct Interconnect_Base;
+
+    /************************************************************************/
+    /* enumerations                                                         */
+    /************************************************************************/
+    //! \enum LATENCY_PART
+    //! \brief Part of the latency of a transaction, summed over all hops
+    enum LATENCY_PART {
+        REQUEST_LATENCY = 0,  //!< \brief link delay (LT) or request phase (AT)
+        ROUTING_LATENCY = 1,  //!< \brief routing delay and router pipeline
+        QUEUEING_LATENCY = 2, //!< \brief waiting for output buffer, credit and link
+        RESPONSE_LATENCY = 3, //!< \brief response phase (AT)
+        NUM_OF_LATENCY_PARTS = 4
+    };
+
+    //! \brief latency parts of one transaction
+    typedef std::array< sc_time_t, NUM_OF_LATENCY_PARTS > latencyParts_t;
+
+    //! \brief name of latency part _part
+    const char* getLatencyPartName( unsigned int _part );
+
+    /************************************************************************/
+    // Log2Histogram
+    //!
+    //! \class Log2Histogram
+    //!
+    //! \brief Histogram of times with power of two bins
+    //!
+    //! \details
+    //! Bin 0 counts zero times, bin i counts times of 2^(i-1) up to
+    //! 2^i - 1 time resolution units. The bins cover every sc_time value
+    //! without configuration.
+    /************************************************************************/
+    class Log2Histogram
+    {
+    public:
+        //! \brief number of bins
+        static const unsigned int NUM_OF_BINS = 65;
+
+        //! \brief count _time
+        void add( const sc_time_t& _time )
+        {
+            auto value = _time.value( );
+            unsigned int bin = 0;
+
+            while ( 0 != value )
+                {
+                    value >>= 1;
+                    ++bin;
+                }
+
+            ++m_bins[ bin ];
+        }
+
+        //! \brief number of counted times in bin _bin
+        std::uint64_t getCount( unsigned int _bin ) const { return m_bins[ _bin ]; }
+
+        //! \brief smallest time of bin _bin in seconds
+        static double getLowerBound( unsigned int _bin );
+
+        //! \brief largest time of bin _bin in seconds
+        static double getUpperBound( unsigned int _bin );
+
+        //! \brief number of bins up to the last used one
+        unsigned int getNumberOfUsedBins( void ) const;
+
+        //! \brief set all bins to zero
+        void reset( void ) { m_bins.fill( 0 ); }
+
+    private:
+        //! \var m_bins
+        //! \brief counts per bin
+        std::array< std::uint64_t, NUM_OF_BINS > m_bins = {{}};
+    };
+
+    /************************************************************************/
+    // ProcessUnitStatistics
+    //!
+    //! \class ProcessUnitStatistics
+    //!
+    //! \brief Counters of one process unit
+    //!
+    //! \details
+    //! The counters are updated by ProcessUnit_Base::isCoreUsed and
+    //! ProcessUnit_Base::freeUsedCore with a few additions, so they are
+    //! always collected.
+    //! - busy time: sum of the latencies of all executions,
+    //! - idle time: simulated time without execution,
+    //! - queue depth: length of m_processWaitingQueue after every core
+    //!   request (zero if the core was free), the mean is taken over the
+    //!   requests,
+    //! - wait time: time from the core request (vertex ready) to the grant
+    //!   of the core (m_coreFreeEv).
+    /************************************************************************/
+    class ProcessUnitStatistics
+    {
+    public:
+        //! \brief a core request left _depth requests in the queue (0 = granted)
+        void recordRequest( std::size_t _depth )
+        {
+            ++m_numOfRequests;
+            m_queueDepthSum += _depth;
+
+            if ( _depth > m_maxQueueDepth )
+                m_maxQueueDepth = _depth;
+        }
+
+        //! \brief a core request was granted after _wait
+        void recordGrant( const sc_time_t& _wait )
+        {
+            m_waitTime += _wait;
+            if ( _wait > m_maxWaitTime )
+                m_maxWaitTime = _wait;
+
+            m_waitHistogram.add( _wait );
+        }
+
+        //! \brief an execution of _latency finished
+        void recordExecution( const sc_time_t& _latency )
+        {
+            ++m_numOfExecutions;
+            m_busyTime += _latency;
+        }
+
+        //! \brief set all counters to zero
+        void reset( void );
+
+        //! \brief number of executions
+        std::uint64_t getNumberOfExecutions( void ) const { return m_numOfExecutions; }
+
+        //! \brief number of core requests
+        std::uint64_t getNumberOfRequests( void ) const { return m_numOfRequests; }
+
+        //! \brief sum of the latencies of all executions
+        const sc_time_t& getBusyTime( void ) const { return m_busyTime; }
+
+        //! \brief simulated time up to _now without execution
+        sc_time_t getIdleTime( const sc_time_t& _now = sc_core::sc_time_stamp( ) ) const
+        {
+            return ( _now > m_busyTime ) ? _now - m_busyTime : sc_core::SC_ZERO_TIME;
+        }
+
+        //! \brief busy time / _now (0 .. 1)
+        double getUtilization( const sc_time_t& _now = sc_core::sc_time_stamp( ) ) const;
+
+        //! \brief maximal length of the waiting queue
+        std::size_t getMaxQueueDepth( void ) const { return m_maxQueueDepth; }
+
+        //! \brief mean length of the waiting queue after core requests
+        double getMeanQueueDepth( void ) const
+        {
+            return ( 0 != m_numOfRequests )
+                       ? static_cast< double >( m_queueDepthSum ) / m_numOfRequests
+                       : 0.0;
+        }
+
+        //! \brief sum of the wait times of all granted requests
+        const sc_time_t& getWaitTime( void ) const { return m_waitTime; }
+
+        //! \brief maximal wait time
+        const sc_time_t& getMaxWaitTime( void ) const { return m_maxWaitTime; }
+
+        //! \brief histogram of the wait times
+        const Log2Histogram& getWaitHistogram( void ) const { return m_waitHistogram; }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_numOfExecutions
+        //! \brief number of executions
+        std::uint64_t m_numOfExecutions = {0};
+        //! \var m_numOfRequests
+        //! \brief number of core requests
+        std::uint64_t m_numOfRequests = {0};
+        //! \var m_busyTime
+        //! \brief sum of execution latencies
+        sc_time_t m_busyTime;
+        //! \var m_queueDepthSum
+        //! \brief sum of the queue depths after core requests
+        std::uint64_t m_queueDepthSum = {0};
+        //! \var m_maxQueueDepth
+        //! \brief maximal queue depth
+        std::size_t m_maxQueueDepth = {0};
+        //! \var m_waitTime
+        //! \brief sum of wait times
+        sc_time_t m_waitTime;
+        //! \var m_maxWaitTime
+        //! \brief maximal wait time
+        sc_time_t m_maxWaitTime;
+        //! \var m_waitHistogram
+        //! \brief distribution of wait times
+        Log2Histogram m_waitHistogram;
+    };
+
+    /************************************************************************/
+    // SocketStatistics
+    //!
+    //! \class SocketStatistics
+    //!
+    //! \brief Counters of one outgoing socket of an interconnect
+    //!
+    //! \details
+    //! The SocketManager updates the counters:
+    //! - busy time: time with at least one outstanding transaction, the
+    //!   link utilization is busy time / simulated time,
+    //! - contention time: time a transaction waited in the job queue of
+    //!   the socket (m_socketFreeJobQueue) for a free slot.
+    /************************************************************************/
+    class SocketStatistics
+    {
+    public:
+        //! \brief the first slot of the socket is occupied
+        void startBusy( void ) { m_busySince = sc_core::sc_time_stamp( ); }
+
+        //! \brief the last slot of the socket is freed
+        void stopBusy( void ) { m_busyTime += sc_core::sc_time_stamp( ) - m_busySince; }
+
+        //! \brief a transaction got a slot after _wait in the job queue
+        void recordGrant( const sc_time_t& _wait )
+        {
+            ++m_numOfGrants;
+
+            if ( sc_core::SC_ZERO_TIME == _wait )
+                return;
+
+            ++m_numOfContended;
+            m_contentionTime += _wait;
+            if ( _wait > m_maxContentionTime )
+                m_maxContentionTime = _wait;
+        }
+
+        //! \brief number of transactions sent by the socket
+        std::uint64_t getNumberOfGrants( void ) const { return m_numOfGrants; }
+
+        //! \brief number of transactions which waited for a slot
+        std::uint64_t getNumberOfContended( void ) const { return m_numOfContended; }
+
+        //! \brief sum of the wait times in the job queue
+        const sc_time_t& getContentionTime( void ) const { return m_contentionTime; }
+
+        //! \brief maximal wait time in the job queue
+        const sc_time_t& getMaxContentionTime( void ) const { return m_maxContentionTime; }
+
+        //! \brief busy time up to now, _busy = socket in use at the moment
+        sc_time_t getBusyTime( bool _busy ) const
+        {
+            return _busy ? m_busyTime + ( sc_core::sc_time_stamp( ) - m_busySince ) : m_busyTime;
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        std::uint64_t m_numOfGrants = {0};    //!< \brief number of occupied slots
+        std::uint64_t m_numOfContended = {0}; //!< \brief number of queued requests
+        sc_time_t m_contentionTime;           //!< \brief sum of job queue wait times
+        sc_time_t m_maxContentionTime;        //!< \brief maximal job queue wait time
+        sc_time_t m_busyTime;                 //!< \brief closed busy intervals
+        sc_time_t m_busySince;                //!< \brief begin of the open busy interval
+    };
+
+    /************************************************************************/
+    // InterconnectStatistics
+    //!
+    //! \class InterconnectStatistics
+    //!
+    //! \brief Latency and hop count of the transactions delivered by an interconnect
+    //!
+    //! \details
+    //! Every payload carries its injection time, hop count and latency
+    //! parts in the RoutingExt. The target interconnect adds them to these
+    //! histograms, so the memory does not depend on the number of
+    //! transactions. The latency is measured from the allocation of the
+    //! payload (including a burst window) to the delivery. The request and
+    //! response phases of AT hops overlap with the forwarding of the
+    //! payload, so the parts do not need to add up to the latency.
+    /************************************************************************/
+    class InterconnectStatistics
+    {
+    public:
+        //! \brief a transaction with _hops hops and _parts arrived after _latency
+        void recordDelivery(
+            unsigned int _hops, const sc_time_t& _latency, const latencyParts_t& _parts );
+
+        //! \brief number of delivered transactions
+        std::uint64_t getNumberOfDelivered( void ) const { return m_numOfDelivered; }
+
+        //! \brief number of delivered transactions with _hops hops
+        std::uint64_t getNumberOfDelivered( unsigned int _hops ) const
+        {
+            return ( _hops < m_hopCounts.size( ) ) ? m_hopCounts[ _hops ] : 0;
+        }
+
+        //! \brief largest hop count
+        unsigned int getMaxHops( void ) const
+        {
+            return m_hopCounts.empty( ) ? 0
+                                        : static_cast< unsigned int >( m_hopCounts.size( ) - 1 );
+        }
+
+        //! \brief mean hop count
+        double getMeanHops( void ) const
+        {
+            return ( 0 != m_numOfDelivered ) ? static_cast< double >( m_hopSum ) / m_numOfDelivered
+                                             : 0.0;
+        }
+
+        //! \brief mean latency (_part = NUM_OF_LATENCY_PARTS) or mean of part _part
+        sc_time_t getMeanLatency( unsigned int _part = NUM_OF_LATENCY_PARTS ) const
+        {
+            return ( 0 != m_numOfDelivered )
+                       ? m_latencySums[ _part ] / static_cast< double >( m_numOfDelivered )
+                       : sc_core::SC_ZERO_TIME;
+        }
+
+        //! \brief histogram of the latency (_part = NUM_OF_LATENCY_PARTS) or of part _part
+        const Log2Histogram& getHistogram( unsigned int _part = NUM_OF_LATENCY_PARTS ) const
+        {
+            return m_histograms[ _part ];
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_numOfDelivered
+        //! \brief number of delivered transactions
+        std::uint64_t m_numOfDelivered = {0};
+        //! \var m_hopSum
+        //! \brief sum of hop counts
+        std::uint64_t m_hopSum = {0};
+        //! \var m_hopCounts
+        //! \brief number of transactions per hop count
+        std::vector< std::uint64_t > m_hopCounts;
+        //! \var m_latencySums
+        //! \brief sums of the latency parts, the latency is the last entry
+        std::array< sc_time_t, NUM_OF_LATENCY_PARTS + 1 > m_latencySums;
+        //! \var m_histograms
+        //! \brief histograms of the latency parts, the latency is the last entry
+        std::array< Log2Histogram, NUM_OF_LATENCY_PARTS + 1 > m_histograms;
+    };
+
+    /***************************************************************/
+    // writeStatisticsCsv
+    //!
+    //! \brief    write the statistics of _units as CSV table
+    //!
+    //! \param [in] _os output stream
+    //! \param [in] _units process units, one row per unit
+    //!
+    //! \details
+    //! Times are written in seconds at the current simulation time. The
+    //! columns wait_bin_<i> hold bin i of the wait histogram (see
+    //! Log2Histogram) up to the last bin used by any unit.
+    /***************************************************************/
+    void writeStatisticsCsv(
+        ::std::ostream& _os, const std::vector< const ProcessUnit_Base* >& _units );
+
+    /***************************************************************/
+    // writeStatisticsJson
+    //!
+    //! \brief    write the statistics of _units as JSON object
+    //!
+    //! \param [in] _os output stream
+    //! \param [in] _units process units
+    //!
+    //! \details
+    //! The object holds the simulation time and an array "units" with one
+    //! object per unit. The wait histogram lists the used bins with their
+    //! bounds in seconds.
+    /***************************************************************/
+    void writeStatisticsJson(
+        ::std::ostream& _os, const std::vector< const ProcessUnit_Base* >& _units );
+
+    /***************************************************************/
+    // writeLinkStatisticsCsv
+    //!
+    //! \brief    write the socket statistics of _interconnects as CSV table
+    //!
+    //! \param [in] _os output stream
+    //! \param [in] _interconnects interconnects, one row per outgoing socket
+    /***************************************************************/
+    void writeLinkStatisticsCsv(
+        ::std::ostream& _os, const std::vector< const Interconnect_Base* >& _interconnects );
+
+    /***************************************************************/
+    // writeLatencyStatisticsCsv
+    //!
+    //! \brief    write the delivery statistics of _interconnects as CSV table
+    //!
+    //! \param [in] _os output stream
+    //! \param [in] _interconnects interconnects, one row per interconnect
+    //!
+    //! \details
+    //! The row holds the hop count and the mean of the latency and of its
+    //! parts of the transactions delivered at the interconnect.
+    /***************************************************************/
+    void writeLatencyStatisticsCsv(
+        ::std::ostream& _os, const std::vector< const Interconnect_Base* >& _interconnects );
+
+    /***************************************************************/
+    // writeStatisticsJson
+    //!
+    //! \brief    write the statistics of _interconnects as JSON object
+    //!
+    //! \param [in] _os output stream
+    //! \param [in] _interconnects interconnects
+    //!
+    //! \details
+    //! Every interconnect object holds its sockets, the hop count
+    //! distribution and the used bins of the latency histograms.
+    /***************************************************************/
+    void writeStatisticsJson(
+        ::std::ostream& _os, const std::vector< const Interconnect_Base* >& _interconnects );
+}
+
+
+#endif // !STATISTICS_H_
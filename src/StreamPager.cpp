@@ -0,0 +1,279 @@
+//! \file StreamPager.cpp
+//! \brief StreamPager implementation file
+
+#include "StreamPager.h"
+#include <cstring>
+#include <cerrno>
+
+#if !defined( _WIN32 )
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    /* constructor, destructor                                              */
+    /************************************************************************/
+    StreamPager::StreamPager(
+        const std::string& _path, MODE _mode, std::size_t _pageSize, unsigned int _numBuffers )
+        : m_path( _path ),
+          m_mode( _mode ),
+          m_pageSize( _pageSize ),
+          m_numOfPages( 0 ),
+          m_syncTransfers( 0 ),
+          m_slots( _numBuffers > 0 ? _numBuffers : 1 )
+    {
+        sc_assert( m_pageSize > 0 );
+
+        for ( auto& slot : m_slots )
+            {
+                slot.buffer.resize( m_pageSize );
+                slot.page = 0;
+                slot.valid = false;
+                slot.pending = false;
+#ifdef STREAMPAGER_WORKER_THREADS
+                slot.failed = false;
+#endif
+            }
+
+#ifdef _WIN32
+        auto flags = std::ios::binary |
+            ( m_mode == READ ? std::ios::in : ( std::ios::out | std::ios::trunc ) );
+        m_file.open( m_path, flags );
+
+        if ( !m_file.is_open( ) )
+            SC_REPORT_ERROR( m_path.c_str( ), "could not open stream file" );
+
+        if ( m_mode == READ )
+            {
+                m_file.seekg( 0, std::ios::end );
+                auto fileSize = static_cast< std::size_t >( m_file.tellg( ) );
+                m_numOfPages = fileSize / m_pageSize;
+
+                if ( 0 != fileSize % m_pageSize )
+                    SC_REPORT_ERROR( m_path.c_str( ), "stream file ends with a partial page" );
+            }
+#else
+        if ( m_mode == READ )
+            m_fd = ::open( m_path.c_str( ), O_RDONLY );
+        else
+            m_fd = ::open( m_path.c_str( ), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+        if ( 0 > m_fd )
+            SC_REPORT_ERROR( m_path.c_str( ), "could not open stream file" );
+
+        if ( m_mode == READ )
+            {
+                struct stat fileStat;
+                if ( 0 != ::fstat( m_fd, &fileStat ) )
+                    SC_REPORT_ERROR( m_path.c_str( ), "could not read size of stream file" );
+
+                auto fileSize = static_cast< std::size_t >( fileStat.st_size );
+                m_numOfPages = fileSize / m_pageSize;
+
+                if ( 0 != fileSize % m_pageSize )
+                    SC_REPORT_ERROR( m_path.c_str( ), "stream file ends with a partial page" );
+            }
+#endif
+    }
+
+    StreamPager::~StreamPager( )
+    {
+        flush( );
+
+#ifdef _WIN32
+        m_file.close( );
+#else
+        if ( 0 <= m_fd )
+            ::close( m_fd );
+#endif
+    }
+
+    /************************************************************************/
+    /* read mode                                                            */
+    /************************************************************************/
+    void StreamPager::prefetch( std::size_t _page )
+    {
+        sc_assert( m_mode == READ );
+
+        if ( _page >= m_numOfPages )
+            return;
+
+        auto& slot = m_slots[ _page % m_slots.size( ) ];
+
+        if ( slot.valid && ( slot.page == _page ) )
+            return;
+
+        // slot is reused, former transfer has to be finished
+        waitForTransfer( slot );
+
+        slot.page = _page;
+        slot.valid = true;
+        startTransfer( slot );
+    }
+
+    dataPtr_t StreamPager::acquire( std::size_t _page )
+    {
+        sc_assert( m_mode == READ );
+
+        if ( _page >= m_numOfPages )
+            SC_REPORT_ERROR( m_path.c_str( ), "page behind end of stream file" );
+
+        prefetch( _page );
+
+        auto& slot = m_slots[ _page % m_slots.size( ) ];
+        waitForTransfer( slot );
+
+        return slot.buffer.data( );
+    }
+
+    /************************************************************************/
+    /* write mode                                                           */
+    /************************************************************************/
+    dataPtr_t StreamPager::getWriteBuffer( std::size_t _page )
+    {
+        sc_assert( m_mode == WRITE );
+
+        auto& slot = m_slots[ _page % m_slots.size( ) ];
+
+        // buffer can not be changed before its former page is written
+        waitForTransfer( slot );
+
+        slot.page = _page;
+        slot.valid = true;
+
+        return slot.buffer.data( );
+    }
+
+    void StreamPager::commit( std::size_t _page )
+    {
+        sc_assert( m_mode == WRITE );
+
+        auto& slot = m_slots[ _page % m_slots.size( ) ];
+
+        if ( !slot.valid || ( slot.page != _page ) )
+            SC_REPORT_ERROR( m_path.c_str( ), "page is not assigned to a write buffer" );
+
+        startTransfer( slot );
+        slot.valid = false;
+    }
+
+    void StreamPager::flush( void )
+    {
+        for ( auto& slot : m_slots )
+            waitForTransfer( slot );
+    }
+
+    /************************************************************************/
+    /* transfer                                                             */
+    /************************************************************************/
+    void StreamPager::startTransfer( PageSlot& _slot )
+    {
+#ifdef USE_POSIX_AIO
+        std::memset( &_slot.request, 0, sizeof( _slot.request ) );
+        _slot.request.aio_fildes = m_fd;
+        _slot.request.aio_buf = _slot.buffer.data( );
+        _slot.request.aio_nbytes = m_pageSize;
+        _slot.request.aio_offset = static_cast< off_t >( _slot.page * m_pageSize );
+
+        auto retVal = ( m_mode == READ ) ? ::aio_read( &_slot.request )
+                                         : ::aio_write( &_slot.request );
+
+        if ( 0 == retVal )
+            {
+                _slot.pending = true;
+                return;
+            }
+#elif defined( STREAMPAGER_WORKER_THREADS )
+        // errors are reported by waitForTransfer in the simulation thread
+        _slot.failed = false;
+        _slot.pending = true;
+        _slot.worker = std::thread( [this, &_slot]( ) { _slot.failed = !transferPage( _slot ); } );
+        return;
+#endif
+        // asynchronous transfer not available
+        transferSync( _slot );
+    }
+
+    void StreamPager::waitForTransfer( PageSlot& _slot )
+    {
+#ifdef USE_POSIX_AIO
+        if ( !_slot.pending )
+            return;
+
+        const struct aiocb* requestList[ 1 ] = {&_slot.request};
+
+        while ( EINPROGRESS == ::aio_error( &_slot.request ) )
+            ::aio_suspend( requestList, 1, nullptr );
+
+        _slot.pending = false;
+
+        if ( static_cast< ssize_t >( m_pageSize ) != ::aio_return( &_slot.request ) )
+            SC_REPORT_ERROR( m_path.c_str( ), "asynchronous page transfer failed" );
+#elif defined( STREAMPAGER_WORKER_THREADS )
+        if ( !_slot.pending )
+            return;
+
+        _slot.worker.join( );
+        _slot.pending = false;
+
+        if ( _slot.failed )
+            SC_REPORT_ERROR( m_path.c_str( ), "asynchronous page transfer failed" );
+#else
+        ( void ) _slot;
+#endif
+    }
+
+    void StreamPager::transferSync( PageSlot& _slot )
+    {
+        ++m_syncTransfers;
+
+        if ( !transferPage( _slot ) )
+            SC_REPORT_ERROR( m_path.c_str( ), "page transfer failed" );
+    }
+
+    bool StreamPager::transferPage( PageSlot& _slot )
+    {
+#ifdef _WIN32
+        auto offset = static_cast< std::streamoff >( _slot.page * m_pageSize );
+        auto data = reinterpret_cast< char* >( _slot.buffer.data( ) );
+        auto length = static_cast< std::streamsize >( m_pageSize );
+
+        if ( m_mode == READ )
+            {
+                m_file.seekg( offset );
+                m_file.read( data, length );
+            }
+        else
+            {
+                m_file.seekp( offset );
+                m_file.write( data, length );
+            }
+
+        return m_file.good( );
+#else
+        auto offset = static_cast< off_t >( _slot.page * m_pageSize );
+        std::size_t done = 0;
+
+        while ( done < m_pageSize )
+            {
+                auto data = _slot.buffer.data( ) + done;
+                auto length = m_pageSize - done;
+                auto retVal = ( m_mode == READ ) ? ::pread( m_fd, data, length, offset + done )
+                                                 : ::pwrite( m_fd, data, length, offset + done );
+
+                if ( ( 0 > retVal ) && ( EINTR == errno ) )
+                    continue;
+
+                if ( 0 >= retVal )
+                    return false;
+
+                done += static_cast< std::size_t >( retVal );
+            }
+
+        return true;
+#endif
+    }
+}
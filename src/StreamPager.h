@@ -0,0 +1,206 @@
+//! \file StreamPager.h
+//! \brief Windowed reading and writing of value streams which do not fit into memory
+
+#ifndef STREAMPAGER_H_
+#define STREAMPAGER_H_
+
+#include "Typedefinitions.h"
+#include <string>
+#include <vector>
+#include <fstream>
+
+#if !defined( _WIN32 )
+#include <unistd.h>
+#endif
+
+// USE_POSIX_AIO: pages are transferred by POSIX asynchronous I/O (build flag)
+#ifdef USE_POSIX_AIO
+#if defined( _WIN32 ) || !defined( _POSIX_ASYNCHRONOUS_IO ) || ( _POSIX_ASYNCHRONOUS_IO < 0 )
+#error "USE_POSIX_AIO is set, but the platform does not provide POSIX asynchronous I/O"
+#endif
+#include <aio.h>
+#endif
+
+// STREAMPAGER_WORKER_THREADS: without POSIX AIO, pages are transferred by worker threads
+#if !defined( USE_POSIX_AIO ) && !defined( _WIN32 )
+#define STREAMPAGER_WORKER_THREADS
+#include <thread>
+#endif
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    //! \class StreamPager
+    //!
+    //! \brief Transfer fixed size pages between a file and a small set of buffers
+    //!
+    //! \details
+    //! A file is handled as a sequence of pages with the same size in bytes.
+    //! Only numBuffers pages are held in memory at the same time, so the
+    //! memory footprint does not depend on the file size.
+    //!
+    //! In READ mode, prefetch starts the transfer of a page into the buffer
+    //! slot (page % numBuffers) and acquire waits until the page is available.
+    //! In WRITE mode, getWriteBuffer returns the buffer slot of a page after a
+    //! former write from this slot is finished and commit starts the transfer
+    //! into the file.
+    //!
+    //! POSIX asynchronous I/O is used if USE_POSIX_AIO is defined. Otherwise
+    //! every transfer runs pread/pwrite on a worker thread of its slot, so
+    //! read ahead and write back overlap with the simulation in the default
+    //! build, too. On Windows, or if an asynchronous request is rejected,
+    //! pages are transferred synchronously (std::fstream on Windows).
+    //!
+    //! In READ mode the file has to hold complete pages; a trailing partial
+    //! page is reported as error when the file is opened.
+    //!
+    //! \note
+    //! Some older C libraries need -lrt for POSIX asynchronous I/O.
+    /************************************************************************/
+    class StreamPager
+    {
+    public:
+        //! \enum MODE
+        //! \brief transfer direction of a pager
+        enum MODE
+        {
+            READ = 0,
+            WRITE = 1
+        };
+
+    public:
+        /***************************************************************/
+        // constructor:
+        //!
+        //! \brief    open file for paged access
+        //!
+        //! \param [in] _path file name
+        //! \param [in] _mode READ opens an existing file, WRITE creates or truncates it
+        //! \param [in] _pageSize size of one page in bytes
+        //! \param [in] _numBuffers number of pages held in memory (at least one)
+        /***************************************************************/
+        explicit StreamPager(
+            const std::string& _path, MODE _mode, std::size_t _pageSize, unsigned int _numBuffers );
+
+        //! \brief destructor waits for all pending transfers and closes the file
+        ~StreamPager( );
+
+    private:
+        // forbidden constructors
+        StreamPager( ) = delete;                                    //!< \brief forbidden
+        StreamPager( const StreamPager& _source ) = delete;         //!< \brief forbidden
+        StreamPager( StreamPager&& _source ) = delete;              //!< \brief forbidden
+        StreamPager& operator=( const StreamPager& _rhs ) = delete; //!< \brief forbidden
+        StreamPager& operator=( StreamPager&& _rhs ) = delete;      //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // prefetch
+        //!
+        //! \brief    start reading a page into its buffer slot
+        //!
+        //! \param [in] _page page number
+        //!
+        //! \details
+        //! Pages behind the end of the file and pages which are already
+        //! in their slot are ignored.
+        /***************************************************************/
+        void prefetch( std::size_t _page );
+
+        /***************************************************************/
+        // acquire
+        //!
+        //! \brief    return buffer of a page in READ mode
+        //!
+        //! \param [in] _page page number
+        //! \return   dataPtr_t: begin of page data
+        //!
+        //! \details
+        //! Starts the transfer if the page was not prefetched and waits until
+        //! it is finished. The buffer is valid until the slot is used by
+        //! another page.
+        /***************************************************************/
+        dataPtr_t acquire( std::size_t _page );
+
+        /***************************************************************/
+        // getWriteBuffer
+        //!
+        //! \brief    return buffer for a page in WRITE mode
+        //!
+        //! \param [in] _page page number
+        //! \return   dataPtr_t: begin of page buffer
+        /***************************************************************/
+        dataPtr_t getWriteBuffer( std::size_t _page );
+
+        /***************************************************************/
+        // commit
+        //!
+        //! \brief    start writing the buffer of a page into the file
+        //!
+        //! \param [in] _page page number
+        /***************************************************************/
+        void commit( std::size_t _page );
+
+        //! \brief wait for all pending transfers
+        void flush( void );
+
+    public:
+        //! \brief number of complete pages in file (READ mode)
+        std::size_t getNumberOfPages( void ) const { return m_numOfPages; }
+
+        //! \brief size of one page in bytes
+        std::size_t getPageSize( void ) const { return m_pageSize; }
+
+        //! \brief file name
+        const std::string& getPath( void ) const { return m_path; }
+
+        //! \brief number of transfers which blocked the caller (asynchronous I/O not available)
+        std::size_t getNumberOfSyncTransfers( void ) const { return m_syncTransfers; }
+
+    private:
+        //! \struct PageSlot
+        //! \brief buffer for one page and state of its transfer
+        struct PageSlot
+        {
+            std::vector< unsigned char > buffer; //!< \brief page data
+            std::size_t page;                    //!< \brief page in buffer
+            bool valid;                          //!< \brief buffer holds or is receiving page
+            bool pending;                        //!< \brief asynchronous transfer not finished
+#ifdef USE_POSIX_AIO
+            struct aiocb request; //!< \brief asynchronous I/O control block
+#elif defined( STREAMPAGER_WORKER_THREADS )
+            std::thread worker; //!< \brief thread transferring the page
+            bool failed;        //!< \brief transfer of the worker failed
+#endif
+        };
+
+        //! \brief start transfer of a slot
+        void startTransfer( PageSlot& _slot );
+        //! \brief wait until transfer of a slot is finished
+        void waitForTransfer( PageSlot& _slot );
+        //! \brief transfer a slot synchronously
+        void transferSync( PageSlot& _slot );
+        //! \brief read or write the page of a slot, return false on failure (no report)
+        bool transferPage( PageSlot& _slot );
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        std::string m_path;             //!< \brief file name
+        MODE m_mode;                    //!< \brief transfer direction
+        std::size_t m_pageSize;         //!< \brief size of one page in bytes
+        std::size_t m_numOfPages;       //!< \brief complete pages in file (READ mode)
+        std::size_t m_syncTransfers;    //!< \brief number of synchronous transfers
+        std::vector< PageSlot > m_slots; //!< \brief page buffers
+#ifdef _WIN32
+        std::fstream m_file; //!< \brief file stream
+#else
+        int m_fd; //!< \brief file descriptor
+#endif
+    };
+}
+
+
+#endif // !STREAMPAGER_H_
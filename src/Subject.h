@@ -156,6 +156,38 @@ namespace vc_utils
         void registerObserver( observer_t _obs );
 
 
+        /***************************************************************/
+        // appendObserver:
+        //!
+        //! \brief	  	register a child without duplicate check
+        //!
+        //! \param [in]	_obs	Observer
+        //! \param [in]	_outValueId	value ID
+        //!
+        //!	\details
+        //!	The caller guarantees that the pair is not registered yet.
+        //!	Used by bulk graph construction, where the linear search of
+        //!	registerObserver would make elaboration quadratic.
+        /***************************************************************/
+        void appendObserver( obsPtr_t _obs, unsigned int _outValueId )
+        {
+            m_observerVec.push_back( observer_t( _obs, _outValueId ) );
+        }
+
+
+        /***************************************************************/
+        // reserveObservers:
+        //!
+        //! \brief	  	reserve space for additional Observers
+        //!
+        //! \param [in]	_numOfObservers	number of Observers which will be registered
+        /***************************************************************/
+        void reserveObservers( std::size_t _numOfObservers )
+        {
+            m_observerVec.reserve( m_observerVec.size( ) + _numOfObservers );
+        }
+
+
         /***************************************************************/
         // eraseObserver:
         //!
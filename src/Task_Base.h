@@ -7,6 +7,7 @@
 #include "Typedefinitions.h"
 #include "Subject.h"
 #include "ObserverManager.h"
+#include "ExecutionTrace.h"
 
 namespace vc_utils
 {
@@ -6,6 +6,7 @@
 
 #include "Typedefinitions.h"
 #include "Task_Base.h"
+#include "Capability.h"
 #include <utility>
 #include <memory>
 #include <tuple>
@@ -138,14 +139,18 @@ namespace vc_utils
                 {
                     // parent value synchronization
                     sc_core::wait( m_exeProcEvAndList );
+                    VC_TRACE_EVENT( m_ProcessUnit, this->getVertexNumber( ), TRACE_READY );
 
                     m_ProcessUnit->isCoreUsed( &m_coreFreeEv );
                     sc_core::wait( m_coreFreeEv );
+                    VC_TRACE_EVENT( m_ProcessUnit, this->getVertexNumber( ), TRACE_START );
 
                     m_returnOneVal.second = static_cast< O >(
                         m_inputThreeVal.second ? m_inputOneVal.second : m_inputTwoVal.second );
 
 
+                    VC_TRACE_EVENT_AT( m_ProcessUnit, this->getVertexNumber( ), TRACE_FINISH,
+                        this->getVertexLatency( ) );
                     m_ProcessUnit->freeUsedCore( this->getVertexLatency( ) );
 
                     // notify children observers for output value
@@ -255,6 +260,13 @@ namespace vc_utils
         //! \brief short description
         ProcessUnit_Base* const m_ProcessUnit;
     };
+
+    //! \brief TernaryVertex needs branch support
+    template < typename T, typename U, typename O >
+    struct VertexCapability< TernaryVertex< T, U, O > >
+    {
+        static const capability_t value = CONTROL; //!< \brief needed capability class
+    };
 } // end of namespace vc_utils
 
 #endif
@@ -0,0 +1,321 @@
+//! \file TilingDriver.h
+//! \brief Time-multiplexed execution of one kernel graph instance on tiles of an image
+
+#ifndef TILINGDRIVER_H_
+#define TILINGDRIVER_H_
+
+#include "Typedefinitions.h"
+#include "Memory.h"
+#include <vector>
+#include <string>
+#include <algorithm>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    //! \struct TileGeometry
+    //!
+    //! \brief Shape of a tile and the memory value ids the kernel graph uses
+    //!
+    //! \details
+    //! The kernel graph is built once for a tile of tileWidth x tileHeight
+    //! output values. A stencil kernel needs halo additional input values on
+    //! every side of the tile.
+    //! Input values are numbered row by row beginning with inputBaseId at the
+    //! upper left halo value. Output values are numbered row by row beginning
+    //! with outputBaseId.
+    /************************************************************************/
+    struct TileGeometry
+    {
+        unsigned int tileWidth;    //!< \brief output values per tile row
+        unsigned int tileHeight;   //!< \brief output values per tile column
+        unsigned int halo;         //!< \brief border width needed by stencil kernels
+        unsigned int inputBaseId;  //!< \brief memory value id of upper left input value
+        unsigned int outputBaseId; //!< \brief memory value id of upper left output value
+
+        //! \brief number of input values in one row of a tile (including halo)
+        unsigned int getInputWidth( void ) const { return tileWidth + 2 * halo; }
+
+        //! \brief number of input values in one column of a tile (including halo)
+        unsigned int getInputHeight( void ) const { return tileHeight + 2 * halo; }
+
+        //! \brief memory value id of tile input value at local position (x, y)
+        unsigned int getInputId( unsigned int _x, unsigned int _y ) const
+        {
+            return inputBaseId + _y * getInputWidth( ) + _x;
+        }
+
+        //! \brief memory value id of tile output value at local position (x, y)
+        unsigned int getOutputId( unsigned int _x, unsigned int _y ) const
+        {
+            return outputBaseId + _y * tileWidth + _x;
+        }
+    };
+
+
+    /************************************************************************/
+    // TilingDriver
+    //!
+    //! \class TilingDriver
+    //!
+    //! \brief Push all tiles of an image through a small set of kernel graphs
+    //!
+    //! \details
+    //! Every kernel graph instance (lane) is represented by its Memory. The
+    //! driver copies the input values of the next tile into the Memory of a
+    //! free lane, restarts the kernel by notifying all input values and waits
+    //! until the Memory reports that all observed output values are written.
+    //! The valid part of the output tile is stitched into the output image.
+    //! Halo values outside of the image are replicated from the image border.
+    //!
+    //! Memory and elaboration costs only depend on the tile size and the
+    //! number of lanes, not on the image size.
+    //!
+    //! \tparam T data type of input image values
+    //! \tparam O data type of output image values
+    /************************************************************************/
+    template < typename T, typename O = T > class TilingDriver : public sc_core::sc_module
+    {
+    public:
+        SC_HAS_PROCESS( TilingDriver );
+
+        /***************************************************************/
+        // constructor:
+        //!
+        //! \brief    constructor
+        //!
+        //! \param [in] _name sc_module name
+        //! \param [in] _lanes Memory objects of all kernel graph instances
+        //! \param [in] _geometry tile geometry used by all kernel graph instances
+        //! \param [in] _input input image (row major)
+        //! \param [in] _width number of values in an image row (larger than zero)
+        //! \param [in] _height number of values in an image column (larger than zero)
+        //! \param [out] _output output image (row major), resized by the driver
+        //!
+        //! \details
+        //! Automatic start and text dump of the lane memories are disabled,
+        //! because the driver notifies the input values tile by tile.
+        /***************************************************************/
+        explicit TilingDriver( name_t _name, const std::vector< Memory* >& _lanes,
+            const TileGeometry& _geometry, const std::vector< T >& _input, unsigned int _width,
+            unsigned int _height, std::vector< O >& _output )
+            : sc_core::sc_module( _name ),
+              m_lanes( _lanes ),
+              m_geometry( _geometry ),
+              m_input( _input ),
+              m_output( _output ),
+              m_width( _width ),
+              m_height( _height ),
+              m_tilesPerRow( ( _width + _geometry.tileWidth - 1 ) / _geometry.tileWidth ),
+              m_tilesPerColumn( ( _height + _geometry.tileHeight - 1 ) / _geometry.tileHeight ),
+              m_finishedEv( ( std::string( _name ) + "_finishedEv" ).c_str( ) )
+        {
+            sc_assert( ( _geometry.tileWidth > 0 ) && ( _geometry.tileHeight > 0 ) );
+
+            // without tiles the finished event would never be notified
+            if ( ( 0 == m_width ) || ( 0 == m_height ) )
+                SC_REPORT_ERROR( this->name( ), "image without values, width or height is zero" );
+
+            if ( m_input.size( ) < static_cast< std::size_t >( m_width ) * m_height )
+                SC_REPORT_ERROR( this->name( ), "input image smaller than width x height" );
+
+            m_output.resize( static_cast< std::size_t >( m_width ) * m_height );
+
+            for ( auto lane : m_lanes )
+                {
+                    lane->setAutoStart( false );
+                    lane->setDumpOutputs( false );
+                }
+
+            // one process per kernel graph instance
+            for ( unsigned int i = 0; i < m_lanes.size( ); ++i )
+                sc_core::sc_spawn( sc_bind( &TilingDriver::laneProcess, this, i ),
+                    ( std::string( _name ) + "_laneProcess" + std::to_string( i ) ).c_str( ) );
+        }
+
+        //! \brief destructor
+        virtual ~TilingDriver( ) = default;
+
+    private:
+        // forbidden constructors
+        TilingDriver( ) = delete;                                     //!< \brief forbidden
+        TilingDriver( const TilingDriver& _source ) = delete;         //!< \brief forbidden
+        TilingDriver( TilingDriver&& _source ) = delete;              //!< \brief forbidden
+        TilingDriver& operator=( const TilingDriver& _rhs ) = delete; //!< \brief forbidden
+        TilingDriver& operator=( TilingDriver&& _rhs ) = delete;      //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // prepareMemory
+        //!
+        //! \brief    add all tile values to the Memory of a kernel graph instance
+        //!
+        //! \param [in,out] _memory Memory of the kernel graph instance
+        //! \param [in] _geometry tile geometry
+        //! \param [in] _inType memory data type of input values
+        //! \param [in] _outType memory data type of output values
+        //!
+        //! \details
+        //! Input values are added as not observed values, output values as
+        //! observed values. Use Memory::operator[] with the output value id to
+        //! get the Observer id for the connection of the kernel results.
+        /***************************************************************/
+        static void prepareMemory(
+            Memory& _memory, const TileGeometry& _geometry, TYPE _inType, TYPE _outType )
+        {
+            for ( unsigned int y = 0; y < _geometry.getInputHeight( ); ++y )
+                for ( unsigned int x = 0; x < _geometry.getInputWidth( ); ++x )
+                    {
+                        auto id = _geometry.getInputId( x, y );
+                        _memory.addMemoryValue< T >(
+                            T( ), "tileIn_" + std::to_string( id ), id, _inType );
+                    }
+
+            for ( unsigned int y = 0; y < _geometry.tileHeight; ++y )
+                for ( unsigned int x = 0; x < _geometry.tileWidth; ++x )
+                    {
+                        auto id = _geometry.getOutputId( x, y );
+                        _memory.addMemoryValue< O >(
+                            O( ), "tileOut_" + std::to_string( id ), id, _outType, true );
+                    }
+        }
+
+    public:
+        /***************************************************************/
+        // laneProcess
+        //!
+        //! \brief    process tiles on one kernel graph instance
+        //!
+        //! \param [in] _lane index of the kernel graph instance
+        //!
+        //! \details
+        //! Tiles are handed out in row major order to the first lane that is
+        //! free. The finished event is notified after the last tile is stored.
+        /***************************************************************/
+        void laneProcess( unsigned int _lane )
+        {
+            auto memory = m_lanes[ _lane ];
+
+            while ( m_nextTile < getNumberOfTiles( ) )
+                {
+                    auto tile = m_nextTile++;
+                    auto tileX = ( tile % m_tilesPerRow ) * m_geometry.tileWidth;
+                    auto tileY = ( tile / m_tilesPerRow ) * m_geometry.tileHeight;
+
+                    loadTile( *memory, tileX, tileY );
+                    memory->notifyAllInputValues( );
+
+                    sc_core::wait( memory->getOutputsWrittenEvent( ) );
+
+                    storeTile( *memory, tileX, tileY );
+
+                    if ( ++m_finishedTiles == getNumberOfTiles( ) )
+                        m_finishedEv.notify( sc_core::SC_ZERO_TIME );
+                }
+        }
+
+    public:
+        /************************************************************************/
+        // getter
+        /************************************************************************/
+        //! \brief number of tiles needed to cover the image
+        unsigned int getNumberOfTiles( void ) const { return m_tilesPerRow * m_tilesPerColumn; }
+
+        //! \brief number of already stitched tiles
+        unsigned int getNumberOfFinishedTiles( void ) const { return m_finishedTiles; }
+
+        //! \brief event notified after the last tile is stitched into the output image
+        const event_t& getFinishedEvent( void ) const { return m_finishedEv; }
+
+        //! \brief return kind of SystemC module as string
+        virtual const char* kind( ) const override { return "TilingDriver"; }
+
+    private:
+        //! \brief copy input values of tile at image position (x, y) into memory
+        void loadTile( Memory& _memory, unsigned int _tileX, unsigned int _tileY )
+        {
+            const int halo = static_cast< int >( m_geometry.halo );
+
+            for ( unsigned int y = 0; y < m_geometry.getInputHeight( ); ++y )
+                {
+                    // replicate border values for halo outside of the image
+                    auto imgY = clamp( static_cast< int >( _tileY + y ) - halo, m_height );
+
+                    for ( unsigned int x = 0; x < m_geometry.getInputWidth( ); ++x )
+                        {
+                            auto imgX = clamp( static_cast< int >( _tileX + x ) - halo, m_width );
+
+                            _memory.changeMemoryValue(
+                                m_input[ imgY * m_width + imgX ], m_geometry.getInputId( x, y ) );
+                        }
+                }
+        }
+
+        //! \brief stitch valid output values of tile at image position (x, y)
+        void storeTile( const Memory& _memory, unsigned int _tileX, unsigned int _tileY )
+        {
+            auto validWidth = std::min( m_geometry.tileWidth, m_width - _tileX );
+            auto validHeight = std::min( m_geometry.tileHeight, m_height - _tileY );
+
+            for ( unsigned int y = 0; y < validHeight; ++y )
+                for ( unsigned int x = 0; x < validWidth; ++x )
+                    {
+                        m_output[ ( _tileY + y ) * m_width + _tileX + x ] =
+                            _memory.getOutputValue< O >( m_geometry.getOutputId( x, y ) );
+                    }
+        }
+
+        //! \brief limit coordinate to [0, _size)
+        static unsigned int clamp( int _val, unsigned int _size )
+        {
+            if ( 0 > _val )
+                return 0;
+            else if ( static_cast< unsigned int >( _val ) >= _size )
+                return _size - 1;
+            else
+                return static_cast< unsigned int >( _val );
+        }
+
+    private:
+        /************************************************************************/
+        // Member
+        /************************************************************************/
+        //! \var m_lanes
+        //! \brief Memory objects of all kernel graph instances
+        std::vector< Memory* > m_lanes;
+        //! \var m_geometry
+        //! \brief tile geometry used by all kernel graph instances
+        TileGeometry m_geometry;
+        //! \var m_input
+        //! \brief input image
+        const std::vector< T >& m_input;
+        //! \var m_output
+        //! \brief output image
+        std::vector< O >& m_output;
+        //! \var m_width
+        //! \brief number of values in an image row
+        unsigned int m_width;
+        //! \var m_height
+        //! \brief number of values in an image column
+        unsigned int m_height;
+        //! \var m_tilesPerRow
+        //! \brief number of tiles in x direction
+        unsigned int m_tilesPerRow;
+        //! \var m_tilesPerColumn
+        //! \brief number of tiles in y direction
+        unsigned int m_tilesPerColumn;
+        //! \var m_nextTile
+        //! \brief next tile which is not processed yet
+        unsigned int m_nextTile = {0};
+        //! \var m_finishedTiles
+        //! \brief number of stitched tiles
+        unsigned int m_finishedTiles = {0};
+        //! \var m_finishedEv
+        //! \brief notified after the last tile is stitched
+        event_t m_finishedEv;
+    };
+}
+
+
+#endif // !TILINGDRIVER_H_
@@ -0,0 +1,218 @@
+//! \file VertexTable.h
+//! \brief Owning table of task graph vertices indexed by vertex id
+
+#ifndef VERTEXTABLE_H_
+#define VERTEXTABLE_H_
+
+#include "Subject.h"
+#include <vector>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace vc_utils
+{
+
+    /************************************************************************/
+    // VertexTable
+    //!
+    //! \class VertexTable
+    //!
+    //! \brief Owning table of task graph vertices indexed by vertex id
+    //!
+    //! \details
+    //! The table stores the added vertex ids in one sorted array and the
+    //! vertices in a parallel array, so the memory depends only on the
+    //! number of vertices of the table, not on the id range of the graph.
+    //! Lookup is a binary search. Vertices are usually added in ascending id
+    //! order, which appends in constant time; other ids are inserted.
+    //! The table owns the vertices and deletes them on destruction or clear.
+    //!
+    //! Iteration visits the added vertices in ascending id order and yields
+    //! pairs of vertex id and vertex pointer like a std::map.
+    /************************************************************************/
+    class VertexTable
+    {
+        /************************************************************************/
+        /* type definitions                                                     */
+        /************************************************************************/
+        //! \typedef slots_t
+        //! \brief data field of owned vertices (index = index in m_ids)
+        typedef std::vector< std::unique_ptr< Subject > > slots_t;
+
+    public:
+        //! \typedef entry_t
+        //! \brief vertex id and vertex pointer
+        typedef std::pair< unsigned int, Subject* > entry_t;
+
+        /************************************************************************/
+        // const_iterator
+        //! \brief forward iterator over added vertices in ascending id order
+        /************************************************************************/
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category; //!< \brief iterator category
+            typedef entry_t value_type;                          //!< \brief dereferenced type
+            typedef std::ptrdiff_t difference_type;              //!< \brief distance type
+            typedef const entry_t* pointer;                      //!< \brief pointer type
+            typedef entry_t reference;                           //!< \brief returned by operator*
+
+            //! \brief constructor
+            const_iterator( const VertexTable* _table, std::size_t _slot )
+                : m_table( _table ), m_slot( _slot )
+            {
+            }
+
+            //! \brief return vertex id and vertex pointer
+            entry_t operator*( ) const
+            {
+                return entry_t( m_table->m_ids[ m_slot ], m_table->m_slots[ m_slot ].get( ) );
+            }
+
+            //! \brief go to next added vertex
+            const_iterator& operator++( )
+            {
+                ++m_slot;
+                return *this;
+            }
+
+            //! \brief compare iterators
+            bool operator==( const const_iterator& _rhs ) const { return m_slot == _rhs.m_slot; }
+
+            //! \brief compare iterators
+            bool operator!=( const const_iterator& _rhs ) const { return m_slot != _rhs.m_slot; }
+
+        private:
+            const VertexTable* m_table; //!< \brief iterated table
+            std::size_t m_slot;         //!< \brief current slot
+        };
+
+    public:
+        /************************************************************************/
+        /* constructor                                                          */
+        /************************************************************************/
+        //! \brief constructor
+        VertexTable( ) = default;
+
+        //! \brief destructor deletes all vertices
+        ~VertexTable( ) = default;
+
+    private:
+        // forbidden constructors
+        VertexTable( const VertexTable& _source ) = delete;         //!< \brief forbidden
+        VertexTable& operator=( const VertexTable& _rhs ) = delete; //!< \brief forbidden
+        VertexTable( VertexTable&& _source ) = delete;              //!< \brief forbidden
+        VertexTable& operator=( VertexTable&& _rhs ) = delete;      //!< \brief forbidden
+
+    public:
+        /***************************************************************/
+        // reserve
+        //!
+        //! \brief    reserve slots for a number of vertices
+        //!
+        //! \param [in] _numOfVertices number of vertices which will be added
+        /***************************************************************/
+        void reserve( std::size_t _numOfVertices )
+        {
+            m_ids.reserve( _numOfVertices );
+            m_slots.reserve( _numOfVertices );
+        }
+
+        /***************************************************************/
+        // emplace
+        //!
+        //! \brief    add vertex and take ownership
+        //!
+        //! \param [in] _id vertex id
+        //! \param [in] _vertex new vertex
+        //! \return   bool: true = added, false = id already used
+        //!
+        //! \details
+        //! If the id is already used, the new vertex is deleted and the
+        //! stored vertex is kept.
+        /***************************************************************/
+        bool emplace( unsigned int _id, Subject* _vertex )
+        {
+            std::unique_ptr< Subject > vertex( _vertex );
+
+            // ascending ids are appended
+            if ( m_ids.empty( ) || ( m_ids.back( ) < _id ) )
+                {
+                    m_ids.push_back( _id );
+                    m_slots.push_back( std::move( vertex ) );
+                    return true;
+                }
+
+            auto it = std::lower_bound( m_ids.begin( ), m_ids.end( ), _id );
+
+            if ( *it == _id )
+                return false;
+
+            auto slot = it - m_ids.begin( );
+            m_ids.insert( it, _id );
+            m_slots.insert( m_slots.begin( ) + slot, std::move( vertex ) );
+            return true;
+        }
+
+        //! \brief return 1 if vertex with _id is added, else 0
+        std::size_t count( unsigned int _id ) const { return ( *this )[ _id ] ? 1 : 0; }
+
+        //! \brief return vertex with _id or nullptr if not added
+        Subject* operator[]( unsigned int _id ) const
+        {
+            auto it = std::lower_bound( m_ids.begin( ), m_ids.end( ), _id );
+
+            if ( ( it == m_ids.end( ) ) || ( *it != _id ) )
+                return nullptr;
+
+            return m_slots[ it - m_ids.begin( ) ].get( );
+        }
+
+        //! \brief return vertex with _id, throws std::out_of_range if not added
+        Subject* at( unsigned int _id ) const
+        {
+            auto vertex = ( *this )[ _id ];
+
+            if ( vertex == nullptr )
+                throw std::out_of_range( "vertex id not found in vertex table" );
+
+            return vertex;
+        }
+
+        //! \brief delete all vertices
+        void clear( void )
+        {
+            m_slots.clear( );
+            m_ids.clear( );
+        }
+
+        //! \brief number of added vertices
+        std::size_t size( void ) const { return m_ids.size( ); }
+
+        //! \brief true if no vertex is added
+        bool empty( void ) const { return m_ids.empty( ); }
+
+        /************************************************************************/
+        /* implement functionality for range based loops                        */
+        /************************************************************************/
+        //! \brief iterator to vertex with smallest id
+        const_iterator begin( ) const { return const_iterator( this, 0 ); }
+
+        //! \brief iterator behind vertex with largest id
+        const_iterator end( ) const { return const_iterator( this, m_ids.size( ) ); }
+
+    private:
+        /************************************************************************/
+        /* member                                                               */
+        /************************************************************************/
+        std::vector< unsigned int > m_ids; //!< \brief added vertex ids in ascending order
+        slots_t m_slots;                   //!< \brief owned vertices (index = index in m_ids)
+    };
+}
+
+
+#endif // !VERTEXTABLE_H_